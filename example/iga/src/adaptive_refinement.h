@@ -0,0 +1,97 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_ADAPTIVE_REFINEMENT_H_
+#define SRC_IGA_ADAPTIVE_REFINEMENT_H_
+
+#include <math.h>
+#include <armadillo>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "hierarchical_poisson_problem.h"
+#include "integration_rule.h"
+#include "residual_error_estimator.h"
+
+namespace iga {
+// Adaptive loop solve - estimate - mark - refine for iga::HierarchicalPoissonProblem<DIM>. The elements are marked by
+// the Doerfler (bulk) criterion with the given marking parameter.
+template<int DIM>
+class AdaptiveRefinement {
+ public:
+  AdaptiveRefinement(std::shared_ptr<iga::HierarchicalPoissonProblem<DIM>> problem,
+                     const iga::itg::IntegrationRule &rule, double marking_parameter = 0.5, int number_of_threads = 0)
+      : problem_(std::move(problem)), rule_(rule), marking_parameter_(marking_parameter),
+        number_of_threads_(number_of_threads) {
+    if (marking_parameter_ <= 0 || marking_parameter_ > 1) {
+      throw std::runtime_error("The marking parameter has to be in (0, 1].");
+    }
+  }
+
+  // Refines until the estimate is at most the tolerance or the maximum number of refinements is reached and returns
+  // the solution on the final space.
+  arma::dvec Solve(double tolerance, int max_refinements = 20) {
+    estimates_.clear();
+    numbers_of_degrees_of_freedom_.clear();
+    for (int i = 0;; ++i) {
+      arma::dvec solution = problem_->GetSteadyStateSolution();
+      iga::ResidualErrorEstimator<DIM> estimator(*problem_->GetSpace(), rule_, 1.0, number_of_threads_);
+      std::vector<double> indicators = estimator.GetSquaredIndicators(solution);
+      estimates_.emplace_back(sqrt(std::accumulate(indicators.begin(), indicators.end(), 0.0)));
+      numbers_of_degrees_of_freedom_.emplace_back(problem_->GetSpace()->GetNumberOfBasisFunctions());
+      if (estimates_.back() <= tolerance || i == max_refinements) return solution;
+      problem_->Refine(GetMarkedElements(indicators, marking_parameter_));
+    }
+  }
+
+  // Returns the estimate of each solve of the last call of Solve.
+  const std::vector<double> &GetEstimates() const {
+    return estimates_;
+  }
+
+  const std::vector<int> &GetNumbersOfDegreesOfFreedom() const {
+    return numbers_of_degrees_of_freedom_;
+  }
+
+  static std::vector<int> GetMarkedElements(const std::vector<double> &squared_indicators, double marking_parameter) {
+    std::vector<int> elements(squared_indicators.size());
+    std::iota(elements.begin(), elements.end(), 0);
+    std::stable_sort(elements.begin(), elements.end(), [&squared_indicators](int lhs, int rhs) {
+      return squared_indicators[lhs] > squared_indicators[rhs];
+    });
+    double bulk = marking_parameter * std::accumulate(squared_indicators.begin(), squared_indicators.end(), 0.0);
+    double sum = 0;
+    uint64_t num_marked = 0;
+    while (num_marked < elements.size() && (num_marked == 0 || sum < bulk)) {
+      sum += squared_indicators[elements[num_marked++]];
+    }
+    elements.resize(num_marked);
+    return elements;
+  }
+
+ private:
+  std::shared_ptr<iga::HierarchicalPoissonProblem<DIM>> problem_;
+  iga::itg::IntegrationRule rule_;
+  double marking_parameter_;
+  int number_of_threads_;
+  std::vector<double> estimates_;
+  std::vector<int> numbers_of_degrees_of_freedom_;
+};
+}  // namespace iga
+
+#endif  // SRC_IGA_ADAPTIVE_REFINEMENT_H_
@@ -122,6 +122,27 @@ class BasisFunctionHandler {
     return element_integration_points;
   }
 
+  // Returns the values (derivative = 0) or the first derivatives (derivative = 1) of the non-zero B-spline basis
+  // functions of an element in one parametric direction. Row i belongs to the integration point i of the rule.
+  arma::dmat EvaluateElementBSplineBasisFunctions(int element_number, int direction,
+                                                  const iga::itg::IntegrationRule &rule, int derivative = 0) const {
+    iga::elm::Element element = element_generator_->GetElementList(direction)[
+        element_generator_->GetElementIndices(element_number)[direction]];
+    std::vector<iga::itg::IntegrationPoint> itg_pnts = rule.GetIntegrationPoints();
+    arma::dmat values(itg_pnts.size(), static_cast<uint64_t>(spline_->GetDegree(direction).get() + 1));
+    for (uint64_t i = 0; i < itg_pnts.size(); ++i) {
+      ParamCoord param_coord{((element.GetUpperBound() - element.GetLowerBound()).get() * itg_pnts[i].GetCoordinate() +
+          (element.GetUpperBound() + element.GetLowerBound()).get()) / 2.0};
+      std::vector<double> basis_functions = derivative == 0 ?
+          spline_->EvaluateAllNonZeroBasisFunctions(direction, param_coord) :
+          spline_->EvaluateAllNonZeroBasisFunctionDerivatives(direction, param_coord, derivative);
+      for (uint64_t j = 0; j < basis_functions.size(); ++j) {
+        values(i, j) = basis_functions[j];
+      }
+    }
+    return values;
+  }
+
  private:
   std::vector<double> EvaluateAllNonZeroNURBSBasisFunctions(std::array<ParamCoord, DIM> param_coord) const {
     std::array<std::vector<double>, DIM> basis_functions{};
@@ -186,12 +207,12 @@ class BasisFunctionHandler {
       if (mih.Get1DIndex() == mih.Get1DLength() - 1) break;
       ++mih;
     }
-    for (uint64_t i = 0; i < basis_functions.size(); ++i) {
-      nurbs_basis_functions[i] = nurbs_basis_functions[i] / sum_baf;
+    for (uint64_t i = 0; i < nurbs_basis_functions.size(); ++i) {
       for (int j = 0; j < DIM; ++j) {
         nurbs_basis_function_derivatives[j][i] = (nurbs_basis_function_derivatives[j][i] * sum_baf -
             nurbs_basis_functions[i] * sum_baf_ders[j]) / pow(sum_baf, 2);
       }
+      nurbs_basis_functions[i] = nurbs_basis_functions[i] / sum_baf;
     }
     return nurbs_basis_function_derivatives;
   }
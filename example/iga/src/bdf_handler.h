@@ -15,58 +15,68 @@ You should have received a copy of the GNU Lesser General Public License along w
 #ifndef SRC_IGA_BDF_HANDLER_H_
 #define SRC_IGA_BDF_HANDLER_H_
 
+#include <armadillo>
+#include <stdexcept>
 #include <vector>
 
+#include "element_integral_calculator.h"
 #include "linear_equation_assembler.h"
 
 namespace iga {
 template<int DIM>
 class BDFHandler {
  public:
-  BDFHandler(std::shared_ptr<spl::NURBS<DIM>> spl, const iga::itg::IntegrationRule &rule) : spline_(std::move(spl)) {
-    elm_gen_ = std::make_shared<iga::elm::ElementGenerator<DIM>>(spline_);
-    baf_handler_ = std::make_shared<iga::BasisFunctionHandler<DIM>>(spline_);
-    connectivity_handler_ = std::make_shared<iga::ConnectivityHandler<DIM>>(spline_);
-    time_discr_mat_ = std::make_shared<arma::dmat>(GetTimeDiscretizationMatrix(rule));
+  // The mass matrix is assembled with the assembler and the element integral calculator of the caller, e.g. those of
+  // iga::PoissonProblem<DIM>, so that no further ones are created for the spline.
+  BDFHandler(const std::shared_ptr<spl::NURBS<DIM>> &spl, const iga::itg::IntegrationRule &rule,
+             const iga::LinearEquationAssembler<DIM> &linear_equation_assembler,
+             const iga::ElementIntegralCalculator<DIM> &elm_itg_calc) {
+    auto num_cp = static_cast<uint64_t>(spl->GetNumberOfControlPoints());
+    time_discr_mat_ = std::make_shared<arma::sp_mat>(num_cp, num_cp);
+    linear_equation_assembler.GetMassMatrix(rule, time_discr_mat_, elm_itg_calc);
   }
 
   std::shared_ptr<arma::dmat> GetBDF1LeftSide(const std::shared_ptr<arma::dmat> &matA, double dt) {
-    auto left = std::make_shared<arma::dmat>((*matA) + (*time_discr_mat_ / dt));
+    auto left = std::make_shared<arma::dmat>((*matA) + arma::dmat(*time_discr_mat_ / dt));
+    return left;
+  }
+
+  std::shared_ptr<arma::sp_mat> GetBDF1LeftSide(const std::shared_ptr<arma::sp_mat> &matA, double dt) {
+    auto left = std::make_shared<arma::sp_mat>((*matA) + (*time_discr_mat_ / dt));
     return left;
   }
 
   std::shared_ptr<arma::dvec> GetBDF1RightSide(const std::shared_ptr<arma::dvec> &vecB,
                                                const std::shared_ptr<arma::dvec> &prevSol, double dt) {
-    auto right = std::make_shared<arma::dvec>((*vecB) + (*time_discr_mat_ / dt) * (*prevSol));
+    auto right = std::make_shared<arma::dvec>((*vecB) + ((*time_discr_mat_) * (*prevSol)) / dt);
     return right;
   }
 
- private:
-  arma::dmat GetTimeDiscretizationMatrix(const iga::itg::IntegrationRule &rule) const {
-    auto num_cp = static_cast<uint64_t>(spline_->GetNumberOfControlPoints());
-    arma::dmat A(num_cp, num_cp, arma::fill::zeros);
-    for (int e = 0; e < elm_gen_->GetNumberOfElements(); ++e) {
-      std::vector<iga::elm::ElementIntegrationPoint<DIM>> elm_intgr_pnts =
-          baf_handler_->EvaluateAllElementNonZeroNURBSBasisFunctions(e, rule);
-      for (auto &p : elm_intgr_pnts) {
-        for (int j = 0; j < p.GetNumberOfNonZeroBasisFunctions(); ++j) {
-          for (int k = 0; k < p.GetNumberOfNonZeroBasisFunctions(); ++k) {
-            double temp = p.GetBasisFunctionValue(j) * p.GetBasisFunctionValue(k) * p.GetWeight()
-                * p.GetJacobianDeterminant();
-            A(static_cast<uint64_t>(connectivity_handler_->GetGlobalIndex(e, j) - 1),
-                    static_cast<uint64_t>(connectivity_handler_->GetGlobalIndex(e, k) - 1)) += temp;
-          }
-        }
-      }
+  std::shared_ptr<arma::sp_mat> GetBDFLeftSide(const std::shared_ptr<arma::sp_mat> &matA, double dt, int order) {
+    auto left = std::make_shared<arma::sp_mat>((*matA) + (*time_discr_mat_ * (GetBDFCoefficients(order)[0] / dt)));
+    return left;
+  }
+
+  // Coefficients a_j of the BDF scheme sum_j a_j * u^(n+1-j) / dt = f(u^(n+1)).
+  static std::vector<double> GetBDFCoefficients(int order) {
+    switch (order) {
+      case 1:
+        return {1.0, -1.0};
+      case 2:
+        return {3.0 / 2.0, -2.0, 1.0 / 2.0};
+      case 3:
+        return {11.0 / 6.0, -3.0, 3.0 / 2.0, -1.0 / 3.0};
+      default:
+        throw std::runtime_error("Only BDF schemes of order one to three are implemented!");
     }
-    return A;
   }
 
-  std::shared_ptr<spl::NURBS<DIM>> spline_;
-  std::shared_ptr<iga::elm::ElementGenerator<DIM>> elm_gen_;
-  std::shared_ptr<iga::ConnectivityHandler<DIM>> connectivity_handler_;
-  std::shared_ptr<iga::BasisFunctionHandler<DIM>> baf_handler_;
-  std::shared_ptr<arma::dmat> time_discr_mat_;
+  std::shared_ptr<arma::sp_mat> GetTimeDiscretizationMatrix() const {
+    return time_discr_mat_;
+  }
+
+ private:
+  std::shared_ptr<arma::sp_mat> time_discr_mat_;
 };
 }  // namespace iga
 
@@ -0,0 +1,118 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_SLV_BICGSTAB_SOLVER_H_
+#define SRC_IGA_SLV_BICGSTAB_SOLVER_H_
+
+#include <armadillo>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "jacobi_preconditioner.h"
+#include "linear_solver.h"
+#include "preconditioner.h"
+
+namespace iga {
+namespace slv {
+// Right preconditioned stabilized biconjugate gradient method (van der Vorst, 1992) for sparse systems that are not
+// symmetric, e.g. from collocation. The iteration stops if the residual norm drops below tolerance times the norm of
+// the right side or after max_iterations iterations. It is restarted with a new shadow residual if it breaks down and
+// stops without convergence if it breaks down again right after a restart.
+class BiCGStabSolver : public LinearSolver {
+ public:
+  using LinearSolver::Solve;
+
+  explicit BiCGStabSolver(std::shared_ptr<Preconditioner> preconditioner = nullptr, double tolerance = 1e-10,
+                          int max_iterations = 10000)
+      : preconditioner_(std::move(preconditioner)), tolerance_(tolerance), max_iterations_(max_iterations) {
+    if (preconditioner_ == nullptr) preconditioner_ = std::make_shared<JacobiPreconditioner>();
+  }
+
+  void SetLeftSide(const std::shared_ptr<arma::sp_mat> &matA) override {
+    matA_ = matA;
+    preconditioner_->SetUp(*matA_);
+  }
+
+  arma::dvec Solve(const arma::dvec &vecB, const arma::dvec &initial_guess) override {
+    if (matA_ == nullptr) throw std::runtime_error("The left side has to be set before solving.");
+    num_iterations_ = 0;
+    relative_residual_ = 0;
+    double norm_b = arma::norm(vecB);
+    if (norm_b == 0) return arma::dvec(vecB.n_elem, arma::fill::zeros);
+    arma::dvec x = initial_guess;
+    arma::dvec r = vecB - (*matA_) * x;
+    relative_residual_ = arma::norm(r) / norm_b;
+    while (relative_residual_ > tolerance_ && num_iterations_ < max_iterations_) {
+      arma::dvec shadow = r;
+      arma::dvec p = r;
+      double rho = arma::dot(shadow, r);
+      int iterations_before_restart = num_iterations_;
+      while (relative_residual_ > tolerance_ && num_iterations_ < max_iterations_) {
+        arma::dvec p_hat = preconditioner_->Apply(p);
+        arma::dvec v = (*matA_) * p_hat;
+        double shadow_v = arma::dot(shadow, v);
+        if (shadow_v == 0) {
+          if (num_iterations_ == iterations_before_restart) return x;
+          break;
+        }
+        double alpha = rho / shadow_v;
+        arma::dvec s = r - alpha * v;
+        ++num_iterations_;
+        if (arma::norm(s) / norm_b <= tolerance_) {
+          x += alpha * p_hat;
+          r = s;
+          relative_residual_ = arma::norm(r) / norm_b;
+          break;
+        }
+        arma::dvec s_hat = preconditioner_->Apply(s);
+        arma::dvec t = (*matA_) * s_hat;
+        double t_t = arma::dot(t, t);
+        double omega = t_t == 0 ? 0 : arma::dot(t, s) / t_t;
+        x += alpha * p_hat + omega * s_hat;
+        r = s - omega * t;
+        relative_residual_ = arma::norm(r) / norm_b;
+        double rho_new = arma::dot(shadow, r);
+        if (omega == 0 || rho_new == 0) break;
+        p = r + (rho_new / rho) * (alpha / omega) * (p - omega * v);
+        rho = rho_new;
+      }
+    }
+    return x;
+  }
+
+  bool HasConverged() const override {
+    return relative_residual_ <= tolerance_;
+  }
+
+  int GetNumberOfIterations() const {
+    return num_iterations_;
+  }
+
+  double GetRelativeResidual() const {
+    return relative_residual_;
+  }
+
+ private:
+  std::shared_ptr<Preconditioner> preconditioner_;
+  std::shared_ptr<arma::sp_mat> matA_;
+  double tolerance_;
+  int max_iterations_;
+  int num_iterations_ = 0;
+  double relative_residual_ = 0;
+};
+}  // namespace slv
+}  // namespace iga
+
+#endif  // SRC_IGA_SLV_BICGSTAB_SOLVER_H_
@@ -0,0 +1,99 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_SLV_CHEBYSHEV_SMOOTHER_H_
+#define SRC_IGA_SLV_CHEBYSHEV_SMOOTHER_H_
+
+#include <armadillo>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "linear_operator.h"
+
+namespace iga {
+namespace slv {
+// Chebyshev accelerated Jacobi smoother for symmetric positive definite operators. It only needs the action and the
+// diagonal of the operator.
+class ChebyshevSmoother {
+ public:
+  explicit ChebyshevSmoother(int degree = 3, double smoothing_range = 20.0, int power_iterations = 20)
+      : degree_(degree), smoothing_range_(smoothing_range), power_iterations_(power_iterations) {
+    if (degree_ < 1) throw std::runtime_error("The degree of the Chebyshev smoother has to be positive.");
+  }
+
+  void SetUp(std::shared_ptr<const LinearOperator> left_side) {
+    left_side_ = std::move(left_side);
+    inverse_diagonal_ = left_side_->GetDiagonal();
+    for (auto &entry : inverse_diagonal_) {
+      if (entry <= 0) throw std::runtime_error("The Chebyshev smoother requires a positive diagonal.");
+      entry = 1.0 / entry;
+    }
+    largest_eigenvalue_ = 1.1 * EstimateLargestEigenvalue();
+  }
+
+  arma::dvec Smooth(const arma::dvec &vecB, const arma::dvec &initial_guess) const {
+    if (left_side_ == nullptr) throw std::runtime_error("The smoother has to be set up before smoothing.");
+    double upper = largest_eigenvalue_;
+    double lower = largest_eigenvalue_ / smoothing_range_;
+    double theta = (upper + lower) / 2;
+    double delta = (upper - lower) / 2;
+    double sigma = theta / delta;
+    double rho = 1.0 / sigma;
+    arma::dvec x = initial_guess;
+    arma::dvec update = inverse_diagonal_ % (vecB - left_side_->Apply(x)) / theta;
+    x += update;
+    for (int k = 1; k < degree_; ++k) {
+      double rho_new = 1.0 / (2 * sigma - rho);
+      update = (rho_new * rho) * update + (2 * rho_new / delta) * (inverse_diagonal_ % (vecB - left_side_->Apply(x)));
+      x += update;
+      rho = rho_new;
+    }
+    return x;
+  }
+
+  double GetLargestEigenvalue() const {
+    return largest_eigenvalue_;
+  }
+
+ private:
+  // Power iteration for the largest eigenvalue of D^-1 * A from a fixed start vector.
+  double EstimateLargestEigenvalue() const {
+    arma::dvec v(inverse_diagonal_.n_elem);
+    for (uint64_t i = 0; i < v.n_elem; ++i) {
+      v(i) = 1.0 + static_cast<double>(i % 7) / 7.0;
+    }
+    double eigenvalue = 0;
+    for (int k = 0; k < power_iterations_; ++k) {
+      arma::dvec w = left_side_->Apply(v);
+      eigenvalue = arma::dot(v, w) / arma::dot(v, v / inverse_diagonal_);
+      v = inverse_diagonal_ % w;
+      double norm = arma::norm(v);
+      if (norm == 0) break;
+      v /= norm;
+    }
+    return eigenvalue;
+  }
+
+  int degree_;
+  double smoothing_range_;
+  int power_iterations_;
+  std::shared_ptr<const LinearOperator> left_side_;
+  arma::dvec inverse_diagonal_;
+  double largest_eigenvalue_ = 0;
+};
+}  // namespace slv
+}  // namespace iga
+
+#endif  // SRC_IGA_SLV_CHEBYSHEV_SMOOTHER_H_
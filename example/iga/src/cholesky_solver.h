@@ -0,0 +1,165 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_SLV_CHOLESKY_SOLVER_H_
+#define SRC_IGA_SLV_CHOLESKY_SOLVER_H_
+
+#include <armadillo>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "linear_solver.h"
+
+namespace iga {
+namespace slv {
+// Direct solver for symmetric positive definite sparse systems. The unknowns are renumbered in reverse Cuthill-McKee
+// order, so that the size of the factor does not depend on the numbering of the control points, e.g. the hashed
+// numbering of multiple patches. The Cholesky factor L of the renumbered system is stored row by row from the first
+// non-zero entry of each row to the diagonal (skyline storage), which contains all of its fill-in. Each call of Solve
+// only consists of a forward and a backward substitution.
+class CholeskySolver : public LinearSolver {
+ public:
+  using LinearSolver::Solve;
+
+  void SetLeftSide(const std::shared_ptr<arma::sp_mat> &matA) override {
+    auto n = static_cast<uint64_t>((*matA).n_rows);
+    position_ = GetReverseCuthillMcKeePositions(*matA);
+    first_column_.assign(n, 0);
+    for (uint64_t i = 0; i < n; ++i) {
+      first_column_[i] = i;
+    }
+    for (arma::sp_mat::const_iterator it = (*matA).begin(); it != (*matA).end(); ++it) {
+      uint64_t row = position_[it.row()], col = position_[it.col()];
+      if (col < first_column_[row]) first_column_[row] = col;
+    }
+    row_offset_.assign(n + 1, 0);
+    for (uint64_t i = 0; i < n; ++i) {
+      row_offset_[i + 1] = row_offset_[i] + i - first_column_[i] + 1;
+    }
+    factor_.assign(row_offset_[n], 0.0);
+    for (arma::sp_mat::const_iterator it = (*matA).begin(); it != (*matA).end(); ++it) {
+      uint64_t row = position_[it.row()], col = position_[it.col()];
+      if (col <= row) factor_[Position(row, col)] = *it;
+    }
+    Factorize();
+  }
+
+  uint64_t GetNumberOfFactorEntries() const {
+    return factor_.size();
+  }
+
+  arma::dvec Solve(const arma::dvec &vecB, const arma::dvec &/*initial_guess*/) override {
+    if (vecB.n_elem != first_column_.size()) throw std::runtime_error("The left side has to be set before solving.");
+    arma::dvec x(vecB.n_elem);
+    for (uint64_t i = 0; i < first_column_.size(); ++i) {
+      x(position_[i]) = vecB(i);
+    }
+    for (uint64_t i = 0; i < first_column_.size(); ++i) {
+      for (uint64_t j = first_column_[i]; j < i; ++j) {
+        x(i) -= factor_[Position(i, j)] * x(j);
+      }
+      x(i) /= factor_[Position(i, i)];
+    }
+    for (uint64_t i = first_column_.size(); i-- > 0;) {
+      x(i) /= factor_[Position(i, i)];
+      for (uint64_t j = first_column_[i]; j < i; ++j) {
+        x(j) -= factor_[Position(i, j)] * x(i);
+      }
+    }
+    arma::dvec solution(x.n_elem);
+    for (uint64_t i = 0; i < first_column_.size(); ++i) {
+      solution(i) = x(position_[i]);
+    }
+    return solution;
+  }
+
+ private:
+  void Factorize() {
+    for (uint64_t i = 0; i < first_column_.size(); ++i) {
+      for (uint64_t j = first_column_[i]; j <= i; ++j) {
+        double sum = factor_[Position(i, j)];
+        for (uint64_t k = std::max(first_column_[i], first_column_[j]); k < j; ++k) {
+          sum -= factor_[Position(i, k)] * factor_[Position(j, k)];
+        }
+        if (j < i) {
+          factor_[Position(i, j)] = sum / factor_[Position(j, j)];
+        } else if (sum > 0) {
+          factor_[Position(i, i)] = sqrt(sum);
+        } else {
+          throw std::runtime_error("The Cholesky factorization requires a symmetric positive definite matrix.");
+        }
+      }
+    }
+  }
+
+  // Returns the new position of each unknown. Each connected component of the graph of the matrix is numbered breadth
+  // first from a node of minimum degree, the neighbors of each node by increasing degree, and the numbering is
+  // reversed.
+  static std::vector<uint64_t> GetReverseCuthillMcKeePositions(const arma::sp_mat &matA) {
+    auto n = static_cast<uint64_t>(matA.n_cols);
+    std::vector<std::vector<uint64_t>> neighbors(n);
+    for (arma::sp_mat::const_iterator it = matA.begin(); it != matA.end(); ++it) {
+      if (it.row() != it.col()) neighbors[it.col()].push_back(it.row());
+    }
+    std::vector<uint64_t> degree(n, 0);
+    for (uint64_t node = 0; node < n; ++node) {
+      degree[node] = neighbors[node].size();
+    }
+    auto by_degree = [&degree](uint64_t lhs, uint64_t rhs) { return degree[lhs] < degree[rhs]; };
+    std::vector<uint64_t> start_nodes(n);
+    std::iota(start_nodes.begin(), start_nodes.end(), 0);
+    std::stable_sort(start_nodes.begin(), start_nodes.end(), by_degree);
+    std::vector<uint64_t> order;
+    order.reserve(n);
+    std::vector<bool> numbered(n, false);
+    for (uint64_t start : start_nodes) {
+      if (numbered[start]) continue;
+      numbered[start] = true;
+      order.push_back(start);
+      for (uint64_t next = order.size() - 1; next < order.size(); ++next) {
+        uint64_t node = order[next];
+        auto first_neighbor = static_cast<int64_t>(order.size());
+        for (uint64_t neighbor : neighbors[node]) {
+          if (!numbered[neighbor]) {
+            numbered[neighbor] = true;
+            order.push_back(neighbor);
+          }
+        }
+        std::stable_sort(order.begin() + first_neighbor, order.end(), by_degree);
+      }
+    }
+    std::vector<uint64_t> position(n);
+    for (uint64_t i = 0; i < n; ++i) {
+      position[order[i]] = n - 1 - i;
+    }
+    return position;
+  }
+
+  uint64_t Position(uint64_t row, uint64_t col) const {
+    return row_offset_[row] + col - first_column_[row];
+  }
+
+  std::vector<uint64_t> position_;
+  std::vector<uint64_t> first_column_;
+  std::vector<uint64_t> row_offset_;
+  std::vector<double> factor_;
+};
+}  // namespace slv
+}  // namespace iga
+
+#endif  // SRC_IGA_SLV_CHOLESKY_SOLVER_H_
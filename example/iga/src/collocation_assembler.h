@@ -0,0 +1,261 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_COLLOCATION_ASSEMBLER_H_
+#define SRC_IGA_COLLOCATION_ASSEMBLER_H_
+
+#include <armadillo>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "linear_equation_assembler.h"
+#include "multi_index_handler.h"
+#include "nurbs.h"
+
+namespace iga {
+// Isogeometric collocation of the Poisson problem -k * laplace(u) = f at the Greville abscissae. It needs C^1
+// continuous basis functions and gives a system that is not symmetric.
+template<int DIM>
+class CollocationAssembler {
+ public:
+  explicit CollocationAssembler(std::shared_ptr<spl::NURBS<DIM>> spl)
+      : spline_(std::move(spl)), linear_equation_assembler_(spline_) {
+    ThrowIfNotC1Continuous(*spline_);
+  }
+
+  // Throws if the degree is less than two or a knot has a multiplicity of at least the degree in some direction.
+  static void ThrowIfNotC1Continuous(const spl::NURBS<DIM> &spline) {
+    for (int d = 0; d < DIM; ++d) {
+      int degree = spline.GetDegree(d).get();
+      if (degree < 2) {
+        throw std::runtime_error("Collocation requires the degree to be at least two in each parametric direction.");
+      }
+      std::shared_ptr<baf::KnotVector> knot_vector = spline.GetKnotVector(d);
+      for (size_t i = static_cast<size_t>(degree) + 1; i + degree + 1 < knot_vector->GetNumberOfKnots(); ++i) {
+        if (static_cast<int>(knot_vector->GetMultiplicity(knot_vector->GetKnot(i))) >= degree) {
+          throw std::runtime_error("Collocation requires basis functions that are at least C^1 continuous.");
+        }
+      }
+    }
+  }
+
+  // Returns the Greville abscissae (t_{i+1} + ... + t_{i+p}) / p in each parametric direction.
+  std::array<std::vector<double>, DIM> GetGrevilleAbscissae() const {
+    std::array<std::vector<double>, DIM> greville;
+    std::array<int, DIM> points_per_direction = spline_->GetPointsPerDirection();
+    for (int d = 0; d < DIM; ++d) {
+      int degree = spline_->GetDegree(d).get();
+      for (int i = 0; i < points_per_direction[d]; ++i) {
+        double sum = 0;
+        for (int k = 1; k <= degree; ++k) {
+          sum += spline_->GetKnotVector(d)->GetKnot(static_cast<size_t>(i + k)).get();
+        }
+        greville[d].emplace_back(sum / degree);
+      }
+    }
+    return greville;
+  }
+
+  void GetLeftSide(const std::shared_ptr<arma::sp_mat> &matA, double thermal_conductivity = 1.0) const {
+    std::vector<arma::uword> rows, cols;
+    std::vector<double> values;
+    std::array<std::vector<double>, DIM> greville = GetGrevilleAbscissae();
+    util::MultiIndexHandler<DIM> point_handler(spline_->GetPointsPerDirection());
+    for (int i = 0; i < point_handler.Get1DLength(); ++i, ++point_handler) {
+      if (linear_equation_assembler_.IsOnBoundary(i)) continue;
+      auto row = static_cast<arma::uword>(i);
+      CollocationPoint point = EvaluateCollocationPoint(GetParamCoords(greville, point_handler.GetIndices()));
+      for (uint64_t j = 0; j < point.global_indices.size(); ++j) {
+        rows.emplace_back(row);
+        cols.emplace_back(point.global_indices[j]);
+        values.emplace_back(-thermal_conductivity * point.laplacians[j]);
+      }
+    }
+    for (int index : linear_equation_assembler_.GetBoundaryIndices()) {
+      rows.emplace_back(static_cast<arma::uword>(index));
+      cols.emplace_back(static_cast<arma::uword>(index));
+      values.emplace_back(1.0);
+    }
+    arma::umat locations(2, rows.size());
+    for (uint64_t k = 0; k < rows.size(); ++k) {
+      locations(0, k) = rows[k];
+      locations(1, k) = cols[k];
+    }
+    auto size = static_cast<arma::uword>(spline_->GetNumberOfControlPoints());
+    *matA += arma::sp_mat(true, locations, arma::dvec(values), size, size);
+  }
+
+  // The Dirichlet values are given in the order of LinearEquationAssembler<DIM>::GetBoundaryIndices.
+  void GetRightSide(const std::shared_ptr<arma::dvec> &vecB, const std::shared_ptr<arma::dvec> &srcCp,
+                    const std::shared_ptr<arma::dvec> &Dirichlet = nullptr) const {
+    std::array<std::vector<double>, DIM> greville = GetGrevilleAbscissae();
+    util::MultiIndexHandler<DIM> point_handler(spline_->GetPointsPerDirection());
+    for (int i = 0; i < point_handler.Get1DLength(); ++i, ++point_handler) {
+      if (linear_equation_assembler_.IsOnBoundary(i)) continue;
+      CollocationPoint point = EvaluateCollocationPoint(GetParamCoords(greville, point_handler.GetIndices()));
+      double source = 0;
+      for (uint64_t j = 0; j < point.global_indices.size(); ++j) {
+        source += point.values[j] * (*srcCp)(point.global_indices[j]);
+      }
+      (*vecB)(static_cast<uint64_t>(i)) = source;
+    }
+    const std::vector<int> &boundary_indices = linear_equation_assembler_.GetBoundaryIndices();
+    for (uint64_t i = 0; i < boundary_indices.size(); ++i) {
+      (*vecB)(static_cast<uint64_t>(boundary_indices[i])) = Dirichlet == nullptr ? 0.0 : (*Dirichlet)(i);
+    }
+  }
+
+  struct CollocationPoint {
+    std::vector<arma::uword> global_indices;
+    std::vector<double> values;
+    std::vector<double> laplacians;
+    double jacobian_determinant;
+  };
+
+  // Evaluates the rational basis functions that are non-zero at the point, their laplacians in physical coordinates and
+  // the Jacobian determinant. Any point works, e.g. the integration points of iga::ResidualErrorEstimator<DIM>.
+  CollocationPoint EvaluateCollocationPoint(const std::array<ParamCoord, DIM> &param_coords) const {
+    std::array<std::array<std::vector<double>, 3>, DIM> univariate;
+    std::array<int, DIM> first_non_zero{};
+    std::array<int, DIM> num_baf{};
+    for (int d = 0; d < DIM; ++d) {
+      univariate[d][0] = spline_->EvaluateAllNonZeroBasisFunctions(d, param_coords[d]);
+      univariate[d][1] = spline_->EvaluateAllNonZeroBasisFunctionDerivatives(d, param_coords[d], 1);
+      univariate[d][2] = spline_->EvaluateAllNonZeroBasisFunctionDerivatives(d, param_coords[d], 2);
+      first_non_zero[d] = spline_->GetKnotVector(d)->GetKnotSpan(param_coords[d]).get() - spline_->GetDegree(d).get();
+      num_baf[d] = static_cast<int>(univariate[d][0].size());
+    }
+    std::array<int, DIM> points_per_direction = spline_->GetPointsPerDirection();
+    util::MultiIndexHandler<DIM> baf_handler(num_baf);
+    auto num_local = static_cast<uint64_t>(baf_handler.Get1DLength());
+    std::vector<arma::uword> global_indices;
+    std::vector<double> weights;
+    arma::dmat control_points(DIM, num_local);
+    for (uint64_t j = 0; j < num_local; ++j, ++baf_handler) {
+      std::array<int, DIM> indices{};
+      int global_index = 0;
+      for (int d = DIM - 1; d >= 0; --d) {
+        indices[d] = first_non_zero[d] + baf_handler[d];
+        global_index = global_index * points_per_direction[d] + indices[d];
+      }
+      global_indices.emplace_back(static_cast<arma::uword>(global_index));
+      weights.emplace_back(spline_->GetWeight(indices));
+      for (int k = 0; k < DIM; ++k) {
+        control_points(k, j) = spline_->GetControlPoint(indices, k);
+      }
+    }
+    return EvaluatePoint(univariate, global_indices, weights, control_points);
+  }
+
+  // Evaluates the point from the univariate B-splines and their first and second derivatives that are non-zero at it.
+  static CollocationPoint EvaluatePoint(const std::array<std::array<std::vector<double>, 3>, DIM> &univariate,
+                                        const std::vector<arma::uword> &global_indices,
+                                        const std::vector<double> &weights, const arma::dmat &control_points) {
+    std::array<int, DIM> num_baf{};
+    for (int d = 0; d < DIM; ++d) {
+      num_baf[d] = static_cast<int>(univariate[d][0].size());
+    }
+    util::MultiIndexHandler<DIM> baf_handler(num_baf);
+    auto num_local = static_cast<uint64_t>(baf_handler.Get1DLength());
+    CollocationPoint point;
+    point.global_indices = global_indices;
+    arma::dvec weighted(num_local);
+    std::vector<arma::dvec> weighted_gradients(num_local, arma::dvec(DIM));
+    std::vector<arma::dmat> weighted_hessians(num_local, arma::dmat(DIM, DIM));
+    for (uint64_t j = 0; j < num_local; ++j, ++baf_handler) {
+      double weight = weights[j];
+      // Products of univariate factors where the directions a and b are differentiated once each.
+      weighted(j) = weight;
+      for (int a = 0; a < DIM; ++a) {
+        weighted_gradients[j](a) = weight;
+        for (int b = 0; b < DIM; ++b) {
+          weighted_hessians[j](a, b) = weight;
+        }
+      }
+      for (int d = 0; d < DIM; ++d) {
+        int l = baf_handler[d];
+        weighted(j) *= univariate[d][0][l];
+        for (int a = 0; a < DIM; ++a) {
+          weighted_gradients[j](a) *= univariate[d][a == d ? 1 : 0][l];
+          for (int b = 0; b < DIM; ++b) {
+            weighted_hessians[j](a, b) *= univariate[d][(a == d ? 1 : 0) + (b == d ? 1 : 0)][l];
+          }
+        }
+      }
+    }
+    double weight_sum = 0;
+    arma::dvec weight_sum_gradient(DIM, arma::fill::zeros);
+    arma::dmat weight_sum_hessian(DIM, DIM, arma::fill::zeros);
+    for (uint64_t j = 0; j < num_local; ++j) {
+      weight_sum += weighted(j);
+      weight_sum_gradient += weighted_gradients[j];
+      weight_sum_hessian += weighted_hessians[j];
+    }
+    std::vector<arma::dvec> gradients(num_local);
+    std::vector<arma::dmat> hessians(num_local);
+    arma::dmat jacobian(DIM, DIM, arma::fill::zeros);
+    for (uint64_t j = 0; j < num_local; ++j) {
+      point.values.emplace_back(weighted(j) / weight_sum);
+      gradients[j] = (weighted_gradients[j] - point.values[j] * weight_sum_gradient) / weight_sum;
+      hessians[j] = (weighted_hessians[j] - gradients[j] * weight_sum_gradient.t() -
+          weight_sum_gradient * gradients[j].t() - point.values[j] * weight_sum_hessian) / weight_sum;
+      for (int k = 0; k < DIM; ++k) {
+        for (int a = 0; a < DIM; ++a) {
+          jacobian(k, a) += control_points(k, j) * gradients[j](a);
+        }
+      }
+    }
+    std::vector<arma::dmat> geometry_hessians(DIM, arma::dmat(DIM, DIM, arma::fill::zeros));
+    for (int k = 0; k < DIM; ++k) {
+      for (uint64_t j = 0; j < num_local; ++j) {
+        geometry_hessians[k] += control_points(k, j) * hessians[j];
+      }
+    }
+    point.jacobian_determinant = arma::det(jacobian);
+    arma::dmat inverse_jacobian = jacobian.i();
+    for (uint64_t j = 0; j < num_local; ++j) {
+      arma::dvec physical_gradient = inverse_jacobian.t() * gradients[j];
+      arma::dmat hessian = hessians[j];
+      for (int k = 0; k < DIM; ++k) {
+        hessian -= physical_gradient(k) * geometry_hessians[k];
+      }
+      arma::dmat physical_hessian = inverse_jacobian.t() * hessian * inverse_jacobian;
+      double laplacian = 0;
+      for (int k = 0; k < DIM; ++k) {
+        laplacian += physical_hessian(k, k);
+      }
+      point.laplacians.emplace_back(laplacian);
+    }
+    return point;
+  }
+
+ private:
+  static std::array<ParamCoord, DIM> GetParamCoords(const std::array<std::vector<double>, DIM> &greville,
+                                                    const std::array<int, DIM> &indices) {
+    std::array<ParamCoord, DIM> param_coords{};
+    for (int d = 0; d < DIM; ++d) {
+      param_coords[d] = ParamCoord{greville[d][indices[d]]};
+    }
+    return param_coords;
+  }
+
+  std::shared_ptr<spl::NURBS<DIM>> spline_;
+  LinearEquationAssembler<DIM> linear_equation_assembler_;
+};
+}  // namespace iga
+
+#endif  // SRC_IGA_COLLOCATION_ASSEMBLER_H_
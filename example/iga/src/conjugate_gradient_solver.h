@@ -0,0 +1,118 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_SLV_CONJUGATE_GRADIENT_SOLVER_H_
+#define SRC_IGA_SLV_CONJUGATE_GRADIENT_SOLVER_H_
+
+#include <armadillo>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "jacobi_preconditioner.h"
+#include "linear_operator.h"
+#include "linear_solver.h"
+#include "preconditioner.h"
+
+namespace iga {
+namespace slv {
+// Preconditioned conjugate gradient method for symmetric positive definite sparse systems or operators. The iteration
+// stops if the residual norm drops below tolerance times the norm of the right side or after max_iterations
+// iterations.
+class ConjugateGradientSolver : public LinearSolver {
+ public:
+  using LinearSolver::Solve;
+
+  explicit ConjugateGradientSolver(std::shared_ptr<Preconditioner> preconditioner = nullptr,
+                                   double tolerance = 1e-10, int max_iterations = 10000)
+      : preconditioner_(std::move(preconditioner)), tolerance_(tolerance), max_iterations_(max_iterations) {
+    if (preconditioner_ == nullptr) preconditioner_ = std::make_shared<JacobiPreconditioner>();
+  }
+
+  void SetLeftSide(const std::shared_ptr<arma::sp_mat> &matA) override {
+    matA_ = matA;
+    preconditioner_->SetUp(*matA_);
+  }
+
+  arma::dvec Solve(const arma::dvec &vecB, const arma::dvec &initial_guess) override {
+    if (matA_ == nullptr) throw std::runtime_error("The left side has to be set before solving.");
+    return Iterate([this](const arma::dvec &p) -> arma::dvec { return (*matA_) * p; },
+                   [this](const arma::dvec &r) { return preconditioner_->Apply(r); }, vecB, initial_guess);
+  }
+
+  // Solves a system whose left side is only available as an operator. It is preconditioned with the inverse of the
+  // diagonal of the operator.
+  arma::dvec Solve(const LinearOperator &left_side, const arma::dvec &vecB, const arma::dvec &initial_guess) {
+    arma::dvec inverse_diagonal = left_side.GetDiagonal();
+    for (auto &entry : inverse_diagonal) {
+      if (entry == 0) throw std::runtime_error("The Jacobi preconditioner requires a non-zero diagonal.");
+      entry = 1.0 / entry;
+    }
+    return Iterate([&left_side](const arma::dvec &p) { return left_side.Apply(p); },
+                   [&inverse_diagonal](const arma::dvec &r) -> arma::dvec { return inverse_diagonal % r; }, vecB,
+                   initial_guess);
+  }
+
+  bool HasConverged() const override {
+    return relative_residual_ <= tolerance_;
+  }
+
+  int GetNumberOfIterations() const {
+    return num_iterations_;
+  }
+
+  double GetRelativeResidual() const {
+    return relative_residual_;
+  }
+
+ private:
+  template<typename MULTIPLY, typename PRECONDITION>
+  arma::dvec Iterate(const MULTIPLY &multiply, const PRECONDITION &precondition, const arma::dvec &vecB,
+                     const arma::dvec &initial_guess) {
+    num_iterations_ = 0;
+    relative_residual_ = 0;
+    double norm_b = arma::norm(vecB);
+    if (norm_b == 0) return arma::dvec(vecB.n_elem, arma::fill::zeros);
+    arma::dvec x = initial_guess;
+    arma::dvec r = vecB - multiply(x);
+    relative_residual_ = arma::norm(r) / norm_b;
+    arma::dvec z = precondition(r);
+    arma::dvec p = z;
+    double rz = arma::dot(r, z);
+    while (relative_residual_ > tolerance_ && num_iterations_ < max_iterations_) {
+      arma::dvec q = multiply(p);
+      double alpha = rz / arma::dot(p, q);
+      x += alpha * p;
+      r -= alpha * q;
+      ++num_iterations_;
+      relative_residual_ = arma::norm(r) / norm_b;
+      z = precondition(r);
+      double rz_new = arma::dot(r, z);
+      p = z + (rz_new / rz) * p;
+      rz = rz_new;
+    }
+    return x;
+  }
+
+  std::shared_ptr<Preconditioner> preconditioner_;
+  std::shared_ptr<arma::sp_mat> matA_;
+  double tolerance_;
+  int max_iterations_;
+  int num_iterations_ = 0;
+  double relative_residual_ = 0;
+};
+}  // namespace slv
+}  // namespace iga
+
+#endif  // SRC_IGA_SLV_CONJUGATE_GRADIENT_SOLVER_H_
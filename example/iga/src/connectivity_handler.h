@@ -35,8 +35,7 @@ class ConnectivityHandler {
 
  private:
   std::array<int, DIM> GetGlobalIndicesPerParametricDirection(int elm_num, int local_index) {
-    util::MultiIndexHandler<DIM> mult_ind_handl_elm(elm_gen_->GetNumElementsPerParamDir());
-    mult_ind_handl_elm = mult_ind_handl_elm + elm_num;
+    std::array<int, DIM> element_indices = elm_gen_->GetElementIndices(elm_num);
     std::array<int, DIM> num_non_zero_baf{};
     for (int i = 0; i < DIM; ++i) {
       num_non_zero_baf[i] = spline_->GetDegree(i).get() + 1;
@@ -46,7 +45,7 @@ class ConnectivityHandler {
     std::array<int, DIM> knot_mult_index_shift = elm_gen_->GetKnotMultiplicityIndexShift(elm_num);
     std::array<int, DIM> global_indices{};
     for (int i = 0; i < DIM; ++i) {
-      global_indices[i] = mult_ind_handl_baf[i] + mult_ind_handl_elm[i] + knot_mult_index_shift[i];
+      global_indices[i] = mult_ind_handl_baf[i] + element_indices[i] + knot_mult_index_shift[i];
     }
     return global_indices;
   }
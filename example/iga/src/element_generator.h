@@ -37,10 +37,21 @@ class ElementGenerator {
     }
   }
 
-  std::vector<iga::elm::Element> GetElementList(int dir) const {
+  const std::vector<iga::elm::Element> &GetElementList(int dir) const {
     return elements_[dir];
   }
 
+  // Returns the index of the first non-zero basis function of each element in the given direction, which is the knot
+  // span of the lower bound of the element minus the degree.
+  std::vector<int> GetFirstNonZeroBasisFunctions(int dir) const {
+    std::vector<int> first_non_zero;
+    for (const auto &element : elements_[dir]) {
+      first_non_zero.emplace_back(spl_->GetKnotVector(dir)->GetKnotSpan(element.GetLowerBound()).get() -
+                                  spl_->GetDegree(dir).get());
+    }
+    return first_non_zero;
+  }
+
   std::array<int, DIM> GetNumElementsPerParamDir() const {
     std::array<int, DIM> num_elms{};
     for (int i = 0; i < DIM; ++i) {
@@ -80,10 +91,16 @@ class ElementGenerator {
     return Get1DElementIndex(element_indices);
   }
 
+  // The first parametric direction runs fastest, as in util::MultiIndexHandler<DIM>. The indices are computed by
+  // division, since advancing a multi-index handler by element_index steps costs O(element_index).
   std::array<int, DIM> GetElementIndices(int element_index) const {
-    util::MultiIndexHandler<DIM> mult_ind_handl_elm(GetNumElementsPerParamDir());
-    mult_ind_handl_elm = mult_ind_handl_elm + element_index;
-    return mult_ind_handl_elm.GetIndices();
+    std::array<int, DIM> element_indices{};
+    for (int i = 0; i < DIM; ++i) {
+      auto num_elements = static_cast<int>(elements_[i].size());
+      element_indices[i] = element_index % num_elements;
+      element_index /= num_elements;
+    }
+    return element_indices;
   }
 
   int Get1DElementIndex(std::array<int, DIM> element_indices) const {
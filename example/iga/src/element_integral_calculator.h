@@ -16,14 +16,18 @@ You should have received a copy of the GNU Lesser General Public License along w
 #define SRC_IGA_ELEMENT_INTEGRAL_CALCULATOR_H_
 
 #include <armadillo>
+#include <array>
+#include <cmath>
 #include <vector>
 
 #include "basis_function_handler.h"
-#include "connectivity_handler.h"
+#include "element_generator.h"
 #include "element_integration_point.h"
 #include "integration_point.h"
 #include "mapping_handler.h"
+#include "multi_index_handler.h"
 #include "nurbs.h"
+#include "sum_factorization.h"
 
 namespace iga {
 template<int DIM>
@@ -31,13 +35,29 @@ class ElementIntegralCalculator {
  public:
   explicit ElementIntegralCalculator(std::shared_ptr<spl::NURBS<DIM>> spl) : spline_(std::move(spl)) {
     baf_handler_ = std::make_shared<iga::BasisFunctionHandler<DIM>>(spline_);
-    connectivity_handler_ = std::make_shared<iga::ConnectivityHandler<DIM>>(spline_);
+    elm_gen_ = std::make_shared<iga::elm::ElementGenerator<DIM>>(spline_);
+    for (int d = 0; d < DIM; ++d) {
+      first_non_zero_[d] = elm_gen_->GetFirstNonZeroBasisFunctions(d);
+    }
   }
 
   void GetLaplaceElementIntegral(int element_number, const iga::itg::IntegrationRule &rule,
       const std::shared_ptr<arma::dmat> &matA, double thermal_conductivity = 1.0) const {
+    arma::dmat element_matrix = GetLaplaceElementMatrix(element_number, rule, thermal_conductivity);
+    std::vector<arma::uword> global_indices = GetGlobalIndices(element_number);
+    for (uint64_t j = 0; j < global_indices.size(); ++j) {
+      for (uint64_t k = 0; k < global_indices.size(); ++k) {
+        (*matA)(global_indices[j], global_indices[k]) += element_matrix(j, k);
+      }
+    }
+  }
+
+  arma::dmat GetLaplaceElementMatrix(int element_number, const iga::itg::IntegrationRule &rule,
+      double thermal_conductivity = 1.0) const {
     std::vector<iga::elm::ElementIntegrationPoint<DIM>> elm_intgr_pnts =
         baf_handler_->EvaluateAllElementNonZeroNURBSBafDerivativesPhysical(element_number, rule);
+    auto num_baf = static_cast<uint64_t>(elm_intgr_pnts[0].GetNumberOfNonZeroBasisFunctionDerivatives(0));
+    arma::dmat element_matrix(num_baf, num_baf, arma::fill::zeros);
     for (auto &p : elm_intgr_pnts) {
       for (int j = 0; j < p.GetNumberOfNonZeroBasisFunctionDerivatives(0); ++j) {
         for (int k = 0; k < p.GetNumberOfNonZeroBasisFunctionDerivatives(0); ++k) {
@@ -46,34 +66,363 @@ class ElementIntegralCalculator {
             temp += p.GetBasisFunctionDerivativeValue(j, i) * p.GetBasisFunctionDerivativeValue(k, i);
           }
           temp *= p.GetWeight() * p.GetJacobianDeterminant() * thermal_conductivity;
-          (*matA)(static_cast<uint64_t>(connectivity_handler_->GetGlobalIndex(element_number, j) - 1),
-                  static_cast<uint64_t>(connectivity_handler_->GetGlobalIndex(element_number, k) - 1)) += temp;
+          element_matrix(static_cast<uint64_t>(j), static_cast<uint64_t>(k)) += temp;
+        }
+      }
+    }
+    return element_matrix;
+  }
+
+  arma::dmat GetMassElementMatrix(int element_number, const iga::itg::IntegrationRule &rule) const {
+    std::vector<iga::elm::ElementIntegrationPoint<DIM>> elm_intgr_pnts =
+        baf_handler_->EvaluateAllElementNonZeroNURBSBasisFunctions(element_number, rule);
+    auto num_baf = static_cast<uint64_t>(elm_intgr_pnts[0].GetNumberOfNonZeroBasisFunctions());
+    arma::dmat element_matrix(num_baf, num_baf, arma::fill::zeros);
+    for (auto &p : elm_intgr_pnts) {
+      for (int j = 0; j < p.GetNumberOfNonZeroBasisFunctions(); ++j) {
+        for (int k = 0; k < p.GetNumberOfNonZeroBasisFunctions(); ++k) {
+          element_matrix(static_cast<uint64_t>(j), static_cast<uint64_t>(k)) += p.GetBasisFunctionValue(j) *
+              p.GetBasisFunctionValue(k) * p.GetWeight() * p.GetJacobianDeterminant();
         }
       }
     }
+    return element_matrix;
+  }
+
+  // The data of an element that the sum factorized kernels need. Other bases such as the levels of
+  // iga::TruncatedHierarchicalSpace<DIM> can provide it as well.
+  struct ElementBasis {
+    int element_number;
+    std::vector<iga::itg::IntegrationRule> rules;
+    std::vector<arma::uword> global_indices;
+    std::vector<double> weights;
+    arma::dmat control_points;
+    std::array<std::array<double, 2>, DIM> bounds;
+    std::array<arma::dmat, DIM> values;
+    std::array<arma::dmat, DIM> derivatives;
+  };
+
+  ElementBasis GetElementBasis(int element_number, const iga::itg::IntegrationRule &rule) const {
+    return GetElementBasis(element_number, GetTensorProductRules(rule));
+  }
+
+  // The rules are univariate rules on [-1, 1], one per parametric direction, e.g. from iga::PatchQuadrature<DIM>.
+  ElementBasis GetElementBasis(int element_number, const std::vector<iga::itg::IntegrationRule> &rules) const {
+    ElementBasis basis{element_number, rules, GetGlobalIndices(element_number), {}, {}, {}, {}, {}};
+    int cp_dim = spline_->GetPointDim();
+    basis.control_points = arma::dmat(static_cast<uint64_t>(cp_dim), basis.global_indices.size());
+    for (uint64_t j = 0; j < basis.global_indices.size(); ++j) {
+      std::array<int, DIM> indices = GetControlPointIndices(basis.global_indices[j]);
+      basis.weights.emplace_back(spline_->GetWeight(indices));
+      for (int i = 0; i < cp_dim; ++i) {
+        basis.control_points(i, j) = spline_->GetControlPoint(indices, i);
+      }
+    }
+    std::array<int, DIM> element_indices = elm_gen_->GetElementIndices(element_number);
+    for (int d = 0; d < DIM; ++d) {
+      const iga::elm::Element &elm = elm_gen_->GetElementList(d)[element_indices[d]];
+      basis.bounds[d] = {elm.GetLowerBound().get(), elm.GetUpperBound().get()};
+    }
+    if (HasIntegrationPoints(rules)) {
+      basis.values = GetUnivariateBasisFunctions(element_number, rules, 0);
+      basis.derivatives = GetUnivariateBasisFunctions(element_number, rules, 1);
+    }
+    return basis;
+  }
+
+  // Computes the element stiffness matrix with sum factorization as (DIM+1)^2 integrals of tensor products of
+  // univariate B-spline factors, each costing O(n_q * (p+1)^(2*DIM)) instead of O(n_q^DIM * (p+1)^(2*DIM)).
+  arma::dmat GetLaplaceElementMatrixSumFactorized(int element_number, const iga::itg::IntegrationRule &rule,
+      double thermal_conductivity = 1.0) const {
+    return GetLaplaceElementMatrixSumFactorized(GetElementBasis(element_number, rule), thermal_conductivity);
+  }
+
+  arma::dmat GetLaplaceElementMatrixSumFactorized(int element_number,
+      const std::vector<iga::itg::IntegrationRule> &rules, double thermal_conductivity = 1.0) const {
+    return GetLaplaceElementMatrixSumFactorized(GetElementBasis(element_number, rules), thermal_conductivity);
+  }
+
+  static arma::dmat GetLaplaceElementMatrixSumFactorized(const ElementBasis &basis, double thermal_conductivity = 1.0) {
+    if (!HasIntegrationPoints(basis.rules)) return GetZeroElementMatrix(basis);
+    std::vector<arma::dvec> coefficients = GetLaplaceCoefficients(basis, thermal_conductivity);
+    arma::dmat element_matrix = GetZeroElementMatrix(basis);
+    for (int c = 0; c <= DIM; ++c) {
+      for (int f = 0; f <= DIM; ++f) {
+        const arma::dvec &coefficient = coefficients[static_cast<uint64_t>(c * (DIM + 1) + f)];
+        if (IsZero(coefficient)) continue;
+        element_matrix += iga::SumFactorization<DIM>::Integrate(GetUnivariateFactors(basis, c),
+                                                                GetUnivariateFactors(basis, f), coefficient);
+      }
+    }
+    return ScaleWithWeights(basis, element_matrix);
+  }
+
+  arma::dmat GetMassElementMatrixSumFactorized(int element_number, const iga::itg::IntegrationRule &rule) const {
+    return GetMassElementMatrixSumFactorized(GetElementBasis(element_number, rule));
+  }
+
+  arma::dmat GetMassElementMatrixSumFactorized(int element_number,
+                                               const std::vector<iga::itg::IntegrationRule> &rules) const {
+    return GetMassElementMatrixSumFactorized(GetElementBasis(element_number, rules));
+  }
+
+  static arma::dmat GetMassElementMatrixSumFactorized(const ElementBasis &basis) {
+    if (!HasIntegrationPoints(basis.rules)) return GetZeroElementMatrix(basis);
+    return ScaleWithWeights(basis,
+        iga::SumFactorization<DIM>::Integrate(basis.values, basis.values, GetMassCoefficients(basis)));
+  }
+
+  // Returns the local load vector of the source given by its values at the control points of the whole spline.
+  static arma::dvec GetSourceElementVectorSumFactorized(const ElementBasis &basis, const arma::dvec &srcCp) {
+    arma::dvec local(basis.global_indices.size());
+    for (uint64_t j = 0; j < local.n_elem; ++j) {
+      local(j) = basis.weights[j] * srcCp(basis.global_indices[j]);
+    }
+    if (!HasIntegrationPoints(basis.rules)) return arma::dvec(local.n_elem, arma::fill::zeros);
+    std::array<const arma::dmat *, DIM> values{};
+    for (int d = 0; d < DIM; ++d) {
+      values[d] = &basis.values[d];
+    }
+    arma::dvec at_points = GetMassCoefficients(basis) % iga::SumFactorization<DIM>::Apply(values, local, false);
+    arma::dvec element_vector = iga::SumFactorization<DIM>::Apply(values, at_points, true);
+    for (uint64_t j = 0; j < element_vector.n_elem; ++j) {
+      element_vector(j) *= basis.weights[j];
+    }
+    return element_vector;
+  }
+
+  // Returns the coefficients of the integrands of the stiffness matrix at the integration points. Entry c * (DIM+1) + f
+  // belongs to the factors c and f, where factor 0 is the B-spline and factor i its derivative in direction i - 1.
+  std::vector<arma::dvec> GetLaplaceCoefficients(int element_number, const iga::itg::IntegrationRule &rule,
+      double thermal_conductivity = 1.0) const {
+    return GetLaplaceCoefficients(GetElementBasis(element_number, rule), thermal_conductivity);
+  }
+
+  static std::vector<arma::dvec> GetLaplaceCoefficients(const ElementBasis &basis, double thermal_conductivity = 1.0) {
+    std::vector<GeometricFactors> factors = GetGeometricFactors(basis);
+    std::vector<arma::dvec> coefficients(static_cast<uint64_t>((DIM + 1) * (DIM + 1)), arma::dvec(factors.size()));
+    for (uint64_t q = 0; q < factors.size(); ++q) {
+      const GeometricFactors &factor = factors[q];
+      // grad_xi R_j = w_j * transformation * (B_j, d_xi1 B_j, ..., d_xiDIM B_j)
+      arma::dmat transformation(DIM, DIM + 1, arma::fill::zeros);
+      for (int a = 0; a < DIM; ++a) {
+        transformation(a, 0) = -factor.weight_sum_derivatives[a] / pow(factor.weight_sum, 2);
+        transformation(a, a + 1) = 1.0 / factor.weight_sum;
+      }
+      arma::dmat coefficient = transformation.t() * factor.dxi_dx * factor.dxi_dx.t() * transformation;
+      for (int c = 0; c <= DIM; ++c) {
+        for (int f = 0; f <= DIM; ++f) {
+          coefficients[static_cast<uint64_t>(c * (DIM + 1) + f)](q) =
+              coefficient(c, f) * factor.measure * thermal_conductivity;
+        }
+      }
+    }
+    return coefficients;
+  }
+
+  arma::dvec GetMassCoefficients(int element_number, const iga::itg::IntegrationRule &rule) const {
+    return GetMassCoefficients(GetElementBasis(element_number, rule));
+  }
+
+  static arma::dvec GetMassCoefficients(const ElementBasis &basis) {
+    std::vector<GeometricFactors> factors = GetGeometricFactors(basis);
+    arma::dvec coefficients(factors.size());
+    for (uint64_t q = 0; q < factors.size(); ++q) {
+      coefficients(q) = factors[q].measure / pow(factors[q].weight_sum, 2);
+    }
+    return coefficients;
+  }
+
+  std::array<arma::dmat, DIM> GetUnivariateBasisFunctions(int element_number, const iga::itg::IntegrationRule &rule,
+      int derivative) const {
+    return GetUnivariateBasisFunctions(element_number, GetTensorProductRules(rule), derivative);
+  }
+
+  std::array<arma::dmat, DIM> GetUnivariateBasisFunctions(int element_number,
+      const std::vector<iga::itg::IntegrationRule> &rules, int derivative) const {
+    std::array<arma::dmat, DIM> basis_functions;
+    for (int d = 0; d < DIM; ++d) {
+      basis_functions[d] = baf_handler_->EvaluateElementBSplineBasisFunctions(element_number, d, rules[d], derivative);
+    }
+    return basis_functions;
+  }
+
+  // Returns the NURBS weights of the non-zero basis functions of the element.
+  std::vector<double> GetWeights(int element_number) const {
+    std::vector<double> weights;
+    for (auto global_index : GetGlobalIndices(element_number)) {
+      weights.emplace_back(spline_->GetWeight(GetControlPointIndices(global_index)));
+    }
+    return weights;
+  }
+
+  // Returns the indices of ConnectivityHandler<DIM>::GetGlobalIndex minus one.
+  std::vector<arma::uword> GetGlobalIndices(int element_number) const {
+    std::array<int, DIM> element_indices = elm_gen_->GetElementIndices(element_number);
+    std::array<int, DIM> points_per_direction = spline_->GetPointsPerDirection();
+    std::array<int, DIM> num_baf{};
+    for (int d = 0; d < DIM; ++d) {
+      num_baf[d] = spline_->GetDegree(d).get() + 1;
+    }
+    util::MultiIndexHandler<DIM> baf_handler(num_baf);
+    std::vector<arma::uword> global_indices;
+    global_indices.reserve(static_cast<uint64_t>(baf_handler.Get1DLength()));
+    for (int j = 0; j < baf_handler.Get1DLength(); ++j, ++baf_handler) {
+      arma::uword global_index = 0;
+      for (int d = DIM - 1; d >= 0; --d) {
+        global_index = global_index * static_cast<arma::uword>(points_per_direction[d]) +
+            static_cast<arma::uword>(first_non_zero_[d][element_indices[d]] + baf_handler[d]);
+      }
+      global_indices.emplace_back(global_index);
+    }
+    return global_indices;
   }
 
   void GetLaplaceElementIntegral(int element_number, const iga::itg::IntegrationRule &rule,
       const std::shared_ptr<arma::dvec> &vecB, const std::shared_ptr<arma::dvec> &srcCp) const {
     std::vector<iga::elm::ElementIntegrationPoint<DIM>> elm_intgr_pnts =
         baf_handler_->EvaluateAllElementNonZeroNURBSBasisFunctions(element_number, rule);
+    std::vector<arma::uword> global_indices = GetGlobalIndices(element_number);
     for (auto &p : elm_intgr_pnts) {
       double bc_int_pnt = 0;
       for (int j = 0; j < p.GetNumberOfNonZeroBasisFunctions(); ++j) {
-        bc_int_pnt += p.GetBasisFunctionValue(j) *
-            (*srcCp)(static_cast<uint64_t>(connectivity_handler_->GetGlobalIndex(element_number, j) - 1));
+        bc_int_pnt += p.GetBasisFunctionValue(j) * (*srcCp)(global_indices[j]);
       }
       for (int j = 0; j < p.GetNumberOfNonZeroBasisFunctions(); ++j) {
         double temp = p.GetBasisFunctionValue(j) * bc_int_pnt * p.GetWeight() * p.GetJacobianDeterminant();
-        (*vecB)(static_cast<uint64_t>(connectivity_handler_->GetGlobalIndex(element_number, j) - 1)) += temp;
+        (*vecB)(global_indices[j]) += temp;
       }
     }
   }
 
  private:
+  struct GeometricFactors {
+    double weight_sum;
+    std::array<double, DIM> weight_sum_derivatives;
+    arma::dmat dxi_dx;  // Pseudo-inverse of the Jacobian if the spline is embedded in a higher dimensional space.
+    double measure;  // Integration weight times Jacobian determinant.
+  };
+
+  // Evaluates the weight function and the geometry mapping at the integration points of the element from the univariate
+  // B-splines and the control points of the basis, with the first parametric direction running fastest.
+  static std::vector<GeometricFactors> GetGeometricFactors(const ElementBasis &basis) {
+    const std::vector<iga::itg::IntegrationRule> &rules = basis.rules;
+    const std::array<arma::dmat, DIM> &values = basis.values;
+    const std::array<arma::dmat, DIM> &derivatives = basis.derivatives;
+    const std::vector<arma::uword> &global_indices = basis.global_indices;
+    const std::vector<double> &weights = basis.weights;
+    const arma::dmat &control_points = basis.control_points;
+    auto cp_dim = static_cast<int>(control_points.n_rows);
+    std::array<std::vector<iga::itg::IntegrationPoint>, DIM> itg_pnts;
+    std::array<int, DIM> num_itg_pnts{};
+    std::array<int, DIM> num_baf{};
+    double element_scaling = 1;
+    for (int d = 0; d < DIM; ++d) {
+      itg_pnts[d] = rules[d].GetIntegrationPoints();
+      num_itg_pnts[d] = rules[d].GetNumberOfIntegrationPoints();
+      num_baf[d] = static_cast<int>(values[d].n_cols);
+      element_scaling *= (basis.bounds[d][1] - basis.bounds[d][0]) / 2.0;
+    }
+    std::vector<GeometricFactors> factors;
+    util::MultiIndexHandler<DIM> itg_pnt_handler(num_itg_pnts);
+    for (int q = 0; q < itg_pnt_handler.Get1DLength(); ++q, ++itg_pnt_handler) {
+      GeometricFactors factor{0, {}, arma::dmat(), 1};
+      arma::dvec point(static_cast<uint64_t>(cp_dim), arma::fill::zeros);
+      arma::dmat point_derivatives(static_cast<uint64_t>(cp_dim), DIM, arma::fill::zeros);
+      util::MultiIndexHandler<DIM> baf_handler(num_baf);
+      for (uint64_t j = 0; j < global_indices.size(); ++j, ++baf_handler) {
+        double value = weights[j];
+        std::array<double, DIM> value_derivatives{};
+        value_derivatives.fill(weights[j]);
+        for (int d = 0; d < DIM; ++d) {
+          for (int a = 0; a < DIM; ++a) {
+            value_derivatives[a] *= (a == d ? derivatives[d] : values[d])(itg_pnt_handler[d], baf_handler[d]);
+          }
+          value *= values[d](itg_pnt_handler[d], baf_handler[d]);
+        }
+        factor.weight_sum += value;
+        for (int i = 0; i < cp_dim; ++i) {
+          point(i) += value * control_points(i, j);
+        }
+        for (int a = 0; a < DIM; ++a) {
+          factor.weight_sum_derivatives[a] += value_derivatives[a];
+          for (int i = 0; i < cp_dim; ++i) {
+            point_derivatives(i, a) += value_derivatives[a] * control_points(i, j);
+          }
+        }
+      }
+      arma::dmat dx_dxi(static_cast<uint64_t>(cp_dim), DIM);
+      for (int i = 0; i < cp_dim; ++i) {
+        for (int a = 0; a < DIM; ++a) {
+          dx_dxi(i, a) = (point_derivatives(i, a) - point(i) * factor.weight_sum_derivatives[a] / factor.weight_sum) /
+              factor.weight_sum;
+        }
+      }
+      factor.dxi_dx = cp_dim == DIM ? arma::dmat(dx_dxi.i()) : arma::dmat((dx_dxi.t() * dx_dxi).i() * dx_dxi.t());
+      factor.measure = pow(std::abs(arma::det(dx_dxi.t() * dx_dxi)), 0.5) * element_scaling;
+      for (int d = 0; d < DIM; ++d) {
+        factor.measure *= itg_pnts[d][itg_pnt_handler[d]].GetWeight();
+      }
+      factors.emplace_back(factor);
+    }
+    return factors;
+  }
+
+  static std::vector<iga::itg::IntegrationRule> GetTensorProductRules(const iga::itg::IntegrationRule &rule) {
+    return std::vector<iga::itg::IntegrationRule>(DIM, rule);
+  }
+
+  static bool HasIntegrationPoints(const std::vector<iga::itg::IntegrationRule> &rules) {
+    for (const auto &rule : rules) {
+      if (rule.GetNumberOfIntegrationPoints() == 0) return false;
+    }
+    return true;
+  }
+
+  static arma::dmat GetZeroElementMatrix(const ElementBasis &basis) {
+    uint64_t num_baf = basis.global_indices.size();
+    return arma::dmat(num_baf, num_baf, arma::fill::zeros);
+  }
+
+  // Returns the univariate factors of the tensor product B-splines for the factor index used by GetLaplaceCoefficients.
+  static std::array<arma::dmat, DIM> GetUnivariateFactors(const ElementBasis &basis, int factor) {
+    std::array<arma::dmat, DIM> univariate_factors = basis.values;
+    if (factor > 0) univariate_factors[factor - 1] = basis.derivatives[factor - 1];
+    return univariate_factors;
+  }
+
+  static arma::dmat ScaleWithWeights(const ElementBasis &basis, arma::dmat element_matrix) {
+    const std::vector<double> &weights = basis.weights;
+    for (uint64_t k = 0; k < weights.size(); ++k) {
+      for (uint64_t j = 0; j < weights.size(); ++j) {
+        element_matrix(j, k) *= weights[j] * weights[k];
+      }
+    }
+    return element_matrix;
+  }
+
+  std::array<int, DIM> GetControlPointIndices(arma::uword global_index) const {
+    std::array<int, DIM> points_per_direction = spline_->GetPointsPerDirection();
+    std::array<int, DIM> indices{};
+    for (int d = 0; d < DIM; ++d) {
+      indices[d] = static_cast<int>(global_index % points_per_direction[d]);
+      global_index /= points_per_direction[d];
+    }
+    return indices;
+  }
+
+  static bool IsZero(const arma::dvec &vector) {
+    for (uint64_t i = 0; i < vector.n_elem; ++i) {
+      if (vector(i) != 0) return false;
+    }
+    return true;
+  }
+
   std::shared_ptr<spl::NURBS<DIM>> spline_;
   std::shared_ptr<iga::BasisFunctionHandler<DIM>> baf_handler_;
-  std::shared_ptr<iga::ConnectivityHandler<DIM>> connectivity_handler_;
+  std::shared_ptr<iga::elm::ElementGenerator<DIM>> elm_gen_;
+  // Index of the first non-zero basis function of each knot span with positive length, per parametric direction.
+  std::array<std::vector<int>, DIM> first_non_zero_;
 };
 }  // namespace iga
 
@@ -0,0 +1,130 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_HIERARCHICAL_POISSON_PROBLEM_H_
+#define SRC_IGA_HIERARCHICAL_POISSON_PROBLEM_H_
+
+#include <armadillo>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "cholesky_solver.h"
+#include "integration_rule.h"
+#include "linear_solver.h"
+#include "nurbs.h"
+#include "truncated_hierarchical_space.h"
+
+namespace iga {
+// Poisson problem with a unit source and homogeneous Dirichlet conditions on a locally refined truncated hierarchical
+// space. The level element matrices are mapped to the active functions with the extraction matrices.
+template<int DIM>
+class HierarchicalPoissonProblem {
+ public:
+  HierarchicalPoissonProblem(std::shared_ptr<spl::NURBS<DIM>> spl, const iga::itg::IntegrationRule &rule,
+                             std::shared_ptr<iga::slv::LinearSolver> solver = nullptr)
+      : space_(std::make_shared<iga::TruncatedHierarchicalSpace<DIM>>(std::move(spl))), rule_(rule),
+        solver_(std::move(solver)) {
+    if (solver_ == nullptr) solver_ = std::make_shared<iga::slv::CholeskySolver>();
+  }
+
+  std::shared_ptr<iga::TruncatedHierarchicalSpace<DIM>> GetSpace() const {
+    return space_;
+  }
+
+  // Refines the given active elements of the space.
+  void Refine(const std::vector<int> &elements) {
+    space_->Refine(elements);
+  }
+
+  void GetSystem(const std::shared_ptr<arma::sp_mat> &matA, const std::shared_ptr<arma::dvec> &vecB) const {
+    auto num_dof = static_cast<uint64_t>(space_->GetNumberOfBasisFunctions());
+    std::vector<arma::uword> rows, cols;
+    std::vector<double> values;
+    *vecB = arma::dvec(num_dof, arma::fill::zeros);
+    for (int e = 0; e < space_->GetNumberOfElements(); ++e) {
+      const arma::dmat &extraction = space_->GetExtractionMatrix(e);
+      const std::vector<arma::uword> &global_indices = space_->GetGlobalIndices(e);
+      auto basis = space_->GetElementBasis(e, rule_);
+      arma::dmat element_matrix = extraction *
+          iga::ElementIntegralCalculator<DIM>::GetLaplaceElementMatrixSumFactorized(basis) * extraction.t();
+      arma::dmat mass_matrix = iga::ElementIntegralCalculator<DIM>::GetMassElementMatrixSumFactorized(basis);
+      arma::dvec element_vector = extraction * (mass_matrix * arma::dvec(mass_matrix.n_cols, arma::fill::ones));
+      for (uint64_t j = 0; j < global_indices.size(); ++j) {
+        for (uint64_t k = 0; k < global_indices.size(); ++k) {
+          rows.emplace_back(global_indices[j]);
+          cols.emplace_back(global_indices[k]);
+          values.emplace_back(element_matrix(j, k));
+        }
+        (*vecB)(global_indices[j]) += element_vector(j);
+      }
+    }
+    arma::umat locations(2, rows.size());
+    for (uint64_t i = 0; i < rows.size(); ++i) {
+      locations(0, i) = rows[i];
+      locations(1, i) = cols[i];
+    }
+    *matA = arma::sp_mat(true, locations, arma::dvec(values), num_dof, num_dof);
+  }
+
+  // Replaces the rows and columns of the active functions on the boundary by the identity and sets the right side
+  // there to zero.
+  void SetZeroBC(const std::shared_ptr<arma::sp_mat> &matA, const std::shared_ptr<arma::dvec> &vecB) const {
+    std::vector<bool> on_boundary(vecB->n_elem, false);
+    for (int index : space_->GetBoundaryIndices()) {
+      on_boundary[index] = true;
+    }
+    std::vector<arma::uword> rows, cols;
+    std::vector<double> values;
+    for (arma::sp_mat::const_iterator it = (*matA).begin(); it != (*matA).end(); ++it) {
+      if (!on_boundary[it.row()] && !on_boundary[it.col()]) {
+        rows.emplace_back(it.row());
+        cols.emplace_back(it.col());
+        values.emplace_back(*it);
+      }
+    }
+    for (int index : space_->GetBoundaryIndices()) {
+      rows.emplace_back(static_cast<arma::uword>(index));
+      cols.emplace_back(static_cast<arma::uword>(index));
+      values.emplace_back(1.0);
+      (*vecB)(static_cast<uint64_t>(index)) = 0;
+    }
+    arma::umat locations(2, rows.size());
+    for (uint64_t i = 0; i < rows.size(); ++i) {
+      locations(0, i) = rows[i];
+      locations(1, i) = cols[i];
+    }
+    *matA = arma::sp_mat(true, locations, arma::dvec(values), (*matA).n_rows, (*matA).n_cols);
+  }
+
+  arma::dvec GetSteadyStateSolution() const {
+    auto num_dof = static_cast<uint64_t>(space_->GetNumberOfBasisFunctions());
+    auto matA = std::make_shared<arma::sp_mat>(num_dof, num_dof);
+    auto vecB = std::make_shared<arma::dvec>(num_dof, arma::fill::zeros);
+    GetSystem(matA, vecB);
+    SetZeroBC(matA, vecB);
+    solver_->SetLeftSide(matA);
+    arma::dvec solution = solver_->Solve(*vecB);
+    solver_->ThrowIfNotConverged();
+    return solution;
+  }
+
+ private:
+  std::shared_ptr<iga::TruncatedHierarchicalSpace<DIM>> space_;
+  iga::itg::IntegrationRule rule_;
+  std::shared_ptr<iga::slv::LinearSolver> solver_;
+};
+}  // namespace iga
+
+#endif  // SRC_IGA_HIERARCHICAL_POISSON_PROBLEM_H_
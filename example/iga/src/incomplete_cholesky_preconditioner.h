@@ -0,0 +1,109 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_SLV_INCOMPLETE_CHOLESKY_PRECONDITIONER_H_
+#define SRC_IGA_SLV_INCOMPLETE_CHOLESKY_PRECONDITIONER_H_
+
+#include <armadillo>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "preconditioner.h"
+
+namespace iga {
+namespace slv {
+// Zero fill-in incomplete Cholesky factorization A ~ L * L^T on the lower triangular pattern of A. If the
+// factorization breaks down, it is repeated for A + shift * diag(A) with an increasing shift.
+class IncompleteCholeskyPreconditioner : public Preconditioner {
+ public:
+  void SetUp(const arma::sp_mat &matA) override {
+    auto n = static_cast<uint64_t>(matA.n_rows);
+    std::vector<std::vector<uint64_t>> pattern(n);
+    std::vector<std::vector<double>> values(n);
+    for (arma::sp_mat::const_iterator it = matA.begin(); it != matA.end(); ++it) {
+      if (it.col() <= it.row()) {
+        pattern[it.row()].emplace_back(it.col());
+        values[it.row()].emplace_back(*it);
+      }
+    }
+    for (uint64_t i = 0; i < n; ++i) {
+      if (pattern[i].empty() || pattern[i].back() != i) {
+        throw std::runtime_error("The incomplete Cholesky preconditioner requires a non-zero diagonal.");
+      }
+    }
+    double shift = 0;
+    while (!Factorize(pattern, values, shift)) {
+      shift = (shift == 0) ? 1e-3 : 2 * shift;
+      if (shift > 1e3) throw std::runtime_error("The incomplete Cholesky factorization failed.");
+    }
+  }
+
+  arma::dvec Apply(const arma::dvec &residual) const override {
+    arma::dvec z = residual;
+    for (uint64_t i = 0; i < row_pattern_.size(); ++i) {
+      for (uint64_t k = 0; k + 1 < row_pattern_[i].size(); ++k) {
+        z(i) -= row_values_[i][k] * z(row_pattern_[i][k]);
+      }
+      z(i) /= row_values_[i].back();
+    }
+    for (uint64_t i = row_pattern_.size(); i-- > 0;) {
+      z(i) /= row_values_[i].back();
+      for (uint64_t k = 0; k + 1 < row_pattern_[i].size(); ++k) {
+        z(row_pattern_[i][k]) -= row_values_[i][k] * z(i);
+      }
+    }
+    return z;
+  }
+
+ private:
+  bool Factorize(const std::vector<std::vector<uint64_t>> &pattern, const std::vector<std::vector<double>> &values,
+                 double shift) {
+    row_pattern_ = pattern;
+    row_values_ = values;
+    for (uint64_t i = 0; i < row_pattern_.size(); ++i) {
+      std::vector<uint64_t> &row_i = row_pattern_[i];
+      std::vector<double> &l_i = row_values_[i];
+      for (uint64_t k = 0; k + 1 < row_i.size(); ++k) {
+        const std::vector<uint64_t> &row_k = row_pattern_[row_i[k]];
+        const std::vector<double> &l_k = row_values_[row_i[k]];
+        double sum = l_i[k];
+        for (uint64_t a = 0, b = 0; a < k && b + 1 < row_k.size();) {
+          if (row_i[a] == row_k[b]) {
+            sum -= l_i[a++] * l_k[b++];
+          } else if (row_i[a] < row_k[b]) {
+            ++a;
+          } else {
+            ++b;
+          }
+        }
+        l_i[k] = sum / l_k.back();
+      }
+      double diagonal = l_i.back() * (1 + shift);
+      for (uint64_t k = 0; k + 1 < row_i.size(); ++k) {
+        diagonal -= l_i[k] * l_i[k];
+      }
+      if (diagonal <= 0) return false;
+      l_i.back() = sqrt(diagonal);
+    }
+    return true;
+  }
+
+  std::vector<std::vector<uint64_t>> row_pattern_;
+  std::vector<std::vector<double>> row_values_;
+};
+}  // namespace slv
+}  // namespace iga
+
+#endif  // SRC_IGA_SLV_INCOMPLETE_CHOLESKY_PRECONDITIONER_H_
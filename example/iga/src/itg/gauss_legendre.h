@@ -0,0 +1,140 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_ITG_GAUSS_LEGENDRE_H_
+#define SRC_IGA_ITG_GAUSS_LEGENDRE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "integration_rule.h"
+
+namespace iga {
+namespace itg {
+// Gauss-Legendre rule with an arbitrary number of points on [-1, 1], computed once per number of points with the
+// Golub-Welsch algorithm.
+class GaussLegendre : public IntegrationRule {
+ public:
+  explicit GaussLegendre(int number_of_points) : IntegrationRule(GetPoints(number_of_points)) {}
+
+ private:
+  static std::vector<IntegrationPoint> GetPoints(int number_of_points) {
+    if (number_of_points < 1) throw std::runtime_error("A Gauss-Legendre rule needs at least one point.");
+    static std::map<int, std::vector<IntegrationPoint>> cache;
+    static std::mutex cache_mutex;
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto cached = cache.find(number_of_points);
+    if (cached == cache.end()) {
+      cached = cache.emplace(number_of_points, ComputePoints(number_of_points)).first;
+    }
+    return cached->second;
+  }
+
+  static std::vector<IntegrationPoint> ComputePoints(int n) {
+    std::vector<double> diagonal(static_cast<uint64_t>(n), 0.0);
+    std::vector<double> off_diagonal(static_cast<uint64_t>(n), 0.0);
+    for (int k = 1; k < n; ++k) {
+      off_diagonal[k - 1] = k / sqrt(4.0 * k * k - 1.0);
+    }
+    std::vector<double> first_components(static_cast<uint64_t>(n), 0.0);
+    first_components[0] = 1.0;
+    DiagonalizeTridiagonalMatrix(&diagonal, &off_diagonal, &first_components);
+    std::vector<IntegrationPoint> points;
+    for (int i = 0; i < n; ++i) {
+      double x = diagonal[i];
+      double weight = 2 * pow(first_components[i], 2);
+      if (n > 1) {
+        double value, derivative;
+        EvaluateLegendrePolynomial(n, x, &value, &derivative);
+        x -= value / derivative;
+        EvaluateLegendrePolynomial(n, x, &value, &derivative);
+        weight = 2.0 / ((1 - x * x) * derivative * derivative);
+      }
+      points.emplace_back(x, weight);
+    }
+    std::sort(points.begin(), points.end(), [](const IntegrationPoint &lhs, const IntegrationPoint &rhs) {
+      return lhs.GetCoordinate() < rhs.GetCoordinate();
+    });
+    return points;
+  }
+
+  // Implicit QL algorithm for a symmetric tridiagonal matrix that only accumulates the first row of the eigenvectors.
+  static void DiagonalizeTridiagonalMatrix(std::vector<double> *diagonal, std::vector<double> *off_diagonal,
+                                           std::vector<double> *first_components) {
+    std::vector<double> &d = *diagonal;
+    std::vector<double> &e = *off_diagonal;
+    std::vector<double> &z = *first_components;
+    int n = static_cast<int>(d.size());
+    for (int l = 0; l < n; ++l) {
+      for (int iteration = 0; iteration < 64; ++iteration) {
+        int m = l;
+        for (; m < n - 1; ++m) {
+          double dd = std::abs(d[m]) + std::abs(d[m + 1]);
+          if (std::abs(e[m]) <= 1e-16 * dd) break;
+        }
+        if (m == l) break;
+        double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+        double r = std::hypot(g, 1.0);
+        g = d[m] - d[l] + e[l] / (g + (g >= 0 ? r : -r));
+        double s = 1, c = 1, p = 0;
+        int i = m - 1;
+        for (; i >= l; --i) {
+          double f = s * e[i];
+          double b = c * e[i];
+          r = std::hypot(f, g);
+          e[i + 1] = r;
+          if (r == 0) {
+            d[i + 1] -= p;
+            e[m] = 0;
+            break;
+          }
+          s = f / r;
+          c = g / r;
+          g = d[i + 1] - p;
+          r = (d[i] - g) * s + 2.0 * c * b;
+          p = s * r;
+          d[i + 1] = g + p;
+          g = c * r - b;
+          f = z[i + 1];
+          z[i + 1] = s * z[i] + c * f;
+          z[i] = c * z[i] - s * f;
+        }
+        if (r == 0 && i >= l) continue;
+        d[l] -= p;
+        e[l] = g;
+        e[m] = 0;
+      }
+    }
+  }
+
+  static void EvaluateLegendrePolynomial(int n, double x, double *value, double *derivative) {
+    double previous = 1;
+    double current = x;
+    for (int k = 2; k <= n; ++k) {
+      double next = ((2 * k - 1) * x * current - (k - 1) * previous) / k;
+      previous = current;
+      current = next;
+    }
+    *value = current;
+    *derivative = n * (x * current - previous) / (x * x - 1);
+  }
+};
+}  // namespace itg
+}  // namespace iga
+
+#endif  // SRC_IGA_ITG_GAUSS_LEGENDRE_H_
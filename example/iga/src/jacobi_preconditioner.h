@@ -0,0 +1,48 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_SLV_JACOBI_PRECONDITIONER_H_
+#define SRC_IGA_SLV_JACOBI_PRECONDITIONER_H_
+
+#include <armadillo>
+#include <stdexcept>
+
+#include "preconditioner.h"
+
+namespace iga {
+namespace slv {
+class JacobiPreconditioner : public Preconditioner {
+ public:
+  void SetUp(const arma::sp_mat &matA) override {
+    inverse_diagonal_ = arma::dvec(matA.n_rows, arma::fill::zeros);
+    for (arma::sp_mat::const_iterator it = matA.begin(); it != matA.end(); ++it) {
+      if (it.row() == it.col()) inverse_diagonal_(it.row()) = *it;
+    }
+    for (auto &entry : inverse_diagonal_) {
+      if (entry == 0) throw std::runtime_error("The Jacobi preconditioner requires a non-zero diagonal.");
+      entry = 1.0 / entry;
+    }
+  }
+
+  arma::dvec Apply(const arma::dvec &residual) const override {
+    return inverse_diagonal_ % residual;
+  }
+
+ private:
+  arma::dvec inverse_diagonal_;
+};
+}  // namespace slv
+}  // namespace iga
+
+#endif  // SRC_IGA_SLV_JACOBI_PRECONDITIONER_H_
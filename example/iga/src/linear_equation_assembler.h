@@ -15,14 +15,20 @@ You should have received a copy of the GNU Lesser General Public License along w
 #ifndef SRC_IGA_LINEAR_EQUATION_ASSEMBLER_H_
 #define SRC_IGA_LINEAR_EQUATION_ASSEMBLER_H_
 
+#include <algorithm>
 #include <armadillo>
+#include <array>
+#include <memory>
+#include <stdexcept>
 #include <vector>
 
 #include "element_integral_calculator.h"
 #include "element_generator.h"
 #include "integration_rule.h"
 #include "multi_index_handler.h"
+#include "neumann_assembler.h"
 #include "nurbs.h"
+#include "patch_quadrature.h"
 
 namespace iga {
 template<int DIM>
@@ -30,6 +36,7 @@ class LinearEquationAssembler {
  public:
   explicit LinearEquationAssembler(std::shared_ptr<spl::NURBS<DIM>> spl) : spline_(std::move(spl)) {
     elm_gen_ = std::make_shared<iga::elm::ElementGenerator<DIM>>(spline_);
+    SetBoundaryIndices();
   }
 
   void GetLeftSide(const iga::itg::IntegrationRule &rule, const std::shared_ptr<arma::dmat> &matA,
@@ -39,131 +46,173 @@ class LinearEquationAssembler {
     }
   }
 
+  void GetLeftSide(const iga::itg::IntegrationRule &rule, const std::shared_ptr<arma::sp_mat> &matA,
+      const iga::ElementIntegralCalculator<DIM> &elm_itg_calc, double thermal_conductivity = 1.0) const {
+    *matA += AssembleSparseMatrix(elm_itg_calc, rule, [&](const ElementBasis &basis) {
+      return elm_itg_calc.GetLaplaceElementMatrixSumFactorized(basis, thermal_conductivity);
+    });
+  }
+
+  void GetMassMatrix(const iga::itg::IntegrationRule &rule, const std::shared_ptr<arma::sp_mat> &matM,
+      const iga::ElementIntegralCalculator<DIM> &elm_itg_calc) const {
+    *matM += AssembleSparseMatrix(elm_itg_calc, rule, [&](const ElementBasis &basis) {
+      return elm_itg_calc.GetMassElementMatrixSumFactorized(basis);
+    });
+  }
+
+  void GetLeftSide(const iga::PatchQuadrature<DIM> &quadrature, const std::shared_ptr<arma::sp_mat> &matA,
+      const iga::ElementIntegralCalculator<DIM> &elm_itg_calc, double thermal_conductivity = 1.0) const {
+    *matA += AssembleSparseMatrix(elm_itg_calc, quadrature, [&](const ElementBasis &basis) {
+      return elm_itg_calc.GetLaplaceElementMatrixSumFactorized(basis, thermal_conductivity);
+    });
+  }
+
+  void GetMassMatrix(const iga::PatchQuadrature<DIM> &quadrature, const std::shared_ptr<arma::sp_mat> &matM,
+      const iga::ElementIntegralCalculator<DIM> &elm_itg_calc) const {
+    *matM += AssembleSparseMatrix(elm_itg_calc, quadrature, [&](const ElementBasis &basis) {
+      return elm_itg_calc.GetMassElementMatrixSumFactorized(basis);
+    });
+  }
+
   void GetRightSide(const iga::itg::IntegrationRule &rule, const std::shared_ptr<arma::dvec> &vecB,
       const iga::ElementIntegralCalculator<DIM> &elm_itg_calc, const std::shared_ptr<arma::dvec> &srcCp) const {
     for (int e = 0; e < elm_gen_->GetNumberOfElements(); ++e) {
-      elm_itg_calc.GetLaplaceElementIntegral(e, rule, vecB, srcCp);
+      AddSourceElementVector(elm_itg_calc, elm_itg_calc.GetElementBasis(e, rule), *srcCp, vecB.get());
     }
   }
 
+  // Assembles the stiffness matrix and the load vector in a single pass, so that the basis of each element is only
+  // evaluated once.
+  void GetSystem(const iga::itg::IntegrationRule &rule, const std::shared_ptr<arma::sp_mat> &matA,
+      const std::shared_ptr<arma::dvec> &vecB, const iga::ElementIntegralCalculator<DIM> &elm_itg_calc,
+      const std::shared_ptr<arma::dvec> &srcCp, double thermal_conductivity = 1.0) const {
+    *matA += AssembleSparseMatrix(elm_itg_calc, rule, [&](const ElementBasis &basis) {
+      AddSourceElementVector(elm_itg_calc, basis, *srcCp, vecB.get());
+      return elm_itg_calc.GetLaplaceElementMatrixSumFactorized(basis, thermal_conductivity);
+    });
+  }
+
+  // The face data of the Neumann assembly is computed on the first call and reused as long as the rule stays the same.
   void GetRightSideNeumann(const iga::itg::IntegrationRule &rule, const std::shared_ptr<arma::dvec> &vecB,
-      const std::array<std::array<std::shared_ptr<arma::dvec>, 2>, DIM> &NeumannCp) const {
+      const std::array<std::array<std::shared_ptr<arma::dvec>, 2>, DIM> &NeumannCp) {
     if (DIM == 1) throw std::runtime_error("Neumann boundary conditions are not implemented for 1d splines!");
-    std::array<std::array<std::shared_ptr<spl::NURBS<DIM - 1>>, 2>, DIM> boundary_splines = GetBoundarySplines();
-    std::array<std::array<std::vector<int>, 2>, DIM> boundary_spline_connectivity = GetBoundarySplineConnectivity();
-    for (int i = 0; i < boundary_splines.size(); ++i) {
-      for (int j = 0; j < boundary_splines[i].size(); ++j) {
-        iga::elm::ElementGenerator<DIM - 1> elm_gen(boundary_splines[i][j]);
-        iga::BasisFunctionHandler<DIM - 1> baf_handler(boundary_splines[i][j]);
-        iga::ConnectivityHandler<DIM - 1> connectivity_handler(boundary_splines[i][j]);
-        for (int e = 0; e < elm_gen.GetNumberOfElements(); ++e) {
-          std::vector<iga::elm::ElementIntegrationPoint<DIM - 1>> elm_intgr_pnts =
-              baf_handler.EvaluateAllElementNonZeroNURBSBasisFunctions(e, rule);
-          for (auto &p : elm_intgr_pnts) {
-            double bc_int_pnt = 0;
-            for (int l = 0; l < p.GetNumberOfNonZeroBasisFunctions(); ++l) {
-              bc_int_pnt += p.GetBasisFunctionValue(l) *
-                  (*(NeumannCp[i][j]))(static_cast<uint64_t>(connectivity_handler.GetGlobalIndex(e, l) - 1));
-            }
-            for (int k = 0; k < p.GetNumberOfNonZeroBasisFunctions(); ++k) {
-              double temp = p.GetBasisFunctionValue(k) * bc_int_pnt * p.GetWeight() * p.GetJacobianDeterminant();
-              (*vecB)(static_cast<uint64_t>(
-                          boundary_spline_connectivity[i][j][connectivity_handler.GetGlobalIndex(e, k) - 1])) += temp;
-            }
-          }
-        }
-      }
+    if (neumann_assembler_ == nullptr || !neumann_assembler_->UsesRule(rule)) {
+      neumann_assembler_ = std::make_shared<iga::NeumannAssembler<DIM>>(GetBoundarySplines(),
+                                                                        boundary_spline_connectivity_, rule);
     }
+    neumann_assembler_->GetRightSide(vecB, NeumannCp);
   }
 
   std::array<std::array<std::shared_ptr<spl::NURBS<DIM - 1>>, 2>, DIM> GetBoundarySplines() const {
     std::array<int, DIM> points_per_dir = spline_->GetPointsPerDirection();
     std::array<std::array<std::shared_ptr<spl::NURBS<DIM - 1>>, 2>, DIM> boundary_splines;
-    std::array<std::array<std::vector<int>, 2>, DIM> boundary_spline_connectivity = GetBoundarySplineConnectivity();
     for (int i = 0; i < DIM; ++i) {
       std::array<Degree, DIM - 1> degree;
       std::array<std::shared_ptr<baf::KnotVector>, DIM - 1> kv_ptr;
       int m = 0;
       for (int j = 0; j < DIM; ++j) {
         if (j != i) {
-          kv_ptr[m] = spline_->GetKnotVector(m);
-          degree[m] = spline_->GetDegree(m);
+          kv_ptr[m] = spline_->GetKnotVector(j);
+          degree[m] = spline_->GetDegree(j);
           ++m;
         }
       }
-      std::array<std::vector<baf::ControlPoint>, 2> control_points;
-      std::array<std::vector<double>, 2> weights;
-      util::MultiIndexHandler<DIM> mih(points_per_dir);
-      for (int k = 0; k < boundary_spline_connectivity[i].size(); ++k) {
-        for (int n = 0; n < boundary_spline_connectivity[i][k].size(); ++n) {
-          mih.Set1DIndex(boundary_spline_connectivity[i][k][n]);
-          control_points[k].emplace_back(spline_->GetControlPoint(mih.GetIndices()));
-          weights[k].emplace_back(spline_->GetWeight(mih.GetIndices()));
+      for (int k = 0; k < 2; ++k) {
+        std::vector<baf::ControlPoint> control_points;
+        std::vector<double> weights;
+        for (int index : boundary_spline_connectivity_[i][k]) {
+          std::array<int, DIM> indices{};
+          for (int d = 0; d < DIM; ++d) {
+            indices[d] = index % points_per_dir[d];
+            index /= points_per_dir[d];
+          }
+          control_points.emplace_back(spline_->GetControlPoint(indices));
+          weights.emplace_back(spline_->GetWeight(indices));
         }
-        boundary_splines[i][k] = std::make_shared<spl::NURBS<DIM - 1>>(kv_ptr, degree, control_points[k], weights[k]);
+        boundary_splines[i][k] = std::make_shared<spl::NURBS<DIM - 1>>(kv_ptr, degree, control_points, weights);
       }
     }
     return boundary_splines;
   }
 
-  std::array<std::array<std::vector<int>, 2>, DIM> GetBoundarySplineConnectivity() const {
-    std::array<int, DIM> points_per_dir = spline_->GetPointsPerDirection();
-    std::array<std::array<std::vector<int>, 2>, DIM> boundary_spl_connectivity;
-    for (int i = 0; i < DIM; ++i) {
-      util::MultiIndexHandler<DIM> mih(points_per_dir);
-      for (int k = 0; k < mih.Get1DLength(); ++k) {
-        if (mih[i] == 0) {
-          boundary_spl_connectivity[i][0].emplace_back(mih.Get1DIndex());
-        }
-        if (mih[i] == points_per_dir[i] - 1) {
-          boundary_spl_connectivity[i][1].emplace_back(mih.Get1DIndex());
-        }
-        ++mih;
-      }
+  // Returns the indices of the control points of the faces xi_i = 0 and xi_i = 1 for each parametric direction i.
+  const std::array<std::array<std::vector<int>, 2>, DIM> &GetBoundarySplineConnectivity() const {
+    return boundary_spline_connectivity_;
+  }
+
+  // Returns the indices of the control points on the boundary in ascending order. They are determined once from the
+  // control net when the assembler is created.
+  const std::vector<int> &GetBoundaryIndices() const {
+    return boundary_indices_;
+  }
+
+  bool IsOnBoundary(int index) const {
+    return on_boundary_[index];
+  }
+
+  void SetZeroBC(const std::shared_ptr<arma::dmat> &matA, const std::shared_ptr<arma::dvec> &vecB) const {
+    SetDirichletBC(matA, vecB);
+  }
+
+  // Replaces the boundary rows of the dense system by the identity and keeps the boundary columns. The Dirichlet values
+  // are given in the order of GetBoundaryIndices.
+  void SetDirichletBC(const std::shared_ptr<arma::dmat> &matA, const std::shared_ptr<arma::dvec> &vecB,
+                      const std::shared_ptr<arma::dvec> &Dirichlet = nullptr) const {
+    for (uint64_t i = 0; i < boundary_indices_.size(); ++i) {
+      auto index = static_cast<uint64_t>(boundary_indices_[i]);
+      (*vecB)(index) = Dirichlet == nullptr ? 0.0 : (*Dirichlet)(i);
+      (*matA).row(index).fill(0);
+      (*matA)(index, index) = 1;
     }
-    return boundary_spl_connectivity;
   }
 
-  void SetZeroBC(const std::shared_ptr<arma::dmat> &matA, const std::shared_ptr<arma::dvec> &vecB) {
-    util::MultiIndexHandler<DIM> mih(spline_->GetPointsPerDirection());
-    while (true) {
-      bool on_boundary = false;
-      for (int i = 0; i < DIM; ++i) {
-        if (!((mih[i] > 0) && (mih.GetDifferenceIndices()[i] > 0))) {
-          on_boundary = true;
-        }
-      }
-      if (on_boundary) {
-        (*vecB)(static_cast<uint64_t>(mih.Get1DIndex())) = 0;
-        (*matA).row(static_cast<uint64_t>(mih.Get1DIndex())).fill(0);
-        (*matA)(static_cast<uint64_t>(mih.Get1DIndex()), static_cast<uint64_t>(mih.Get1DIndex())) = 1;
+  void SetZeroBC(const std::shared_ptr<arma::sp_mat> &matA, const std::shared_ptr<arma::dvec> &vecB) const {
+    SetDirichletBC(matA, vecB);
+  }
+
+  // Eliminates the boundary rows and columns of the sparse system, so that it stays symmetric.
+  void SetDirichletBC(const std::shared_ptr<arma::sp_mat> &matA, const std::shared_ptr<arma::dvec> &vecB,
+                      const std::shared_ptr<arma::dvec> &Dirichlet = nullptr) const {
+    SetDirichletBCRightSide(*matA, vecB, Dirichlet);
+    SetDirichletBCLeftSide(matA);
+  }
+
+  // The left side has to be the one without boundary conditions, since its boundary columns are lifted to the right.
+  void SetDirichletBCRightSide(const arma::sp_mat &matA, const std::shared_ptr<arma::dvec> &vecB,
+                               const std::shared_ptr<arma::dvec> &Dirichlet = nullptr) const {
+    if (Dirichlet != nullptr) {
+      arma::dvec boundary_values((*vecB).n_elem, arma::fill::zeros);
+      for (uint64_t i = 0; i < boundary_indices_.size(); ++i) {
+        boundary_values(static_cast<uint64_t>(boundary_indices_[i])) = (*Dirichlet)(i);
       }
-      if (mih.Get1DIndex() == mih.Get1DLength() - 1) break;
-      ++mih;
+      *vecB -= matA * boundary_values;
+    }
+    for (uint64_t i = 0; i < boundary_indices_.size(); ++i) {
+      (*vecB)(static_cast<uint64_t>(boundary_indices_[i])) = Dirichlet == nullptr ? 0.0 : (*Dirichlet)(i);
     }
   }
 
-  void SetDirichletBC(const std::shared_ptr<arma::dmat> &matA, const std::shared_ptr<arma::dvec> &vecB,
-                      std::shared_ptr<arma::dvec> Dirichlet = nullptr) {
-    util::MultiIndexHandler<DIM> mih(spline_->GetPointsPerDirection());
-    uint64_t num_boundary_cp = 0;
-    if (Dirichlet == nullptr) Dirichlet = std::make_shared<arma::dvec>((*vecB).size(), arma::fill::zeros);
-    while (true) {
-      bool on_boundary = false;
-      for (int i = 0; i < DIM; ++i) {
-        if (!((mih[i] > 0) && (mih.GetDifferenceIndices()[i] > 0))) {
-          on_boundary = true;
-        }
-      }
-      if (on_boundary) {
-        (*vecB)(static_cast<uint64_t>(mih.Get1DIndex())) = (*Dirichlet)(num_boundary_cp);
-        (*matA).row(static_cast<uint64_t>(mih.Get1DIndex())).fill(0);
-        (*matA)(static_cast<uint64_t>(mih.Get1DIndex()), static_cast<uint64_t>(mih.Get1DIndex())) = 1;
-        ++num_boundary_cp;
+  void SetDirichletBCLeftSide(const std::shared_ptr<arma::sp_mat> &matA) const {
+    arma::uword num_entries = boundary_indices_.size();
+    for (arma::sp_mat::const_iterator it = (*matA).begin(); it != (*matA).end(); ++it) {
+      if (!on_boundary_[it.row()] && !on_boundary_[it.col()]) ++num_entries;
+    }
+    arma::umat locations(2, num_entries);
+    arma::dvec values(num_entries);
+    arma::uword n = 0;
+    for (arma::sp_mat::const_iterator it = (*matA).begin(); it != (*matA).end(); ++it) {
+      if (!on_boundary_[it.row()] && !on_boundary_[it.col()]) {
+        locations(0, n) = it.row();
+        locations(1, n) = it.col();
+        values(n++) = *it;
       }
-      if (mih.Get1DIndex() == mih.Get1DLength() - 1) break;
-      ++mih;
     }
+    for (int index : boundary_indices_) {
+      locations(0, n) = static_cast<arma::uword>(index);
+      locations(1, n) = static_cast<arma::uword>(index);
+      values(n++) = 1.0;
+    }
+    *matA = arma::sp_mat(true, locations, values, (*matA).n_rows, (*matA).n_cols);
   }
 
   // Only used for test case in test/solution_vtk_writer_examples.cc which is currently commented out.
@@ -193,9 +242,133 @@ class LinearEquationAssembler {
     }
   }*/
 
-private:
-std::shared_ptr<spl::NURBS<DIM>> spline_;
-std::shared_ptr<iga::elm::ElementGenerator<DIM>> elm_gen_;
+ private:
+  // A control point lies on the boundary if one of its indices is the first or the last in its direction. The faces are
+  // collected at the same time.
+  void SetBoundaryIndices() {
+    std::array<int, DIM> points_per_dir = spline_->GetPointsPerDirection();
+    std::array<int, DIM> indices{};
+    on_boundary_.assign(static_cast<uint64_t>(spline_->GetNumberOfControlPoints()), false);
+    for (uint64_t i = 0; i < on_boundary_.size(); ++i) {
+      for (int d = 0; d < DIM; ++d) {
+        if (indices[d] == 0 || indices[d] == points_per_dir[d] - 1) on_boundary_[i] = true;
+      }
+      if (on_boundary_[i]) boundary_indices_.emplace_back(static_cast<int>(i));
+      for (int d = 0; d < DIM; ++d) {
+        if (indices[d] == 0) boundary_spline_connectivity_[d][0].emplace_back(static_cast<int>(i));
+        if (indices[d] == points_per_dir[d] - 1) boundary_spline_connectivity_[d][1].emplace_back(static_cast<int>(i));
+      }
+      for (int d = 0; d < DIM && ++indices[d] == points_per_dir[d]; ++d) {
+        indices[d] = 0;
+      }
+    }
+  }
+
+  using ElementBasis = typename iga::ElementIntegralCalculator<DIM>::ElementBasis;
+
+  static void AddSourceElementVector(const iga::ElementIntegralCalculator<DIM> &elm_itg_calc,
+                                     const ElementBasis &basis, const arma::dvec &srcCp, arma::dvec *vecB) {
+    arma::dvec element_vector = elm_itg_calc.GetSourceElementVectorSumFactorized(basis, srcCp);
+    for (uint64_t j = 0; j < basis.global_indices.size(); ++j) {
+      (*vecB)(basis.global_indices[j]) += element_vector(j);
+    }
+  }
+
+  template<typename ElementMatrix>
+  arma::sp_mat AssembleSparseMatrix(const iga::ElementIntegralCalculator<DIM> &elm_itg_calc,
+                                    const iga::itg::IntegrationRule &rule, ElementMatrix element_matrix) const {
+    return AssembleSparseMatrix([&](int e) { return elm_itg_calc.GetElementBasis(e, rule); }, element_matrix);
+  }
+
+  template<typename ElementMatrix>
+  arma::sp_mat AssembleSparseMatrix(const iga::ElementIntegralCalculator<DIM> &elm_itg_calc,
+                                    const iga::PatchQuadrature<DIM> &quadrature, ElementMatrix element_matrix) const {
+    return AssembleSparseMatrix([&](int e) {
+      return elm_itg_calc.GetElementBasis(e, quadrature.GetElementRules(e));
+    }, element_matrix);
+  }
+
+  // The element matrices are added straight into the values of the compressed sparse column pattern of the spline.
+  template<typename GetBasis, typename ElementMatrix>
+  arma::sp_mat AssembleSparseMatrix(GetBasis get_basis, ElementMatrix element_matrix) const {
+    arma::uvec row_indices;
+    arma::uvec col_ptrs;
+    GetSparsityPattern(&row_indices, &col_ptrs);
+    arma::dvec values(row_indices.n_elem, arma::fill::zeros);
+    for (int e = 0; e < elm_gen_->GetNumberOfElements(); ++e) {
+      ElementBasis basis = get_basis(e);
+      arma::dmat elm_mat = element_matrix(basis);
+      const std::vector<arma::uword> &global_indices = basis.global_indices;
+      for (uint64_t k = 0; k < global_indices.size(); ++k) {
+        // The global indices of an element ascend, so that its rows are found in a single pass over the column.
+        arma::uword n = col_ptrs(global_indices[k]);
+        for (uint64_t j = 0; j < global_indices.size(); ++j) {
+          while (row_indices(n) != global_indices[j]) ++n;
+          values(n) += elm_mat(j, k);
+        }
+      }
+    }
+    auto size = static_cast<arma::uword>(spline_->GetNumberOfControlPoints());
+    return arma::sp_mat(row_indices, col_ptrs, values, size, size);
+  }
+
+  // Two basis functions couple if their supports share an element in every parametric direction. In each direction the
+  // functions coupling with a function form a contiguous range, which follows from the first non-zero basis functions
+  // of the elements. The rows of a column are the tensor product of these ranges and ascend if the first direction runs
+  // fastest.
+  void GetSparsityPattern(arma::uvec *row_indices, arma::uvec *col_ptrs) const {
+    std::array<int, DIM> points_per_dir = spline_->GetPointsPerDirection();
+    std::array<std::vector<int>, DIM> lower;
+    std::array<std::vector<int>, DIM> upper;
+    for (int d = 0; d < DIM; ++d) {
+      int degree = spline_->GetDegree(d).get();
+      lower[d].assign(static_cast<uint64_t>(points_per_dir[d]), points_per_dir[d]);
+      upper[d].assign(static_cast<uint64_t>(points_per_dir[d]), -1);
+      for (int first : elm_gen_->GetFirstNonZeroBasisFunctions(d)) {
+        for (int a = first; a <= first + degree; ++a) {
+          lower[d][a] = std::min(lower[d][a], first);
+          upper[d][a] = std::max(upper[d][a], first + degree);
+        }
+      }
+    }
+    auto num_cp = static_cast<arma::uword>(spline_->GetNumberOfControlPoints());
+    *col_ptrs = arma::uvec(num_cp + 1);
+    (*col_ptrs)(0) = 0;
+    util::MultiIndexHandler<DIM> column_handler(points_per_dir);
+    for (arma::uword c = 0; c < num_cp; ++c, ++column_handler) {
+      arma::uword num_rows = 1;
+      for (int d = 0; d < DIM; ++d) {
+        int num_rows_in_dir = upper[d][column_handler[d]] - lower[d][column_handler[d]] + 1;
+        num_rows *= static_cast<arma::uword>(std::max(0, num_rows_in_dir));
+      }
+      (*col_ptrs)(c + 1) = (*col_ptrs)(c) + num_rows;
+    }
+    *row_indices = arma::uvec((*col_ptrs)(num_cp));
+    column_handler = util::MultiIndexHandler<DIM>(points_per_dir);
+    for (arma::uword c = 0; c < num_cp; ++c, ++column_handler) {
+      if ((*col_ptrs)(c + 1) == (*col_ptrs)(c)) continue;
+      std::array<int, DIM> num_rows_per_dir{};
+      for (int d = 0; d < DIM; ++d) {
+        num_rows_per_dir[d] = upper[d][column_handler[d]] - lower[d][column_handler[d]] + 1;
+      }
+      util::MultiIndexHandler<DIM> row_handler(num_rows_per_dir);
+      for (arma::uword n = (*col_ptrs)(c); n < (*col_ptrs)(c + 1); ++n, ++row_handler) {
+        arma::uword row = 0;
+        for (int d = DIM - 1; d >= 0; --d) {
+          row = row * static_cast<arma::uword>(points_per_dir[d]) +
+              static_cast<arma::uword>(lower[d][column_handler[d]] + row_handler[d]);
+        }
+        (*row_indices)(n) = row;
+      }
+    }
+  }
+
+  std::shared_ptr<spl::NURBS<DIM>> spline_;
+  std::shared_ptr<iga::elm::ElementGenerator<DIM>> elm_gen_;
+  std::vector<int> boundary_indices_;
+  std::vector<bool> on_boundary_;
+  std::array<std::array<std::vector<int>, 2>, DIM> boundary_spline_connectivity_;
+  std::shared_ptr<iga::NeumannAssembler<DIM>> neumann_assembler_;
 };
 }  // namespace iga
 
@@ -0,0 +1,35 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_SLV_LINEAR_OPERATOR_H_
+#define SRC_IGA_SLV_LINEAR_OPERATOR_H_
+
+#include <armadillo>
+
+namespace iga {
+namespace slv {
+// A left side that is only known by its action on a vector, so that iterative solvers can be used without assembling
+// a matrix.
+class LinearOperator {
+ public:
+  virtual ~LinearOperator() = default;
+
+  virtual arma::dvec Apply(const arma::dvec &vector) const = 0;
+
+  virtual arma::dvec GetDiagonal() const = 0;
+};
+}  // namespace slv
+}  // namespace iga
+
+#endif  // SRC_IGA_SLV_LINEAR_OPERATOR_H_
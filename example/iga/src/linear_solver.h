@@ -0,0 +1,53 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_SLV_LINEAR_SOLVER_H_
+#define SRC_IGA_SLV_LINEAR_SOLVER_H_
+
+#include <armadillo>
+#include <memory>
+#include <stdexcept>
+
+namespace iga {
+namespace slv {
+class LinearSolver {
+ public:
+  virtual ~LinearSolver() = default;
+
+  // Prepares the solver for the given left side, e.g. by factorizing it. It has to be called again if the left side
+  // changes.
+  virtual void SetLeftSide(const std::shared_ptr<arma::sp_mat> &matA) = 0;
+
+  virtual arma::dvec Solve(const arma::dvec &vecB, const arma::dvec &initial_guess) = 0;
+
+  arma::dvec Solve(const arma::dvec &vecB) {
+    return Solve(vecB, arma::dvec(vecB.n_elem, arma::fill::zeros));
+  }
+
+  // Returns whether the last call of Solve reached the requested accuracy. Direct solvers always do, iterative solvers
+  // do not if they stopped after the maximum number of iterations or broke down.
+  virtual bool HasConverged() const {
+    return true;
+  }
+
+  // Throws if the last call of Solve did not converge, so that the caller does not continue with an inaccurate
+  // solution.
+  void ThrowIfNotConverged() const {
+    if (!HasConverged()) throw std::runtime_error("The linear solver did not converge.");
+  }
+};
+}  // namespace slv
+}  // namespace iga
+
+#endif  // SRC_IGA_SLV_LINEAR_SOLVER_H_
@@ -0,0 +1,202 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_MATRIX_FREE_OPERATOR_H_
+#define SRC_IGA_MATRIX_FREE_OPERATOR_H_
+
+#include <armadillo>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "element_generator.h"
+#include "element_integral_calculator.h"
+#include "integration_rule.h"
+#include "linear_operator.h"
+#include "nurbs.h"
+#include "sum_factorization.h"
+
+namespace iga {
+// Applies laplace_factor * K + mass_factor * M for the stiffness matrix K and the mass matrix M without assembling
+// them. The univariate basis functions are tabulated once per knot span and direction and shared by all elements. Of
+// the symmetric geometric coefficient fields at the integration points, only those with c <= f are stored per element.
+// Each application interpolates the local coefficients and their parametric derivatives to the integration points and
+// integrates back with sum factorization, which costs O(n_q * (p+1)^DIM) per element instead of the O((p+1)^(2*DIM))
+// of a matrix-vector product with the element matrix.
+template<int DIM>
+class MatrixFreeOperator : public iga::slv::LinearOperator {
+ public:
+  MatrixFreeOperator(std::shared_ptr<spl::NURBS<DIM>> spl, const iga::itg::IntegrationRule &rule,
+                     double laplace_factor = 1.0, double mass_factor = 0.0) {
+    iga::ElementIntegralCalculator<DIM> elm_itg_calc(spl);
+    iga::elm::ElementGenerator<DIM> elm_gen(spl);
+    std::array<int, DIM> num_elements = elm_gen.GetNumElementsPerParamDir();
+    for (int d = 0; d < DIM; ++d) {
+      for (int i = 0; i < num_elements[d]; ++i) {
+        std::array<int, DIM> element_indices{};
+        element_indices[d] = i;
+        int e = elm_gen.Get1DElementIndex(element_indices);
+        values_[d].emplace_back(elm_itg_calc.GetUnivariateBasisFunctions(e, rule, 0)[d]);
+        derivatives_[d].emplace_back(elm_itg_calc.GetUnivariateBasisFunctions(e, rule, 1)[d]);
+      }
+    }
+    for (int e = 0; e < elm_gen.GetNumberOfElements(); ++e) {
+      auto basis = elm_itg_calc.GetElementBasis(e, rule);
+      ElementData element;
+      element.global_indices = basis.global_indices;
+      element.weights = arma::dvec(basis.weights);
+      element.element_indices = elm_gen.GetElementIndices(e);
+      std::vector<arma::dvec> coefficients(static_cast<uint64_t>((DIM + 1) * (DIM + 1)));
+      if (laplace_factor != 0) {
+        coefficients = elm_itg_calc.GetLaplaceCoefficients(basis, laplace_factor);
+      }
+      if (mass_factor != 0) {
+        arma::dvec mass_coefficients = elm_itg_calc.GetMassCoefficients(basis) * mass_factor;
+        coefficients[0] = coefficients[0].is_empty() ? mass_coefficients : coefficients[0] + mass_coefficients;
+      }
+      for (int c = 0; c <= DIM; ++c) {
+        for (int f = c; f <= DIM; ++f) {
+          const arma::dvec &coefficient = coefficients[static_cast<uint64_t>(c * (DIM + 1) + f)];
+          if (!IsZero(coefficient)) element.coefficients.emplace_back(c * (DIM + 1) + f, coefficient);
+        }
+      }
+      elements_.emplace_back(element);
+    }
+    constrained_ = arma::dvec(static_cast<uint64_t>(spl->GetNumberOfControlPoints()), arma::fill::zeros);
+    interior_ = arma::dvec(static_cast<uint64_t>(spl->GetNumberOfControlPoints()), arma::fill::ones);
+  }
+
+  // The rows and columns of the given degrees of freedom are replaced by the identity, as done by
+  // LinearEquationAssembler<DIM>::SetDirichletBCLeftSide for assembled matrices.
+  void SetDirichletBoundary(const std::vector<int> &boundary_indices) {
+    constrained_.zeros();
+    interior_.ones();
+    for (int index : boundary_indices) {
+      constrained_(static_cast<uint64_t>(index)) = 1;
+      interior_(static_cast<uint64_t>(index)) = 0;
+    }
+  }
+
+  arma::dvec Apply(const arma::dvec &vector) const override {
+    return interior_ % ApplyUnconstrained(interior_ % vector) + constrained_ % vector;
+  }
+
+  arma::dvec ApplyUnconstrained(const arma::dvec &vector) const {
+    if (vector.n_elem != constrained_.n_elem) {
+      throw std::runtime_error("The vector does not match the number of degrees of freedom.");
+    }
+    arma::dvec result(vector.n_elem, arma::fill::zeros);
+    for (const auto &element : elements_) {
+      arma::dvec local(element.global_indices.size());
+      for (uint64_t j = 0; j < local.n_elem; ++j) {
+        local(j) = element.weights(j) * vector(element.global_indices[j]);
+      }
+      std::array<arma::dvec, DIM + 1> at_points;
+      for (int c = 0; c <= DIM; ++c) {
+        at_points[c] = iga::SumFactorization<DIM>::Apply(GetFactors(element, c), local, false);
+      }
+      std::array<arma::dvec, DIM + 1> weighted;
+      for (const auto &coefficient : element.coefficients) {
+        int c = coefficient.first / (DIM + 1);
+        int f = coefficient.first % (DIM + 1);
+        AddTerm(coefficient.second % at_points[f], &weighted[c]);
+        if (f != c) AddTerm(coefficient.second % at_points[c], &weighted[f]);
+      }
+      arma::dvec local_result(local.n_elem, arma::fill::zeros);
+      for (int c = 0; c <= DIM; ++c) {
+        if (!weighted[c].is_empty()) {
+          local_result += iga::SumFactorization<DIM>::Apply(GetFactors(element, c), weighted[c], true);
+        }
+      }
+      for (uint64_t j = 0; j < local.n_elem; ++j) {
+        result(element.global_indices[j]) += element.weights(j) * local_result(j);
+      }
+    }
+    return result;
+  }
+
+  arma::dvec GetDiagonal() const override {
+    arma::dvec diagonal(constrained_.n_elem, arma::fill::zeros);
+    for (const auto &element : elements_) {
+      arma::dmat local(element.global_indices.size(), 1, arma::fill::zeros);
+      for (const auto &coefficient : element.coefficients) {
+        int c = coefficient.first / (DIM + 1);
+        int f = coefficient.first % (DIM + 1);
+        std::array<const arma::dmat *, DIM> test = GetFactors(element, c);
+        std::array<const arma::dmat *, DIM> trial = GetFactors(element, f);
+        std::array<arma::dmat, DIM> products;
+        std::array<arma::dmat, DIM> ones;
+        for (int d = 0; d < DIM; ++d) {
+          products[d] = *test[d] % *trial[d];
+          ones[d] = arma::dmat(products[d].n_rows, 1, arma::fill::ones);
+        }
+        // The fields (c, f) and (f, c) contribute equally to the diagonal.
+        local += (f == c ? 1.0 : 2.0) * iga::SumFactorization<DIM>::Integrate(products, ones, coefficient.second);
+      }
+      for (uint64_t j = 0; j < element.global_indices.size(); ++j) {
+        diagonal(element.global_indices[j]) += pow(element.weights(j), 2) * local(j, 0);
+      }
+    }
+    return interior_ % diagonal + constrained_;
+  }
+
+ private:
+  struct ElementData {
+    std::vector<arma::uword> global_indices;
+    arma::dvec weights;
+    // Indices of the knot spans of the element in each parametric direction.
+    std::array<int, DIM> element_indices;
+    // Non-zero coefficient fields with c <= f and the index c * (DIM+1) + f of
+    // ElementIntegralCalculator::GetLaplaceCoefficients. The fields with c > f are the same.
+    std::vector<std::pair<int, arma::dvec>> coefficients;
+  };
+
+  // Returns the univariate factors of the B-splines (c = 0) or of their derivatives in the parametric direction c - 1.
+  std::array<const arma::dmat *, DIM> GetFactors(const ElementData &element, int c) const {
+    std::array<const arma::dmat *, DIM> factors{};
+    for (int d = 0; d < DIM; ++d) {
+      const std::vector<arma::dmat> &table = c == d + 1 ? derivatives_[d] : values_[d];
+      factors[d] = &table[static_cast<uint64_t>(element.element_indices[d])];
+    }
+    return factors;
+  }
+
+  static void AddTerm(const arma::dvec &term, arma::dvec *sum) {
+    if (sum->is_empty()) {
+      *sum = term;
+    } else {
+      *sum += term;
+    }
+  }
+
+  static bool IsZero(const arma::dvec &vector) {
+    for (uint64_t i = 0; i < vector.n_elem; ++i) {
+      if (vector(i) != 0) return false;
+    }
+    return true;
+  }
+
+  // Univariate basis functions and their first derivatives at the integration points of each knot span.
+  std::array<std::vector<arma::dmat>, DIM> values_;
+  std::array<std::vector<arma::dmat>, DIM> derivatives_;
+  std::vector<ElementData> elements_;
+  arma::dvec constrained_;
+  arma::dvec interior_;
+};
+}  // namespace iga
+
+#endif  // SRC_IGA_MATRIX_FREE_OPERATOR_H_
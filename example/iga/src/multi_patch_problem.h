@@ -0,0 +1,321 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_MULTI_PATCH_PROBLEM_H_
+#define SRC_IGA_MULTI_PATCH_PROBLEM_H_
+
+#include <armadillo>
+#include <algorithm>
+#include <any>
+#include <array>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "b_spline.h"
+#include "cholesky_solver.h"
+#include "element_integral_calculator.h"
+#include "integration_rule.h"
+#include "linear_equation_assembler.h"
+#include "linear_solver.h"
+#include "multi_index_handler.h"
+#include "nurbs.h"
+#include "parallel_operations.h"
+
+namespace iga {
+// Poisson problem on several patches with conforming interfaces, assembled patch by patch on the given number of
+// threads. Faces that are not shared by two patches form the Dirichlet boundary.
+template<int DIM>
+class MultiPatchProblem {
+ public:
+  MultiPatchProblem(std::vector<std::shared_ptr<spl::NURBS<DIM>>> patches, const iga::itg::IntegrationRule &rule,
+                    std::shared_ptr<iga::slv::LinearSolver> solver = nullptr, double tolerance = 1e-10,
+                    int number_of_threads = 0)
+      : patches_(std::move(patches)), rule_(rule), solver_(std::move(solver)), tolerance_(tolerance),
+        number_of_threads_(number_of_threads) {
+    if (patches_.empty()) throw std::runtime_error("A multi-patch problem needs at least one patch.");
+    if (solver_ == nullptr) solver_ = std::make_shared<iga::slv::CholeskySolver>();
+    for (const auto &patch : patches_) {
+      assemblers_.emplace_back(std::make_shared<iga::LinearEquationAssembler<DIM>>(patch));
+    }
+    SetGlobalIndices();
+    SetBoundaryIndices();
+  }
+
+  // Takes the splines of the given dimension as returned by the readers, e.g. io::XMLReader::ReadFile. B-splines are
+  // converted to NURBS with unit weights.
+  static std::vector<std::shared_ptr<spl::NURBS<DIM>>> GetPatches(const std::vector<std::any> &splines) {
+    std::vector<std::shared_ptr<spl::NURBS<DIM>>> patches;
+    for (const auto &spline : splines) {
+      if (spline.type() == typeid(std::shared_ptr<spl::NURBS<DIM>>)) {
+        patches.emplace_back(std::any_cast<std::shared_ptr<spl::NURBS<DIM>>>(spline));
+      } else if (spline.type() == typeid(std::shared_ptr<spl::BSpline<DIM>>)) {
+        auto b_spline = std::any_cast<std::shared_ptr<spl::BSpline<DIM>>>(spline);
+        KnotVectors<DIM> knot_vectors;
+        std::array<Degree, DIM> degrees;
+        for (int d = 0; d < DIM; ++d) {
+          knot_vectors[d] = std::make_shared<baf::KnotVector>(*b_spline->GetKnotVector(d));
+          degrees[d] = b_spline->GetDegree(d);
+        }
+        std::vector<baf::ControlPoint> control_points;
+        util::MultiIndexHandler<DIM> point_handler(b_spline->GetPointsPerDirection());
+        for (int i = 0; i < point_handler.Get1DLength(); ++i, ++point_handler) {
+          control_points.emplace_back(b_spline->GetControlPoint(point_handler.GetIndices()));
+        }
+        std::vector<double> weights(control_points.size(), 1.0);
+        patches.emplace_back(std::make_shared<spl::NURBS<DIM>>(knot_vectors, degrees, control_points, weights));
+      }
+    }
+    return patches;
+  }
+
+  int GetNumberOfPatches() const {
+    return static_cast<int>(patches_.size());
+  }
+
+  int GetNumberOfDegreesOfFreedom() const {
+    return num_dof_;
+  }
+
+  // Returns the global index of each control point of the patch.
+  const std::vector<arma::uword> &GetGlobalIndices(int patch) const {
+    return global_indices_[patch];
+  }
+
+  // Returns the global indices of the control points on faces that are not shared with another patch.
+  const std::vector<int> &GetBoundaryIndices() const {
+    return boundary_indices_;
+  }
+
+  // Assembles the global stiffness matrix and the load vector of the source given by its control point values on each
+  // patch, or of a unit source if none is given.
+  void GetSystem(const std::shared_ptr<arma::sp_mat> &matA, const std::shared_ptr<arma::dvec> &vecB,
+                 const std::vector<std::shared_ptr<arma::dvec>> &srcCp = {}) const {
+    auto num_dof = static_cast<arma::uword>(num_dof_);
+    auto num_patches = static_cast<int>(patches_.size());
+    std::vector<arma::sp_mat> patch_matrices(patches_.size());
+    std::vector<arma::dvec> patch_right_sides(patches_.size());
+    util::ParallelOperations::ForEachRange(num_patches, number_of_threads_, [&](int first_patch, int last_patch) {
+      for (int p = first_patch; p < last_patch; ++p) {
+        AssemblePatch(static_cast<uint64_t>(p), srcCp.empty() ? nullptr : srcCp[p], &patch_matrices[p],
+                      &patch_right_sides[p]);
+      }
+    });
+    std::vector<arma::uword> offsets(patches_.size() + 1, 0);
+    for (uint64_t p = 0; p < patches_.size(); ++p) {
+      offsets[p + 1] = offsets[p] + patch_matrices[p].n_nonzero;
+    }
+    arma::umat locations(2, offsets.back());
+    arma::dvec values(offsets.back());
+    util::ParallelOperations::ForEachRange(num_patches, number_of_threads_, [&](int first_patch, int last_patch) {
+      for (int p = first_patch; p < last_patch; ++p) {
+        AddToBatch(static_cast<uint64_t>(p), patch_matrices[p], offsets[p], &locations, &values);
+        patch_matrices[p] = arma::sp_mat();
+      }
+    });
+    *matA = arma::sp_mat(true, locations, values, num_dof, num_dof);
+    vecB->zeros(num_dof);
+    for (uint64_t p = 0; p < patches_.size(); ++p) {
+      for (uint64_t i = 0; i < patch_right_sides[p].n_elem; ++i) {
+        (*vecB)(global_indices_[p][i]) += patch_right_sides[p](i);
+      }
+    }
+  }
+
+  // Replaces the boundary rows and columns by the identity and sets the right side there to zero.
+  void SetZeroBC(const std::shared_ptr<arma::sp_mat> &matA, const std::shared_ptr<arma::dvec> &vecB) const {
+    std::vector<arma::uword> rows, cols;
+    std::vector<double> values;
+    for (arma::sp_mat::const_iterator it = (*matA).begin(); it != (*matA).end(); ++it) {
+      if (!on_boundary_[it.row()] && !on_boundary_[it.col()]) {
+        rows.emplace_back(it.row());
+        cols.emplace_back(it.col());
+        values.emplace_back(*it);
+      }
+    }
+    for (int index : boundary_indices_) {
+      rows.emplace_back(static_cast<arma::uword>(index));
+      cols.emplace_back(static_cast<arma::uword>(index));
+      values.emplace_back(1.0);
+      (*vecB)(static_cast<uint64_t>(index)) = 0;
+    }
+    arma::umat locations(2, rows.size());
+    for (uint64_t i = 0; i < rows.size(); ++i) {
+      locations(0, i) = rows[i];
+      locations(1, i) = cols[i];
+    }
+    *matA = arma::sp_mat(true, locations, arma::dvec(values), (*matA).n_rows, (*matA).n_cols);
+  }
+
+  arma::dvec GetSteadyStateSolution() const {
+    auto matA = std::make_shared<arma::sp_mat>(num_dof_, num_dof_);
+    auto vecB = std::make_shared<arma::dvec>(num_dof_, arma::fill::zeros);
+    GetSystem(matA, vecB);
+    SetZeroBC(matA, vecB);
+    solver_->SetLeftSide(matA);
+    arma::dvec solution = solver_->Solve(*vecB);
+    solver_->ThrowIfNotConverged();
+    return solution;
+  }
+
+  // Returns the coefficients of the control points of the patch, e.g. for iga::SolutionVTKWriter<DIM>.
+  arma::dvec GetPatchSolution(const arma::dvec &solution, int patch) const {
+    arma::dvec patch_solution(global_indices_[patch].size());
+    for (uint64_t i = 0; i < patch_solution.n_elem; ++i) {
+      patch_solution(i) = solution(global_indices_[patch][i]);
+    }
+    return patch_solution;
+  }
+
+ private:
+  // Assembles the system of the patch in its local numbering.
+  void AssemblePatch(uint64_t p, std::shared_ptr<arma::dvec> srcCp, arma::sp_mat *patch_matA,
+                     arma::dvec *patch_vecB) const {
+    auto num_cp = static_cast<uint64_t>(patches_[p]->GetNumberOfControlPoints());
+    if (srcCp == nullptr) srcCp = std::make_shared<arma::dvec>(num_cp, arma::fill::ones);
+    iga::ElementIntegralCalculator<DIM> elm_itg_calc(patches_[p]);
+    auto matA = std::make_shared<arma::sp_mat>(num_cp, num_cp);
+    auto vecB = std::make_shared<arma::dvec>(num_cp, arma::fill::zeros);
+    assemblers_[p]->GetSystem(rule_, matA, vecB, elm_itg_calc, srcCp);
+    *patch_matA = std::move(*matA);
+    *patch_vecB = std::move(*vecB);
+  }
+
+  // Writes the entries of the patch matrix in global numbering into the batch, starting at the given offset.
+  void AddToBatch(uint64_t p, const arma::sp_mat &patch_matA, arma::uword offset, arma::umat *locations,
+                  arma::dvec *values) const {
+    arma::uword k = offset;
+    for (arma::sp_mat::const_iterator it = patch_matA.begin(); it != patch_matA.end(); ++it, ++k) {
+      (*locations)(0, k) = global_indices_[p][it.row()];
+      (*locations)(1, k) = global_indices_[p][it.col()];
+      (*values)(k) = *it;
+    }
+  }
+
+  // Numbers the control points patch by patch. A control point on a patch face that coincides with one of a face of a
+  // previous patch gets its global index. The coordinates are hashed on a grid of the tolerance, so that the lookup
+  // only has to check the neighboring grid cells.
+  void SetGlobalIndices() {
+    std::map<std::vector<int64_t>, std::vector<std::pair<int, std::vector<double>>>> face_points;
+    for (uint64_t p = 0; p < patches_.size(); ++p) {
+      auto num_cp = static_cast<uint64_t>(patches_[p]->GetNumberOfControlPoints());
+      std::vector<bool> on_face(num_cp, false);
+      for (int index : assemblers_[p]->GetBoundaryIndices()) {
+        on_face[static_cast<uint64_t>(index)] = true;
+      }
+      std::vector<arma::uword> global_indices(num_cp);
+      util::MultiIndexHandler<DIM> point_handler(patches_[p]->GetPointsPerDirection());
+      for (uint64_t i = 0; i < num_cp; ++i, ++point_handler) {
+        if (!on_face[i]) {
+          global_indices[i] = static_cast<arma::uword>(num_dof_++);
+          continue;
+        }
+        baf::ControlPoint control_point = patches_[p]->GetControlPoint(point_handler.GetIndices());
+        std::vector<double> coordinates;
+        for (int d = 0; d < control_point.GetDimension(); ++d) {
+          coordinates.emplace_back(control_point.GetValue(d));
+        }
+        coordinates.emplace_back(patches_[p]->GetWeight(point_handler.GetIndices()));
+        int global_index = FindPoint(face_points, coordinates);
+        if (global_index < 0) {
+          global_index = num_dof_++;
+          face_points[GetCell(coordinates)].emplace_back(global_index, coordinates);
+        }
+        global_indices[i] = static_cast<arma::uword>(global_index);
+      }
+      global_indices_.emplace_back(global_indices);
+    }
+  }
+
+  // A face is an interface if another face consists of the same global indices. The control points of all other faces
+  // are on the boundary.
+  void SetBoundaryIndices() {
+    std::map<std::vector<arma::uword>, int> face_count;
+    std::vector<std::vector<arma::uword>> faces;
+    for (uint64_t p = 0; p < patches_.size(); ++p) {
+      for (const auto &direction : assemblers_[p]->GetBoundarySplineConnectivity()) {
+        for (const auto &side : direction) {
+          std::vector<arma::uword> face;
+          for (int index : side) {
+            face.emplace_back(global_indices_[p][static_cast<uint64_t>(index)]);
+          }
+          std::sort(face.begin(), face.end());
+          ++face_count[face];
+          faces.emplace_back(face);
+        }
+      }
+    }
+    on_boundary_.assign(static_cast<uint64_t>(num_dof_), false);
+    for (const auto &face : faces) {
+      if (face_count[face] > 1) continue;
+      for (arma::uword index : face) {
+        on_boundary_[index] = true;
+      }
+    }
+    for (uint64_t i = 0; i < on_boundary_.size(); ++i) {
+      if (on_boundary_[i]) boundary_indices_.emplace_back(static_cast<int>(i));
+    }
+  }
+
+  std::vector<int64_t> GetCell(const std::vector<double> &coordinates) const {
+    std::vector<int64_t> cell;
+    for (double coordinate : coordinates) {
+      cell.emplace_back(static_cast<int64_t>(std::floor(coordinate / tolerance_)));
+    }
+    return cell;
+  }
+
+  int FindPoint(const std::map<std::vector<int64_t>, std::vector<std::pair<int, std::vector<double>>>> &face_points,
+                const std::vector<double> &coordinates) const {
+    std::vector<int64_t> cell = GetCell(coordinates);
+    std::vector<int64_t> neighbor(cell.size());
+    uint64_t num_neighbors = 1;
+    for (uint64_t d = 0; d < cell.size(); ++d) {
+      num_neighbors *= 3;
+    }
+    for (uint64_t n = 0; n < num_neighbors; ++n) {
+      uint64_t rest = n;
+      for (uint64_t d = 0; d < cell.size(); ++d, rest /= 3) {
+        neighbor[d] = cell[d] + static_cast<int64_t>(rest % 3) - 1;
+      }
+      auto candidates = face_points.find(neighbor);
+      if (candidates == face_points.end()) continue;
+      for (const auto &candidate : candidates->second) {
+        double distance = 0;
+        for (uint64_t d = 0; d < coordinates.size(); ++d) {
+          distance = std::max(distance, std::abs(candidate.second[d] - coordinates[d]));
+        }
+        if (distance <= tolerance_) return candidate.first;
+      }
+    }
+    return -1;
+  }
+
+  std::vector<std::shared_ptr<spl::NURBS<DIM>>> patches_;
+  iga::itg::IntegrationRule rule_;
+  std::shared_ptr<iga::slv::LinearSolver> solver_;
+  double tolerance_;
+  int number_of_threads_;
+  std::vector<std::shared_ptr<iga::LinearEquationAssembler<DIM>>> assemblers_;
+  std::vector<std::vector<arma::uword>> global_indices_;
+  std::vector<int> boundary_indices_;
+  std::vector<bool> on_boundary_;
+  int num_dof_ = 0;
+};
+}  // namespace iga
+
+#endif  // SRC_IGA_MULTI_PATCH_PROBLEM_H_
@@ -0,0 +1,354 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_MULTIGRID_PRECONDITIONER_H_
+#define SRC_IGA_MULTIGRID_PRECONDITIONER_H_
+
+#include <armadillo>
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "chebyshev_smoother.h"
+#include "cholesky_solver.h"
+#include "multi_index_handler.h"
+#include "nurbs.h"
+#include "preconditioner.h"
+#include "sparse_matrix_operator.h"
+
+namespace iga {
+// Geometric multigrid V-cycle on the knot insertion hierarchy of a single patch.
+template<int DIM>
+class MultigridPreconditioner : public iga::slv::Preconditioner {
+ public:
+  // A constrained boundary expects the left side of LinearEquationAssembler<DIM>::SetDirichletBCLeftSide.
+  explicit MultigridPreconditioner(const std::shared_ptr<spl::NURBS<DIM>> &spl, bool constrained_boundary = true,
+                                   int number_of_levels = 0, int smoothing_degree = 3)
+      : constrained_boundary_(constrained_boundary), smoothing_degree_(smoothing_degree) {
+    LevelGeometry finest;
+    util::MultiIndexHandler<DIM> point_handler(spl->GetPointsPerDirection());
+    finest.weights = arma::dvec(static_cast<uint64_t>(spl->GetNumberOfControlPoints()));
+    for (int i = 0; i < point_handler.Get1DLength(); ++i, ++point_handler) {
+      finest.weights(static_cast<uint64_t>(i)) = spl->GetWeight(point_handler.GetIndices());
+    }
+    for (int d = 0; d < DIM; ++d) {
+      degrees_[d] = spl->GetDegree(d).get();
+      std::shared_ptr<baf::KnotVector> knot_vector = spl->GetKnotVector(d);
+      for (size_t k = 0; k < knot_vector->GetNumberOfKnots(); ++k) {
+        finest.knots[d].emplace_back(knot_vector->GetKnot(k).get());
+      }
+    }
+    geometries_.emplace_back(finest);
+    while (number_of_levels <= 0 || static_cast<int>(geometries_.size()) < number_of_levels) {
+      LevelGeometry coarse;
+      bool coarsened = false;
+      for (int d = 0; d < DIM; ++d) {
+        coarse.knots[d] = GetCoarseKnots(geometries_.back().knots[d], degrees_[d]);
+        coarsened = coarsened || coarse.knots[d].size() < geometries_.back().knots[d].size();
+      }
+      if (!coarsened) break;
+      SetProlongation(&geometries_.back(), &coarse);
+      geometries_.emplace_back(coarse);
+    }
+  }
+
+  void SetUp(const arma::sp_mat &matA) override {
+    if (matA.n_rows != geometries_.front().weights.n_elem) {
+      throw std::runtime_error("The left side does not match the number of control points of the spline.");
+    }
+    levels_.assign(geometries_.size(), Level());
+    levels_[0].matrix = std::make_shared<arma::sp_mat>(matA);
+    for (uint64_t l = 0; l + 1 < geometries_.size(); ++l) {
+      levels_[l].smoother = iga::slv::ChebyshevSmoother(smoothing_degree_);
+      levels_[l].smoother.SetUp(std::make_shared<iga::slv::SparseMatrixOperator>(levels_[l].matrix));
+      levels_[l + 1].matrix = std::make_shared<arma::sp_mat>(GetGalerkinProduct(*levels_[l].matrix,
+                                                                                geometries_[l].prolongation));
+      if (constrained_boundary_) {
+        for (int index : GetBoundaryIndices(geometries_[l + 1])) {
+          (*levels_[l + 1].matrix)(static_cast<uint64_t>(index), static_cast<uint64_t>(index)) = 1;
+        }
+      }
+    }
+    coarse_solver_ = std::make_shared<iga::slv::CholeskySolver>();
+    coarse_solver_->SetLeftSide(levels_.back().matrix);
+  }
+
+  arma::dvec Apply(const arma::dvec &residual) const override {
+    if (levels_.empty()) throw std::runtime_error("The preconditioner has to be set up before it is applied.");
+    return Cycle(0, residual);
+  }
+
+  int GetNumberOfLevels() const {
+    return static_cast<int>(geometries_.size());
+  }
+
+  int GetNumberOfDegreesOfFreedom(int level) const {
+    return static_cast<int>(geometries_[level].weights.n_elem);
+  }
+
+  // Maps coefficients on the given level to those on the next finer level.
+  const arma::sp_mat &GetProlongation(int finer_level) const {
+    return geometries_[finer_level].prolongation;
+  }
+
+  // Keeps every second distinct interior knot with its multiplicity.
+  static std::vector<double> GetCoarseKnots(const std::vector<double> &knots, int degree) {
+    std::vector<double> coarse_knots(knots.begin(), knots.begin() + degree + 1);
+    int distinct_knot = 0;
+    for (uint64_t k = static_cast<uint64_t>(degree) + 1; k < knots.size() - degree - 1; ++k) {
+      if (knots[k] != knots[k - 1]) ++distinct_knot;
+      if (distinct_knot % 2 == 0) coarse_knots.emplace_back(knots[k]);
+    }
+    coarse_knots.insert(coarse_knots.end(), knots.end() - degree - 1, knots.end());
+    return coarse_knots;
+  }
+
+  // Returns the matrix T with c_fine = T * c_coarse, computed row by row with the Oslo algorithm.
+  static arma::sp_mat GetKnotInsertionMatrix(const std::vector<double> &coarse_knots,
+                                             const std::vector<double> &fine_knots, int degree) {
+    auto coarse_knot = coarse_knots.begin();
+    for (double knot : fine_knots) {
+      if (coarse_knot != coarse_knots.end() && *coarse_knot == knot) ++coarse_knot;
+    }
+    if (coarse_knot != coarse_knots.end()) throw std::runtime_error("The knot vectors are not nested.");
+    uint64_t num_fine = fine_knots.size() - degree - 1;
+    uint64_t num_coarse = coarse_knots.size() - degree - 1;
+    std::vector<arma::uword> rows, cols;
+    std::vector<double> values;
+    for (uint64_t i = 0; i < num_fine; ++i) {
+      int span = static_cast<int>(std::upper_bound(coarse_knots.begin(), coarse_knots.end(), fine_knots[i]) -
+          coarse_knots.begin()) - 1;
+      // Entry r belongs to the coarse function span - degree + r.
+      std::vector<double> row(static_cast<uint64_t>(degree) + 1, 0.0);
+      row[degree] = 1;
+      for (int k = 1; k <= degree; ++k) {
+        double x = fine_knots[i + k];
+        for (int j = span - k; j <= span; ++j) {
+          int r = j - span + degree;
+          double value = 0;
+          if (j > span - k) value += GetKnotRatio(coarse_knots, j, k, x) * row[r];
+          if (j < span) value += (1 - GetKnotRatio(coarse_knots, j + 1, k, x)) * row[r + 1];
+          row[r] = value;
+        }
+      }
+      for (int r = 0; r <= degree; ++r) {
+        if (row[r] == 0) continue;
+        rows.emplace_back(static_cast<arma::uword>(i));
+        cols.emplace_back(static_cast<arma::uword>(span - degree + r));
+        values.emplace_back(row[r]);
+      }
+    }
+    arma::umat locations(2, rows.size());
+    for (uint64_t k = 0; k < rows.size(); ++k) {
+      locations(0, k) = rows[k];
+      locations(1, k) = cols[k];
+    }
+    return arma::sp_mat(locations, arma::dvec(values), num_fine, num_coarse);
+  }
+
+ private:
+  struct LevelGeometry {
+    std::array<std::vector<double>, DIM> knots;
+    arma::dvec weights;
+    // Prolongation from the next coarser level to this one.
+    arma::sp_mat prolongation;
+  };
+
+  struct Level {
+    std::shared_ptr<arma::sp_mat> matrix;
+    iga::slv::ChebyshevSmoother smoother;
+  };
+
+  arma::dvec Cycle(uint64_t l, const arma::dvec &vecB) const {
+    if (l + 1 == levels_.size()) return coarse_solver_->Solve(vecB);
+    const arma::sp_mat &prolongation = geometries_[l].prolongation;
+    arma::dvec x = levels_[l].smoother.Smooth(vecB, arma::dvec(vecB.n_elem, arma::fill::zeros));
+    arma::dvec coarse_residual = prolongation.t() * arma::dvec(vecB - (*levels_[l].matrix) * x);
+    x += prolongation * Cycle(l + 1, coarse_residual);
+    return levels_[l].smoother.Smooth(vecB, x);
+  }
+
+  // For NURBS the prolongation is P = diag(w_fine)^-1 * T * diag(w_coarse).
+  void SetProlongation(LevelGeometry *fine, LevelGeometry *coarse) const {
+    std::array<arma::sp_mat, DIM> insertion_matrices;
+    std::array<std::vector<std::vector<std::pair<int, double>>>, DIM> insertion_rows;
+    std::array<int, DIM> fine_points;
+    std::array<int, DIM> coarse_points;
+    for (int d = 0; d < DIM; ++d) {
+      insertion_matrices[d] = GetKnotInsertionMatrix(coarse->knots[d], fine->knots[d], degrees_[d]);
+      insertion_rows[d].resize(insertion_matrices[d].n_rows);
+      for (arma::sp_mat::const_iterator it = insertion_matrices[d].begin(); it != insertion_matrices[d].end(); ++it) {
+        insertion_rows[d][it.row()].emplace_back(static_cast<int>(it.col()), *it);
+      }
+      fine_points[d] = static_cast<int>(insertion_matrices[d].n_rows);
+      coarse_points[d] = static_cast<int>(insertion_matrices[d].n_cols);
+    }
+    coarse->weights = GetLeastSquaresSolution(insertion_matrices, fine->weights);
+    std::vector<bool> fine_boundary = GetBoundaryFlags(fine_points);
+    std::vector<bool> coarse_boundary = GetBoundaryFlags(coarse_points);
+    std::vector<arma::uword> rows, cols;
+    std::vector<double> values;
+    util::MultiIndexHandler<DIM> fine_handler(fine_points);
+    for (int i = 0; i < fine_handler.Get1DLength(); ++i, ++fine_handler) {
+      if (constrained_boundary_ && fine_boundary[i]) continue;
+      std::array<int, DIM> length;
+      for (int d = 0; d < DIM; ++d) {
+        length[d] = static_cast<int>(insertion_rows[d][fine_handler[d]].size());
+      }
+      util::MultiIndexHandler<DIM> local_handler(length);
+      for (int k = 0; k < local_handler.Get1DLength(); ++k, ++local_handler) {
+        std::array<int, DIM> coarse_indices;
+        double value = 1;
+        for (int d = 0; d < DIM; ++d) {
+          const auto &entry = insertion_rows[d][fine_handler[d]][local_handler[d]];
+          coarse_indices[d] = entry.first;
+          value *= entry.second;
+        }
+        uint64_t j = GetGlobalIndex(coarse_indices, coarse_points);
+        if (constrained_boundary_ && coarse_boundary[j]) continue;
+        rows.emplace_back(static_cast<arma::uword>(i));
+        cols.emplace_back(j);
+        values.emplace_back(value * coarse->weights(j) / fine->weights(static_cast<uint64_t>(i)));
+      }
+    }
+    arma::umat locations(2, rows.size());
+    for (uint64_t k = 0; k < rows.size(); ++k) {
+      locations(0, k) = rows[k];
+      locations(1, k) = cols[k];
+    }
+    fine->prolongation = arma::sp_mat(locations, arma::dvec(values), fine->weights.n_elem, coarse->weights.n_elem);
+  }
+
+  // Returns the least squares solution x of (T_DIM x ... x T_1) * x = b one direction after the other.
+  static arma::dvec GetLeastSquaresSolution(const std::array<arma::sp_mat, DIM> &matrices, const arma::dvec &vecB) {
+    arma::dvec tensor = vecB;
+    std::array<uint64_t, DIM> points;
+    for (int d = 0; d < DIM; ++d) {
+      points[d] = matrices[d].n_rows;
+    }
+    for (int d = 0; d < DIM; ++d) {
+      iga::slv::CholeskySolver solver;
+      solver.SetLeftSide(std::make_shared<arma::sp_mat>(matrices[d].t() * matrices[d]));
+      uint64_t stride = 1;
+      for (int e = 0; e < d; ++e) {
+        stride *= points[e];
+      }
+      uint64_t num_fibres = tensor.n_elem / points[d];
+      uint64_t num_coarse = matrices[d].n_cols;
+      arma::dvec solution(num_fibres * num_coarse);
+      for (uint64_t f = 0; f < num_fibres; ++f) {
+        uint64_t first = f % stride, last = f / stride;
+        arma::dvec fibre(points[d]);
+        for (uint64_t k = 0; k < points[d]; ++k) {
+          fibre(k) = tensor(first + stride * (k + points[d] * last));
+        }
+        arma::dvec coarse_fibre = solver.Solve(arma::dvec(matrices[d].t() * fibre));
+        for (uint64_t k = 0; k < num_coarse; ++k) {
+          solution(first + stride * (k + num_coarse * last)) = coarse_fibre(k);
+        }
+      }
+      tensor = solution;
+      points[d] = num_coarse;
+    }
+    return tensor;
+  }
+
+  // Returns P^T * A * P, computed row by row.
+  static arma::sp_mat GetGalerkinProduct(const arma::sp_mat &matA, const arma::sp_mat &prolongation) {
+    std::vector<std::map<arma::uword, double>> prolongation_rows(prolongation.n_rows);
+    for (arma::sp_mat::const_iterator it = prolongation.begin(); it != prolongation.end(); ++it) {
+      prolongation_rows[it.row()][it.col()] = *it;
+    }
+    std::vector<std::map<arma::uword, double>> product_rows(matA.n_rows);
+    for (arma::sp_mat::const_iterator it = matA.begin(); it != matA.end(); ++it) {
+      for (const auto &entry : prolongation_rows[it.col()]) {
+        product_rows[it.row()][entry.first] += *it * entry.second;
+      }
+    }
+    std::vector<std::map<arma::uword, double>> coarse_rows(prolongation.n_cols);
+    for (arma::uword i = 0; i < prolongation.n_rows; ++i) {
+      for (const auto &restriction : prolongation_rows[i]) {
+        for (const auto &entry : product_rows[i]) {
+          coarse_rows[restriction.first][entry.first] += restriction.second * entry.second;
+        }
+      }
+    }
+    uint64_t number_of_entries = 0;
+    for (const auto &row : coarse_rows) {
+      number_of_entries += row.size();
+    }
+    arma::umat locations(2, number_of_entries);
+    arma::dvec values(number_of_entries);
+    uint64_t k = 0;
+    for (arma::uword i = 0; i < coarse_rows.size(); ++i) {
+      for (const auto &entry : coarse_rows[i]) {
+        locations(0, k) = i;
+        locations(1, k) = entry.first;
+        values(k++) = entry.second;
+      }
+    }
+    return arma::sp_mat(locations, values, prolongation.n_cols, prolongation.n_cols);
+  }
+
+  std::vector<int> GetBoundaryIndices(const LevelGeometry &geometry) const {
+    std::array<int, DIM> points;
+    for (int d = 0; d < DIM; ++d) {
+      points[d] = static_cast<int>(geometry.knots[d].size()) - degrees_[d] - 1;
+    }
+    std::vector<bool> boundary = GetBoundaryFlags(points);
+    std::vector<int> boundary_indices;
+    for (uint64_t i = 0; i < boundary.size(); ++i) {
+      if (boundary[i]) boundary_indices.emplace_back(static_cast<int>(i));
+    }
+    return boundary_indices;
+  }
+
+  static std::vector<bool> GetBoundaryFlags(const std::array<int, DIM> &points) {
+    util::MultiIndexHandler<DIM> point_handler(points);
+    std::vector<bool> boundary(static_cast<uint64_t>(point_handler.Get1DLength()), false);
+    for (int i = 0; i < point_handler.Get1DLength(); ++i, ++point_handler) {
+      for (int d = 0; d < DIM; ++d) {
+        if (point_handler[d] == 0 || point_handler[d] == points[d] - 1) boundary[i] = true;
+      }
+    }
+    return boundary;
+  }
+
+  static uint64_t GetGlobalIndex(const std::array<int, DIM> &indices, const std::array<int, DIM> &points) {
+    uint64_t index = 0;
+    for (int d = DIM - 1; d >= 0; --d) {
+      index = index * static_cast<uint64_t>(points[d]) + static_cast<uint64_t>(indices[d]);
+    }
+    return index;
+  }
+
+  // Returns (x - t_j) / (t_{j+k} - t_j) for a non-empty interval.
+  static double GetKnotRatio(const std::vector<double> &knots, int j, int k, double x) {
+    return (x - knots[j]) / (knots[j + k] - knots[j]);
+  }
+
+  bool constrained_boundary_;
+  int smoothing_degree_;
+  std::array<int, DIM> degrees_;
+  std::vector<LevelGeometry> geometries_;
+  std::vector<Level> levels_;
+  std::shared_ptr<iga::slv::CholeskySolver> coarse_solver_;
+};
+}  // namespace iga
+
+#endif  // SRC_IGA_MULTIGRID_PRECONDITIONER_H_
@@ -0,0 +1,121 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_NEUMANN_ASSEMBLER_H_
+#define SRC_IGA_NEUMANN_ASSEMBLER_H_
+
+#include <armadillo>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "basis_function_handler.h"
+#include "connectivity_handler.h"
+#include "element_generator.h"
+#include "element_integration_point.h"
+#include "integration_rule.h"
+#include "nurbs.h"
+
+namespace iga {
+// Integrates Neumann fluxes over the 2 * DIM boundary faces of a patch. The face basis functions at the integration
+// points are evaluated once for the given rule.
+template<int DIM>
+class NeumannAssembler {
+ public:
+  using BoundarySplines = std::array<std::array<std::shared_ptr<spl::NURBS<DIM - 1>>, 2>, DIM>;
+  using BoundaryConnectivity = std::array<std::array<std::vector<int>, 2>, DIM>;
+
+  // The boundary splines and the indices of their control points in the patch are the ones returned by
+  // LinearEquationAssembler<DIM>::GetBoundarySplines and GetBoundarySplineConnectivity.
+  NeumannAssembler(const BoundarySplines &boundary_splines, const BoundaryConnectivity &boundary_connectivity,
+                   const iga::itg::IntegrationRule &rule) : rule_(rule) {
+    if (DIM == 1) throw std::runtime_error("Neumann boundary conditions are not implemented for 1d splines!");
+    for (int i = 0; i < DIM; ++i) {
+      for (int j = 0; j < 2; ++j) {
+        iga::elm::ElementGenerator<DIM - 1> elm_gen(boundary_splines[i][j]);
+        iga::BasisFunctionHandler<DIM - 1> baf_handler(boundary_splines[i][j]);
+        iga::ConnectivityHandler<DIM - 1> connectivity_handler(boundary_splines[i][j]);
+        for (int e = 0; e < elm_gen.GetNumberOfElements(); ++e) {
+          std::vector<iga::elm::ElementIntegrationPoint<DIM - 1>> elm_intgr_pnts =
+              baf_handler.EvaluateAllElementNonZeroNURBSBasisFunctions(e, rule);
+          FaceElement element;
+          int num_baf = elm_intgr_pnts.front().GetNumberOfNonZeroBasisFunctions();
+          for (int l = 0; l < num_baf; ++l) {
+            auto face_index = static_cast<arma::uword>(connectivity_handler.GetGlobalIndex(e, l) - 1);
+            element.face_indices.emplace_back(face_index);
+            element.global_indices.emplace_back(static_cast<arma::uword>(boundary_connectivity[i][j][face_index]));
+          }
+          element.values = arma::dmat(elm_intgr_pnts.size(), static_cast<uint64_t>(num_baf));
+          element.factors = arma::dvec(elm_intgr_pnts.size());
+          for (uint64_t q = 0; q < elm_intgr_pnts.size(); ++q) {
+            for (int l = 0; l < num_baf; ++l) {
+              element.values(q, static_cast<uint64_t>(l)) = elm_intgr_pnts[q].GetBasisFunctionValue(l);
+            }
+            element.factors(q) = elm_intgr_pnts[q].GetWeight() * elm_intgr_pnts[q].GetJacobianDeterminant();
+          }
+          faces_[i][j].emplace_back(element);
+        }
+      }
+    }
+  }
+
+  // Adds the integrals of the fluxes given by their control point values on each face to the right side.
+  void GetRightSide(const std::shared_ptr<arma::dvec> &vecB,
+                    const std::array<std::array<std::shared_ptr<arma::dvec>, 2>, DIM> &NeumannCp) const {
+    for (int i = 0; i < DIM; ++i) {
+      for (int j = 0; j < 2; ++j) {
+        if (NeumannCp[i][j] == nullptr) continue;
+        for (const auto &element : faces_[i][j]) {
+          arma::dvec local_flux(element.face_indices.size());
+          for (uint64_t l = 0; l < local_flux.n_elem; ++l) {
+            local_flux(l) = (*NeumannCp[i][j])(element.face_indices[l]);
+          }
+          arma::dvec flux_at_points = element.values * local_flux;
+          arma::dvec local_result = element.values.t() * arma::dvec(flux_at_points % element.factors);
+          for (uint64_t l = 0; l < local_result.n_elem; ++l) {
+            (*vecB)(element.global_indices[l]) += local_result(l);
+          }
+        }
+      }
+    }
+  }
+
+  bool UsesRule(const iga::itg::IntegrationRule &rule) const {
+    std::vector<iga::itg::IntegrationPoint> points = rule.GetIntegrationPoints();
+    std::vector<iga::itg::IntegrationPoint> own_points = rule_.GetIntegrationPoints();
+    if (points.size() != own_points.size()) return false;
+    for (uint64_t q = 0; q < points.size(); ++q) {
+      if (points[q].GetCoordinate() != own_points[q].GetCoordinate() ||
+          points[q].GetWeight() != own_points[q].GetWeight()) return false;
+    }
+    return true;
+  }
+
+ private:
+  struct FaceElement {
+    // Indices of the non-zero basis functions among the control points of the face and of the patch.
+    std::vector<arma::uword> face_indices;
+    std::vector<arma::uword> global_indices;
+    // Basis function values with one row per integration point, and quadrature weight times Jacobian determinant.
+    arma::dmat values;
+    arma::dvec factors;
+  };
+
+  iga::itg::IntegrationRule rule_;
+  std::array<std::array<std::vector<FaceElement>, 2>, DIM> faces_;
+};
+}  // namespace iga
+
+#endif  // SRC_IGA_NEUMANN_ASSEMBLER_H_
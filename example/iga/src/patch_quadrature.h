@@ -0,0 +1,270 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_PATCH_QUADRATURE_H_
+#define SRC_IGA_PATCH_QUADRATURE_H_
+
+#include <math.h>
+#include <algorithm>
+#include <armadillo>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "basis_function_factory.h"
+#include "element_generator.h"
+#include "gauss_legendre.h"
+#include "integration_rule.h"
+#include "knot_vector.h"
+#include "nurbs.h"
+
+namespace iga {
+// Reduced quadrature over a whole patch that integrates the products of the basis functions exactly with about half as
+// many points as element-wise Gauss-Legendre rules. It is split into univariate rules per element.
+template<int DIM>
+class PatchQuadrature {
+ public:
+  explicit PatchQuadrature(const std::shared_ptr<spl::NURBS<DIM>> &spl) {
+    elm_gen_ = std::make_shared<iga::elm::ElementGenerator<DIM>>(spl);
+    for (int d = 0; d < DIM; ++d) {
+      int degree = spl->GetDegree(d).get();
+      std::vector<std::pair<double, double>> points = GetReducedPoints(*spl->GetKnotVector(d), degree);
+      is_reduced_[d] = !points.empty();
+      if (!is_reduced_[d]) points = GetGaussLegendrePoints(d, degree + 1);
+      num_itg_pnts_[d] = static_cast<int>(points.size());
+      element_rules_[d] = SplitIntoElementRules(d, points);
+    }
+  }
+
+  // Returns the univariate rules of the element in each parametric direction on the reference interval [-1, 1].
+  std::vector<iga::itg::IntegrationRule> GetElementRules(int element_number) const {
+    std::vector<iga::itg::IntegrationRule> rules;
+    std::array<int, DIM> element_indices = elm_gen_->GetElementIndices(element_number);
+    for (int d = 0; d < DIM; ++d) {
+      rules.emplace_back(element_rules_[d][element_indices[d]]);
+    }
+    return rules;
+  }
+
+  int GetNumberOfIntegrationPoints(int direction) const {
+    return num_itg_pnts_[direction];
+  }
+
+  // Returns false if the Newton method did not converge and the direction uses element-wise Gauss-Legendre rules.
+  bool IsReduced(int direction) const {
+    return is_reduced_[direction];
+  }
+
+  // Returns an empty vector if the Newton method does not converge.
+  static std::vector<std::pair<double, double>> GetReducedPoints(const baf::KnotVector &knot_vector, int degree) {
+    std::vector<std::pair<double, double>> points;
+    ParamCoord lower = knot_vector.GetKnot(0);
+    for (uint64_t i = 1; i < knot_vector.GetNumberOfKnots(); ++i) {
+      ParamCoord knot = knot_vector.GetKnot(i);
+      if (knot.get() <= knot_vector.GetKnot(i - 1).get()) continue;
+      if (!knot_vector.IsLastKnot(knot) && static_cast<int>(knot_vector.GetMultiplicity(knot)) < degree) continue;
+      std::vector<std::pair<double, double>> part = SolveExactnessConditions(
+          GetTargetKnotVector(knot_vector, degree, lower, knot), 2 * degree);
+      if (part.empty()) return {};
+      points.insert(points.end(), part.begin(), part.end());
+      lower = knot;
+    }
+    return points;
+  }
+
+ private:
+  static std::vector<std::pair<double, double>> SolveExactnessConditions(const baf::KnotVector &target,
+                                                                         int target_degree) {
+    int dimension = static_cast<int>(target.GetNumberOfKnots()) - target_degree - 1;
+    std::vector<std::unique_ptr<baf::BasisFunction>> basis_functions;
+    arma::dvec integrals(static_cast<uint64_t>(dimension));
+    std::vector<double> greville(static_cast<uint64_t>(dimension));
+    for (int i = 0; i < dimension; ++i) {
+      basis_functions.emplace_back(
+          baf::BasisFunctionFactory::CreateDynamic(target, KnotSpan{i}, Degree{target_degree}));
+      integrals(i) = (target.GetKnot(i + target_degree + 1) - target.GetKnot(i)).get() / (target_degree + 1);
+      greville[i] = 0;
+      for (int k = 1; k <= target_degree; ++k) {
+        greville[i] += target.GetKnot(i + k).get() / target_degree;
+      }
+    }
+    // For an odd dimension the first point is fixed at the first knot.
+    bool fix_first = dimension % 2 == 1;
+    int num_pnts = (dimension + 1) / 2;
+    std::vector<double> coordinates(static_cast<uint64_t>(num_pnts));
+    std::vector<double> weights(static_cast<uint64_t>(num_pnts));
+    for (int k = 0; k < num_pnts; ++k) {
+      int first = fix_first ? 2 * k - 1 : 2 * k;
+      if (first < 0) {
+        coordinates[k] = target.GetKnot(0).get();
+        weights[k] = integrals(0);
+      } else {
+        weights[k] = integrals(first) + integrals(first + 1);
+        coordinates[k] = (integrals(first) * greville[first] + integrals(first + 1) * greville[first + 1]) / weights[k];
+      }
+    }
+    double tolerance = 1e-12 * (target.GetLastKnot() - target.GetKnot(0)).get();
+    double residual_norm = GetResidualNorm(basis_functions, integrals, coordinates, weights);
+    for (int iteration = 0; iteration < 50 && residual_norm > tolerance; ++iteration) {
+      arma::dmat jacobian(static_cast<uint64_t>(dimension), static_cast<uint64_t>(dimension), arma::fill::zeros);
+      int column = 0;
+      for (int k = 0; k < num_pnts; ++k) {
+        for (int i = 0; i < dimension; ++i) {
+          jacobian(i, column) = basis_functions[i]->Evaluate(ParamCoord{coordinates[k]});
+        }
+        ++column;
+        if (fix_first && k == 0) continue;
+        for (int i = 0; i < dimension; ++i) {
+          jacobian(i, column) = weights[k] * basis_functions[i]->EvaluateDerivative(ParamCoord{coordinates[k]},
+                                                                                    Derivative{1});
+        }
+        ++column;
+      }
+      arma::dvec step;
+      try {
+        step = arma::solve(jacobian, GetResidual(basis_functions, integrals, coordinates, weights));
+      } catch (const std::runtime_error &) {
+        return {};
+      }
+      // The step is halved until the points stay ordered inside the patch and the residual decreases.
+      bool accepted = false;
+      for (double damping = 1; damping > 1e-4 && !accepted; damping /= 2) {
+        std::vector<double> new_coordinates = coordinates;
+        std::vector<double> new_weights = weights;
+        column = 0;
+        for (int k = 0; k < num_pnts; ++k) {
+          new_weights[k] -= damping * step(column++);
+          if (!(fix_first && k == 0)) new_coordinates[k] -= damping * step(column++);
+        }
+        if (!AreOrderedInPatch(target, new_coordinates)) continue;
+        double new_residual_norm = GetResidualNorm(basis_functions, integrals, new_coordinates, new_weights);
+        if (new_residual_norm < residual_norm) {
+          coordinates = new_coordinates;
+          weights = new_weights;
+          residual_norm = new_residual_norm;
+          accepted = true;
+        }
+      }
+      if (!accepted) return {};
+    }
+    if (residual_norm > tolerance) return {};
+    std::vector<std::pair<double, double>> points;
+    for (int k = 0; k < num_pnts; ++k) {
+      if (weights[k] <= 0) return {};
+      points.emplace_back(coordinates[k], weights[k]);
+    }
+    return points;
+  }
+
+  // The knot vector of degree 2p of the products of two basis functions between lower and upper.
+  static baf::KnotVector GetTargetKnotVector(const baf::KnotVector &knot_vector, int degree, ParamCoord lower,
+                                             ParamCoord upper) {
+    std::vector<ParamCoord> knots;
+    for (int k = 0; k <= 2 * degree; ++k) {
+      knots.emplace_back(lower);
+    }
+    for (uint64_t i = 1; i < knot_vector.GetNumberOfKnots(); ++i) {
+      ParamCoord knot = knot_vector.GetKnot(i);
+      if (knot.get() <= knot_vector.GetKnot(i - 1).get() || knot.get() <= lower.get() || knot.get() >= upper.get()) {
+        continue;
+      }
+      int multiplicity = std::min(degree + static_cast<int>(knot_vector.GetMultiplicity(knot)) + 1, 2 * degree + 1);
+      for (int k = 0; k < multiplicity; ++k) {
+        knots.emplace_back(knot);
+      }
+    }
+    for (int k = 0; k <= 2 * degree; ++k) {
+      knots.emplace_back(upper);
+    }
+    return baf::KnotVector(knots);
+  }
+
+  // Returns sum_k w_k B_i(x_k) - int B_i.
+  static arma::dvec GetResidual(const std::vector<std::unique_ptr<baf::BasisFunction>> &basis_functions,
+                                const arma::dvec &integrals, const std::vector<double> &coordinates,
+                                const std::vector<double> &weights) {
+    arma::dvec residual = -integrals;
+    for (uint64_t i = 0; i < basis_functions.size(); ++i) {
+      for (uint64_t k = 0; k < coordinates.size(); ++k) {
+        residual(i) += weights[k] * basis_functions[i]->Evaluate(ParamCoord{coordinates[k]});
+      }
+    }
+    return residual;
+  }
+
+  static double GetResidualNorm(const std::vector<std::unique_ptr<baf::BasisFunction>> &basis_functions,
+                                const arma::dvec &integrals, const std::vector<double> &coordinates,
+                                const std::vector<double> &weights) {
+    arma::dvec residual = GetResidual(basis_functions, integrals, coordinates, weights);
+    double norm = 0;
+    for (uint64_t i = 0; i < residual.n_elem; ++i) {
+      norm = std::max(norm, std::abs(residual(i)));
+    }
+    return norm;
+  }
+
+  static bool AreOrderedInPatch(const baf::KnotVector &knot_vector, const std::vector<double> &coordinates) {
+    for (uint64_t k = 0; k < coordinates.size(); ++k) {
+      if (coordinates[k] < knot_vector.GetKnot(0).get() || coordinates[k] > knot_vector.GetLastKnot().get()) {
+        return false;
+      }
+      if (k > 0 && coordinates[k] <= coordinates[k - 1]) return false;
+    }
+    return true;
+  }
+
+  std::vector<std::pair<double, double>> GetGaussLegendrePoints(int direction, int number_of_points) const {
+    iga::itg::GaussLegendre rule(number_of_points);
+    std::vector<std::pair<double, double>> points;
+    for (const auto &element : elm_gen_->GetElementList(direction)) {
+      double lower = element.GetLowerBound().get();
+      double upper = element.GetUpperBound().get();
+      for (const auto &point : rule.GetIntegrationPoints()) {
+        points.emplace_back(((upper - lower) * point.GetCoordinate() + upper + lower) / 2.0,
+                            (upper - lower) * point.GetWeight() / 2.0);
+      }
+    }
+    return points;
+  }
+
+  // Maps each point to the reference interval of the element containing it.
+  std::vector<iga::itg::IntegrationRule> SplitIntoElementRules(
+      int direction, const std::vector<std::pair<double, double>> &points) const {
+    std::vector<iga::elm::Element> elements = elm_gen_->GetElementList(direction);
+    std::vector<std::vector<iga::itg::IntegrationPoint>> element_points(elements.size());
+    uint64_t e = 0;
+    for (const auto &point : points) {
+      while (e + 1 < elements.size() && point.first >= elements[e].GetUpperBound().get()) ++e;
+      double lower = elements[e].GetLowerBound().get();
+      double upper = elements[e].GetUpperBound().get();
+      element_points[e].emplace_back((2 * point.first - upper - lower) / (upper - lower),
+                                     2 * point.second / (upper - lower));
+    }
+    std::vector<iga::itg::IntegrationRule> rules;
+    for (const auto &element_point : element_points) {
+      rules.emplace_back(element_point);
+    }
+    return rules;
+  }
+
+  std::shared_ptr<iga::elm::ElementGenerator<DIM>> elm_gen_;
+  std::array<std::vector<iga::itg::IntegrationRule>, DIM> element_rules_;
+  std::array<int, DIM> num_itg_pnts_{};
+  std::array<bool, DIM> is_reduced_{};
+};
+}  // namespace iga
+
+#endif  // SRC_IGA_PATCH_QUADRATURE_H_
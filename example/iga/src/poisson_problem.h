@@ -16,60 +16,144 @@ You should have received a copy of the GNU Lesser General Public License along w
 #define SRC_IGA_POISSON_PROBLEM_H_
 
 #include <armadillo>
+#include <functional>
+#include <memory>
+#include <stdexcept>
 #include <vector>
 
-#include "bdf_handler.h"
+#include "bicgstab_solver.h"
+#include "cholesky_solver.h"
+#include "collocation_assembler.h"
+#include "conjugate_gradient_solver.h"
 #include "linear_equation_assembler.h"
+#include "linear_solver.h"
+#include "matrix_free_operator.h"
+#include "multigrid_preconditioner.h"
 #include "nurbs.h"
 #include "spline.h"
+#include "time_integrator.h"
 
 namespace iga {
 template<int DIM>
 class PoissonProblem {
  public:
-  PoissonProblem(std::shared_ptr<spl::NURBS<DIM>> spl, const iga::itg::IntegrationRule &rule) :
-  spline_(std::move(spl)), num_cp_(spline_->GetNumberOfControlPoints()), rule_(rule) {
+  // The system is assembled as a sparse matrix. If no solver is given, the steady state problem is solved with the
+  // Jacobi preconditioned conjugate gradient method, whose memory grows only linearly with the number of degrees of
+  // freedom, and the left side of transient problems, which is solved once per time step, is factorized once with a
+  // sparse Cholesky factorization.
+  PoissonProblem(std::shared_ptr<spl::NURBS<DIM>> spl, const iga::itg::IntegrationRule &rule,
+                 std::shared_ptr<iga::slv::LinearSolver> solver = nullptr) :
+  spline_(std::move(spl)), num_cp_(spline_->GetNumberOfControlPoints()), rule_(rule), solver_(std::move(solver)) {
     linear_equation_assembler_ = std::make_shared<iga::LinearEquationAssembler<DIM>>(spline_);
     elm_itg_calc_ = std::make_shared<iga::ElementIntegralCalculator<DIM>>(spline_);
-    matA_ = std::make_shared<arma::dmat>(num_cp_, num_cp_, arma::fill::zeros);
-    vecB_ = std::make_shared<arma::dvec>(num_cp_, arma::fill::zeros);
     srcCp_ = std::make_shared<arma::dvec>(num_cp_, arma::fill::ones);
   }
 
   arma::dvec GetSteadyStateSolution() {
-    linear_equation_assembler_->GetLeftSide(rule_, matA_, *elm_itg_calc_);
-    linear_equation_assembler_->GetRightSide(rule_, vecB_, *elm_itg_calc_, srcCp_);
-    linear_equation_assembler_->SetZeroBC(matA_, vecB_);
-    return arma::solve(*matA_, *vecB_);
+    auto matA = std::make_shared<arma::sp_mat>(num_cp_, num_cp_);
+    auto vecB = std::make_shared<arma::dvec>(num_cp_, arma::fill::zeros);
+    linear_equation_assembler_->GetSystem(rule_, matA, vecB, *elm_itg_calc_, srcCp_);
+    linear_equation_assembler_->SetZeroBC(matA, vecB);
+    std::shared_ptr<iga::slv::LinearSolver> solver = solver_;
+    if (solver == nullptr) solver = std::make_shared<iga::slv::ConjugateGradientSolver>();
+    solver->SetLeftSide(matA);
+    arma::dvec solution = solver->Solve(*vecB);
+    solver->ThrowIfNotConverged();
+    return solution;
   }
 
+  // Solves the steady state problem without assembling the stiffness matrix. The Laplace operator is applied element by
+  // element with sum factorization and the system is solved with the Jacobi preconditioned conjugate gradient method,
+  // so that the memory needed grows only linearly with the number of degrees of freedom.
+  arma::dvec GetMatrixFreeSteadyStateSolution(double tolerance = 1e-10, int max_iterations = 10000) {
+    iga::MatrixFreeOperator<DIM> laplace_operator(spline_, rule_);
+    std::vector<int> boundary_indices = linear_equation_assembler_->GetBoundaryIndices();
+    laplace_operator.SetDirichletBoundary(boundary_indices);
+    auto vecB = std::make_shared<arma::dvec>(num_cp_, arma::fill::zeros);
+    linear_equation_assembler_->GetRightSide(rule_, vecB, *elm_itg_calc_, srcCp_);
+    for (int index : boundary_indices) {
+      (*vecB)(static_cast<uint64_t>(index)) = 0;
+    }
+    iga::slv::ConjugateGradientSolver solver(nullptr, tolerance, max_iterations);
+    arma::dvec solution = solver.Solve(laplace_operator, *vecB, arma::dvec(vecB->n_elem, arma::fill::zeros));
+    solver.ThrowIfNotConverged();
+    return solution;
+  }
+
+  // Solves the steady state problem with the conjugate gradient method preconditioned by a multigrid V-cycle on the
+  // knot insertion hierarchy of the spline. The number of iterations hardly grows under refinement, so that the
+  // solution time is roughly linear in the number of degrees of freedom.
+  arma::dvec GetMultigridSteadyStateSolution(double tolerance = 1e-10, int max_iterations = 1000) {
+    auto matA = std::make_shared<arma::sp_mat>(num_cp_, num_cp_);
+    auto vecB = std::make_shared<arma::dvec>(num_cp_, arma::fill::zeros);
+    linear_equation_assembler_->GetSystem(rule_, matA, vecB, *elm_itg_calc_, srcCp_);
+    linear_equation_assembler_->SetZeroBC(matA, vecB);
+    iga::slv::ConjugateGradientSolver solver(std::make_shared<iga::MultigridPreconditioner<DIM>>(spline_), tolerance,
+                                             max_iterations);
+    solver.SetLeftSide(matA);
+    arma::dvec solution = solver.Solve(*vecB);
+    solver.ThrowIfNotConverged();
+    return solution;
+  }
+
+  // Solves the steady state problem by collocation at the Greville abscissae instead of the Galerkin method. The
+  // assembly needs no quadrature, but the system is not symmetric and is solved with the Jacobi preconditioned BiCGStab
+  // method. It is less accurate than the Galerkin solution on the same mesh.
+  arma::dvec GetCollocationSteadyStateSolution(double tolerance = 1e-10, int max_iterations = 10000,
+                                               const std::shared_ptr<arma::dvec> &Dirichlet = nullptr) {
+    iga::CollocationAssembler<DIM> collocation_assembler(spline_);
+    auto matA = std::make_shared<arma::sp_mat>(num_cp_, num_cp_);
+    auto vecB = std::make_shared<arma::dvec>(num_cp_, arma::fill::zeros);
+    collocation_assembler.GetLeftSide(matA);
+    collocation_assembler.GetRightSide(vecB, srcCp_, Dirichlet);
+    iga::slv::BiCGStabSolver solver(nullptr, tolerance, max_iterations);
+    solver.SetLeftSide(matA);
+    arma::dvec solution = solver.Solve(*vecB);
+    solver.ThrowIfNotConverged();
+    return solution;
+  }
+
+  // Receives the time step, the time and the solution of every reported time step.
+  using SolutionObserver = std::function<void(int, double, const arma::dvec &)>;
+
   std::vector<std::shared_ptr<arma::dvec>> GetUnsteadyStateSolution(double dt, double tEnd,
-      std::shared_ptr<arma::dvec> Dirichlet = nullptr) {
-    iga::BDFHandler bdf_handler(spline_, rule_);
+      std::shared_ptr<arma::dvec> Dirichlet = nullptr, int bdf_order = 1) {
     std::vector<std::shared_ptr<arma::dvec>> solutions;
+    StreamUnsteadyStateSolution(dt, tEnd, [&solutions](int, double, const arma::dvec &solution) {
+      solutions.emplace_back(std::make_shared<arma::dvec>(solution));
+    }, 1, std::move(Dirichlet), bdf_order);
+    return solutions;
+  }
+
+  // Passes the initial solution, every output_stride-th solution and the final solution to the observer as soon as
+  // they are computed instead of storing them, so that the memory needed does not depend on the number of time steps.
+  void StreamUnsteadyStateSolution(double dt, double tEnd, const SolutionObserver &observer, int output_stride = 1,
+                                   std::shared_ptr<arma::dvec> Dirichlet = nullptr, int bdf_order = 1) {
+    if (output_stride < 1) {
+      throw std::runtime_error("The output stride has to be positive.");
+    }
     auto timeSteps = static_cast<int>(tEnd / dt);
-    std::shared_ptr<arma::dvec> uprev = std::make_shared<arma::dvec>(static_cast<uint64_t>(num_cp_), arma::fill::zeros);
-    solutions.emplace_back(uprev);
-    linear_equation_assembler_->GetLeftSide(rule_, matA_, *elm_itg_calc_);
-    linear_equation_assembler_->GetRightSide(rule_, vecB_, *elm_itg_calc_, srcCp_);
-    auto left = bdf_handler.GetBDF1LeftSide(matA_, dt);
+    auto matA = std::make_shared<arma::sp_mat>(num_cp_, num_cp_);
+    auto vecB = std::make_shared<arma::dvec>(num_cp_, arma::fill::zeros);
+    linear_equation_assembler_->GetSystem(rule_, matA, vecB, *elm_itg_calc_, srcCp_);
+    std::shared_ptr<iga::slv::LinearSolver> solver = solver_;
+    if (solver == nullptr) solver = std::make_shared<iga::slv::CholeskySolver>();
+    iga::TimeIntegrator<DIM> time_integrator(spline_, rule_, linear_equation_assembler_, *elm_itg_calc_, solver, matA,
+                                             vecB, dt, Dirichlet, bdf_order);
+    observer(0, 0.0, arma::dvec(static_cast<uint64_t>(num_cp_), arma::fill::zeros));
     for (int i = 1; i <= timeSteps; ++i) {
-      auto right = bdf_handler.GetBDF1RightSide(vecB_, uprev, dt);
-      linear_equation_assembler_->SetDirichletBC(left, right, Dirichlet);
-      uprev = std::make_shared<arma::dvec>(arma::solve(*left, *right));
-      solutions.emplace_back(uprev);
+      const arma::dvec &solution = time_integrator.Step();
+      if (i % output_stride == 0 || i == timeSteps) observer(i, i * dt, solution);
     }
-    return solutions;
   }
 
  private:
   std::shared_ptr<spl::NURBS<DIM>> spline_;
   int num_cp_;
   iga::itg::IntegrationRule rule_;
+  std::shared_ptr<iga::slv::LinearSolver> solver_;
   std::shared_ptr<iga::LinearEquationAssembler<DIM>> linear_equation_assembler_;
   std::shared_ptr<iga::ElementIntegralCalculator<DIM>> elm_itg_calc_;
-  std::shared_ptr<arma::dmat> matA_;
-  std::shared_ptr<arma::dvec> vecB_;
   std::shared_ptr<arma::dvec> srcCp_;
 };
 }  // namespace iga
@@ -0,0 +1,131 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_RESIDUAL_ERROR_ESTIMATOR_H_
+#define SRC_IGA_RESIDUAL_ERROR_ESTIMATOR_H_
+
+#include <math.h>
+#include <armadillo>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "collocation_assembler.h"
+#include "integration_rule.h"
+#include "multi_index_handler.h"
+#include "parallel_operations.h"
+#include "truncated_hierarchical_space.h"
+
+namespace iga {
+// Residual based estimator eta_K^2 = h_K^2 * ||f + laplace(u_h)||^2_{L2(K)} of the energy error of the Poisson
+// problem with a constant source on a truncated hierarchical space. It needs C^1 continuous basis functions.
+template<int DIM>
+class ResidualErrorEstimator {
+ public:
+  ResidualErrorEstimator(const iga::TruncatedHierarchicalSpace<DIM> &space, const iga::itg::IntegrationRule &rule,
+                         double source = 1.0, int number_of_threads = 0)
+      : source_(source), number_of_threads_(number_of_threads) {
+    iga::CollocationAssembler<DIM>::ThrowIfNotC1Continuous(*space.GetSpline());
+    elements_.resize(static_cast<uint64_t>(space.GetNumberOfElements()));
+    util::ParallelOperations::ForEachRange(static_cast<int>(elements_.size()), number_of_threads_,
+                                           [&](int first, int last) {
+      for (int e = first; e < last; ++e) {
+        elements_[e] = GetElementData(space, rule, e);
+      }
+    });
+  }
+
+  // Returns the squared indicators eta_K^2 of the active elements.
+  std::vector<double> GetSquaredIndicators(const arma::dvec &solution) const {
+    std::vector<double> indicators(elements_.size());
+    util::ParallelOperations::ForEachRange(static_cast<int>(elements_.size()), number_of_threads_,
+                                           [&](int first, int last) {
+      for (int e = first; e < last; ++e) {
+        const ElementData &element = elements_[e];
+        arma::dvec local(element.global_indices.size());
+        for (uint64_t j = 0; j < local.n_elem; ++j) {
+          local(j) = solution(element.global_indices[j]);
+        }
+        arma::dvec residual = element.laplacians * local + source_;
+        indicators[e] = pow(element.size, 2) * arma::dot(element.weights, residual % residual);
+      }
+    });
+    return indicators;
+  }
+
+  // Returns the global estimate (sum_K eta_K^2)^(1/2).
+  double GetEstimate(const arma::dvec &solution) const {
+    double sum = 0;
+    for (double indicator : GetSquaredIndicators(solution)) {
+      sum += indicator;
+    }
+    return sqrt(sum);
+  }
+
+ private:
+  struct ElementData {
+    std::vector<arma::uword> global_indices;
+    // Physical laplacians of the active functions (columns) at the integration points (rows).
+    arma::dmat laplacians;
+    // Integration weights including the Jacobian determinants of the parametric and the geometry mapping.
+    arma::dvec weights;
+    double size;
+  };
+
+  static ElementData GetElementData(const iga::TruncatedHierarchicalSpace<DIM> &space,
+                                    const iga::itg::IntegrationRule &rule, int e) {
+    ElementData element;
+    element.global_indices = space.GetGlobalIndices(e);
+    auto basis = space.GetElementBasis(e, rule);
+    util::MultiIndexHandler<DIM> point_handler(GetFilledArray(rule.GetNumberOfIntegrationPoints()));
+    auto num_points = static_cast<uint64_t>(point_handler.Get1DLength());
+    std::vector<iga::itg::IntegrationPoint> points = rule.GetIntegrationPoints();
+    arma::dmat level_laplacians(num_points, basis.global_indices.size());
+    element.weights = arma::dvec(num_points);
+    for (uint64_t q = 0; q < num_points; ++q, ++point_handler) {
+      std::array<std::array<std::vector<double>, 3>, DIM> univariate;
+      double weight = 1;
+      for (int d = 0; d < DIM; ++d) {
+        double half_length = (basis.bounds[d][1] - basis.bounds[d][0]) / 2;
+        ParamCoord param_coord{basis.bounds[d][0] + half_length * (points[point_handler[d]].GetCoordinate() + 1)};
+        weight *= half_length * points[point_handler[d]].GetWeight();
+        for (int derivative = 0; derivative < 3; ++derivative) {
+          univariate[d][derivative] = space.EvaluateLevelBasisFunctions(e, d, param_coord, derivative);
+        }
+      }
+      auto point = iga::CollocationAssembler<DIM>::EvaluatePoint(univariate, basis.global_indices, basis.weights,
+                                                                  basis.control_points);
+      element.weights(q) = weight * std::abs(point.jacobian_determinant);
+      for (uint64_t j = 0; j < point.laplacians.size(); ++j) {
+        level_laplacians(q, j) = point.laplacians[j];
+      }
+    }
+    element.laplacians = level_laplacians * space.GetExtractionMatrix(e).t();
+    element.size = pow(arma::accu(element.weights), 1.0 / DIM);
+    return element;
+  }
+
+  static std::array<int, DIM> GetFilledArray(int value) {
+    std::array<int, DIM> array;
+    array.fill(value);
+    return array;
+  }
+
+  double source_;
+  int number_of_threads_;
+  std::vector<ElementData> elements_;
+};
+}  // namespace iga
+
+#endif  // SRC_IGA_RESIDUAL_ERROR_ESTIMATOR_H_
@@ -23,6 +23,7 @@ You should have received a copy of the GNU Lesser General Public License along w
 #include "multi_index_handler.h"
 #include "nurbs.h"
 #include "solution_spline.h"
+#include "string_operations.h"
 #include "vtk_writer.h"
 
 namespace iga {
@@ -60,9 +61,10 @@ class SolutionVTKWriter {
     std::ofstream newFile;
     newFile.open(filename, std::ofstream::out | std::ofstream::app);
     if (newFile.is_open()) {
-      newFile << "\nPOINT_DATA " << point_data.size() << "\nSCALARS solution float 1\nLOOKUP_TABLE default\n";
+      newFile << "\nPOINT_DATA " << point_data.size() << "\nSCALARS solution double 1\nLOOKUP_TABLE default\n";
       for (auto &p : point_data) {
-        newFile << p << "\n";
+        util::StringOperations::WriteShortest(&newFile, p);
+        newFile << "\n";
       }
       newFile.close();
     }
@@ -0,0 +1,243 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_SOLUTION_XDMF_TIME_SERIES_WRITER_H_
+#define SRC_IGA_SOLUTION_XDMF_TIME_SERIES_WRITER_H_
+
+#include <armadillo>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "multi_index_handler.h"
+#include "nurbs.h"
+#include "string_operations.h"
+
+namespace iga {
+// Writes the solutions of a transient problem as an XDMF time series, which VTK based viewers such as ParaView read.
+// The geometry mesh is evaluated and written once to a binary grid file that all steps of the xmf file reference, and
+// each step only writes its point data to a binary file. The values of all basis functions at the output points are
+// stored as a sparse matrix, so that the point data of each step is a single sparse matrix-vector product.
+template<int DIM>
+class SolutionXDMFTimeSeriesWriter {
+ public:
+  SolutionXDMFTimeSeriesWriter(const std::shared_ptr<spl::NURBS<DIM>> &spl, const std::array<int, DIM> &scattering,
+                               std::string basename) : basename_(std::move(basename)) {
+    std::array<int, DIM> num_pnts{};
+    num_cells_ = 1;
+    for (int i = 0; i < DIM; ++i) {
+      if (scattering[i] < 1) throw std::runtime_error("The scattering has to be positive in each direction.");
+      num_pnts[i] = scattering[i] + 1;
+      num_cells_ *= scattering[i];
+    }
+    SetUpBasisFunctionValues(spl, scattering, num_pnts);
+    WriteGrid(spl, scattering, num_pnts);
+    index_.open(basename_ + ".xmf");
+    if (!index_.is_open()) throw std::runtime_error("The file " + basename_ + ".xmf could not be opened.");
+    index_ << "<?xml version=\"1.0\"?>\n<Xdmf Version=\"2.0\">\n<Domain>\n" << mesh_
+           << "<Grid Name=\"solution\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+  }
+
+  SolutionXDMFTimeSeriesWriter(const SolutionXDMFTimeSeriesWriter &) = delete;
+  SolutionXDMFTimeSeriesWriter &operator=(const SolutionXDMFTimeSeriesWriter &) = delete;
+
+  ~SolutionXDMFTimeSeriesWriter() {
+    Finish();
+  }
+
+  // The signature matches iga::PoissonProblem<DIM>::SolutionObserver.
+  void WriteStep(int step, double time, const arma::dvec &solution) {
+    if (!index_.is_open()) throw std::runtime_error("The time series has already been finished.");
+    if (solution.n_elem != basis_function_values_.n_cols) {
+      throw std::runtime_error("The solution does not match the spline of the time series.");
+    }
+    std::string filename = basename_ + "_" + std::to_string(step) + ".bin";
+    arma::dvec point_data = GetPointData(solution);
+    std::ofstream file = OpenBinaryFile(filename);
+    file.write(reinterpret_cast<const char *>(point_data.memptr()),
+               static_cast<std::streamsize>(point_data.n_elem * sizeof(double)));
+    file.close();
+    index_ << "<Grid Name=\"step_" << step << "\" GridType=\"Uniform\">\n<Time Value=\"";
+    util::StringOperations::WriteShortest(&index_, time);
+    index_ << "\"/>\n<Topology Reference=\"/Xdmf/Domain/Topology[1]\"/>\n"
+           << "<Geometry Reference=\"/Xdmf/Domain/Geometry[1]\"/>\n"
+           << "<Attribute Name=\"solution\" AttributeType=\"Scalar\" Center=\"Node\">\n<DataItem Dimensions=\""
+           << point_data.n_elem << "\" NumberType=\"Float\" Precision=\"8\" Format=\"Binary\">"
+           << GetFilename(filename) << "</DataItem>\n</Attribute>\n</Grid>\n" << std::flush;
+  }
+
+  // Completes and closes the xmf file. Further steps cannot be written afterwards.
+  void Finish() {
+    if (!index_.is_open()) return;
+    index_ << "</Grid>\n</Domain>\n</Xdmf>\n";
+    index_.close();
+  }
+
+  arma::dvec GetPointData(const arma::dvec &solution) const {
+    return basis_function_values_ * solution;
+  }
+
+ private:
+  void SetUpBasisFunctionValues(const std::shared_ptr<spl::NURBS<DIM>> &spl, const std::array<int, DIM> &scattering,
+                                const std::array<int, DIM> &num_pnts) {
+    std::array<int, DIM> points_per_direction = spl->GetPointsPerDirection();
+    std::array<int, DIM> num_baf{};
+    for (int i = 0; i < DIM; ++i) {
+      num_baf[i] = spl->GetDegree(i).get() + 1;
+    }
+    std::vector<arma::uword> rows;
+    std::vector<arma::uword> cols;
+    std::vector<double> values;
+    util::MultiIndexHandler<DIM> point_handler(num_pnts);
+    for (int point = 0; point < point_handler.Get1DLength(); ++point, ++point_handler) {
+      std::array<ParamCoord, DIM> param_coords = GetParamCoords(spl, scattering, point_handler.GetIndices());
+      std::array<std::vector<double>, DIM> basis_functions{};
+      std::array<int, DIM> first_non_zero{};
+      for (int i = 0; i < DIM; ++i) {
+        basis_functions[i] = spl->EvaluateAllNonZeroBasisFunctions(i, param_coords[i]);
+        first_non_zero[i] = spl->GetKnotVector(i)->GetKnotSpan(param_coords[i]).get() - spl->GetDegree(i).get();
+      }
+      double weight_sum = 0;
+      uint64_t first_entry = values.size();
+      util::MultiIndexHandler<DIM> baf_handler(num_baf);
+      for (int j = 0; j < baf_handler.Get1DLength(); ++j, ++baf_handler) {
+        std::array<int, DIM> indices{};
+        double value = 1;
+        int global_index = 0;
+        for (int i = DIM - 1; i >= 0; --i) {
+          indices[i] = first_non_zero[i] + baf_handler[i];
+          value *= basis_functions[i][baf_handler[i]];
+          global_index = global_index * points_per_direction[i] + indices[i];
+        }
+        value *= spl->GetWeight(indices);
+        weight_sum += value;
+        rows.emplace_back(static_cast<arma::uword>(point));
+        cols.emplace_back(static_cast<arma::uword>(global_index));
+        values.emplace_back(value);
+      }
+      for (uint64_t j = first_entry; j < values.size(); ++j) {
+        values[j] /= weight_sum;
+      }
+    }
+    arma::umat locations(2, rows.size());
+    for (uint64_t i = 0; i < rows.size(); ++i) {
+      locations(0, i) = rows[i];
+      locations(1, i) = cols[i];
+    }
+    basis_function_values_ = arma::sp_mat(true, locations, arma::dvec(values),
+                                          static_cast<arma::uword>(point_handler.Get1DLength()),
+                                          static_cast<arma::uword>(spl->GetNumberOfControlPoints()));
+  }
+
+  // Writes the coordinates of all points followed by the corners of all cells to the grid file. The points are the
+  // products of the basis function values with the control points.
+  void WriteGrid(const std::shared_ptr<spl::NURBS<DIM>> &spl, const std::array<int, DIM> &scattering,
+                 const std::array<int, DIM> &num_pnts) {
+    arma::dmat control_points(static_cast<arma::uword>(spl->GetNumberOfControlPoints()), 3, arma::fill::zeros);
+    util::MultiIndexHandler<DIM> cp_handler(spl->GetPointsPerDirection());
+    for (arma::uword j = 0; j < control_points.n_rows; ++j, ++cp_handler) {
+      for (int k = 0; k < std::min(spl->GetPointDim(), 3); ++k) {
+        control_points(j, static_cast<arma::uword>(k)) = spl->GetControlPoint(cp_handler.GetIndices(), k);
+      }
+    }
+    arma::dmat points = arma::trans(basis_function_values_ * control_points);
+    std::vector<std::array<int, DIM>> corners = GetCellCorners();
+    std::vector<int64_t> connectivity;
+    connectivity.reserve(static_cast<uint64_t>(num_cells_) * corners.size());
+    util::MultiIndexHandler<DIM> cell_handler(scattering);
+    for (int cell = 0; cell < num_cells_; ++cell, ++cell_handler) {
+      for (const auto &corner : corners) {
+        int64_t index = 0;
+        for (int i = DIM - 1; i >= 0; --i) {
+          index = index * num_pnts[i] + cell_handler[i] + corner[i];
+        }
+        connectivity.emplace_back(index);
+      }
+    }
+    std::string filename = basename_ + "_grid.bin";
+    std::ofstream file = OpenBinaryFile(filename);
+    file.write(reinterpret_cast<const char *>(points.memptr()),
+               static_cast<std::streamsize>(points.n_elem * sizeof(double)));
+    file.write(reinterpret_cast<const char *>(connectivity.data()),
+               static_cast<std::streamsize>(connectivity.size() * sizeof(int64_t)));
+    file.close();
+    std::ostringstream mesh;
+    mesh << "<Topology TopologyType=\"" << (DIM == 1 ? "Polyline\" NodesPerElement=\"2" :
+                                             (DIM == 2 ? "Quadrilateral" : "Hexahedron"))
+         << "\" NumberOfElements=\"" << num_cells_ << "\">\n<DataItem Dimensions=\"" << num_cells_ << " "
+         << corners.size() << "\" NumberType=\"Int\" Precision=\"8\" Format=\"Binary\" Seek=\""
+         << points.n_elem * sizeof(double) << "\">" << GetFilename(filename) << "</DataItem>\n</Topology>\n"
+         << "<Geometry GeometryType=\"XYZ\">\n<DataItem Dimensions=\"" << points.n_cols
+         << " 3\" NumberType=\"Float\" Precision=\"8\" Format=\"Binary\">" << GetFilename(filename)
+         << "</DataItem>\n</Geometry>\n";
+    mesh_ = mesh.str();
+  }
+
+  // Returns the corners of a cell relative to its first point in the order of the xdmf polyline, quadrilateral and
+  // hexahedron, which is the same as in vtk.
+  std::vector<std::array<int, DIM>> GetCellCorners() const {
+    std::vector<std::array<int, DIM>> corners;
+    for (int k = 0; k < (DIM == 3 ? 2 : 1); ++k) {
+      for (int j = 0; j < (DIM >= 2 ? 2 : 1); ++j) {
+        for (int i = 0; i < 2; ++i) {
+          std::array<int, DIM> corner{};
+          corner[0] = j == 1 ? 1 - i : i;
+          if (DIM >= 2) corner[1 % DIM] = j;
+          if (DIM == 3) corner[2 % DIM] = k;
+          corners.emplace_back(corner);
+        }
+      }
+    }
+    return corners;
+  }
+
+  std::array<ParamCoord, DIM> GetParamCoords(const std::shared_ptr<spl::NURBS<DIM>> &spl,
+                                             const std::array<int, DIM> &scattering,
+                                             const std::array<int, DIM> &point_indices) const {
+    std::array<ParamCoord, DIM> param_coords{};
+    for (int i = 0; i < DIM; ++i) {
+      double first_knot = spl->GetKnotVector(i)->GetKnot(0).get();
+      double last_knot = spl->GetKnotVector(i)->GetLastKnot().get();
+      param_coords[i] = ParamCoord{first_knot + point_indices[i] * (last_knot - first_knot) / scattering[i]};
+    }
+    return param_coords;
+  }
+
+  // The data files contain the values in the native byte order, which is the default of xdmf.
+  static std::ofstream OpenBinaryFile(const std::string &filename) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) throw std::runtime_error("The file " + filename + " could not be opened.");
+    return file;
+  }
+
+  // The data files are referenced relative to the xmf file.
+  static std::string GetFilename(const std::string &path) {
+    return path.substr(path.find_last_of('/') + 1);
+  }
+
+  std::string basename_;
+  int num_cells_;
+  arma::sp_mat basis_function_values_;
+  std::string mesh_;
+  std::ofstream index_;
+};
+}  // namespace iga
+
+#endif  // SRC_IGA_SOLUTION_XDMF_TIME_SERIES_WRITER_H_
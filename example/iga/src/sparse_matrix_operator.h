@@ -0,0 +1,54 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_SLV_SPARSE_MATRIX_OPERATOR_H_
+#define SRC_IGA_SLV_SPARSE_MATRIX_OPERATOR_H_
+
+#include <armadillo>
+#include <memory>
+#include <utility>
+
+#include "linear_operator.h"
+
+namespace iga {
+namespace slv {
+// Presents an assembled sparse matrix as a linear operator, so that algorithms written for operators, like the
+// smoothers of the multigrid preconditioner, can be used for assembled and matrix-free left sides alike.
+class SparseMatrixOperator : public LinearOperator {
+ public:
+  explicit SparseMatrixOperator(std::shared_ptr<const arma::sp_mat> matA) : matA_(std::move(matA)) {}
+
+  arma::dvec Apply(const arma::dvec &vector) const override {
+    return (*matA_) * vector;
+  }
+
+  arma::dvec GetDiagonal() const override {
+    arma::dvec diagonal((*matA_).n_rows, arma::fill::zeros);
+    for (arma::sp_mat::const_iterator it = (*matA_).begin(); it != (*matA_).end(); ++it) {
+      if (it.row() == it.col()) diagonal(it.row()) = *it;
+    }
+    return diagonal;
+  }
+
+  const arma::sp_mat &GetMatrix() const {
+    return *matA_;
+  }
+
+ private:
+  std::shared_ptr<const arma::sp_mat> matA_;
+};
+}  // namespace slv
+}  // namespace iga
+
+#endif  // SRC_IGA_SLV_SPARSE_MATRIX_OPERATOR_H_
@@ -0,0 +1,138 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_SUM_FACTORIZATION_H_
+#define SRC_IGA_SUM_FACTORIZATION_H_
+
+#include <armadillo>
+#include <array>
+
+namespace iga {
+// Quadrature over tensor product elements one parametric direction after another. The univariate basis functions of
+// each direction are given as matrices with one row per integration point and one column per basis function. The
+// integration points and the basis functions of the element are numbered with the first parametric direction running
+// fastest.
+template<int DIM>
+class SumFactorization {
+ public:
+  // Returns the matrix sum_q c(q) * test_j(q) * trial_k(q) for the tensor product functions test_j and trial_k. The
+  // cost is O(n_q * (p+1)^(2*DIM)) instead of O(n_q^DIM * (p+1)^(2*DIM)).
+  static arma::dmat Integrate(const std::array<arma::dmat, DIM> &test, const std::array<arma::dmat, DIM> &trial,
+                              const arma::dvec &coefficients) {
+    // The tensor is stored as [(j_0, k_0), ..., (j_{d-1}, k_{d-1}), q_d, ..., q_{DIM-1}] with the leftmost index
+    // running fastest. Each pass contracts the integration point index of one direction.
+    arma::dvec tensor = coefficients;
+    uint64_t num_pairs = 1;
+    for (int d = 0; d < DIM; ++d) {
+      uint64_t num_pnts = test[d].n_rows;
+      uint64_t num_test = test[d].n_cols;
+      uint64_t num_trial = trial[d].n_cols;
+      uint64_t num_rest = tensor.n_elem / (num_pairs * num_pnts);
+      arma::dvec contracted(num_pairs * num_test * num_trial * num_rest, arma::fill::zeros);
+      for (uint64_t r = 0; r < num_rest; ++r) {
+        for (uint64_t q = 0; q < num_pnts; ++q) {
+          const double *source = tensor.memptr() + num_pairs * (q + num_pnts * r);
+          for (uint64_t k = 0; k < num_trial; ++k) {
+            for (uint64_t j = 0; j < num_test; ++j) {
+              double factor = test[d](q, j) * trial[d](q, k);
+              if (factor == 0) continue;
+              double *target = contracted.memptr() + num_pairs * (j + num_test * (k + num_trial * r));
+              for (uint64_t m = 0; m < num_pairs; ++m) {
+                target[m] += factor * source[m];
+              }
+            }
+          }
+        }
+      }
+      num_pairs *= num_test * num_trial;
+      tensor = contracted;
+    }
+    return Unfold(test, trial, tensor);
+  }
+
+  // Applies the univariate matrices direction by direction to the tensor [i_0, ..., i_{DIM-1}], i.e. returns
+  // sum_i M_0(k_0, i_0) * ... * M_{DIM-1}(k_{DIM-1}, i_{DIM-1}) * tensor(i). With the basis function matrices this
+  // evaluates a function given by its local coefficients at the integration points, with their transposes it
+  // integrates values at the integration points against the basis functions.
+  static arma::dvec Apply(const std::array<arma::dmat, DIM> &matrices, const arma::dvec &tensor) {
+    std::array<const arma::dmat *, DIM> pointers{};
+    for (int d = 0; d < DIM; ++d) {
+      pointers[d] = &matrices[d];
+    }
+    return Apply(pointers, tensor, false);
+  }
+
+  // Applies the univariate matrices or, if transposed is true, their transposes without copying them, so that shared
+  // tables of basis functions can be used for evaluation and integration alike.
+  static arma::dvec Apply(const std::array<const arma::dmat *, DIM> &matrices, const arma::dvec &tensor,
+                          bool transposed) {
+    arma::dvec current = tensor;
+    uint64_t num_done = 1;
+    for (int d = 0; d < DIM; ++d) {
+      const arma::dmat &matrix = *matrices[d];
+      uint64_t num_rows = transposed ? matrix.n_cols : matrix.n_rows;
+      uint64_t num_cols = transposed ? matrix.n_rows : matrix.n_cols;
+      uint64_t num_rest = current.n_elem / (num_done * num_cols);
+      arma::dvec next(num_done * num_rows * num_rest, arma::fill::zeros);
+      for (uint64_t r = 0; r < num_rest; ++r) {
+        for (uint64_t i = 0; i < num_cols; ++i) {
+          const double *source = current.memptr() + num_done * (i + num_cols * r);
+          for (uint64_t k = 0; k < num_rows; ++k) {
+            double factor = transposed ? matrix(i, k) : matrix(k, i);
+            if (factor == 0) continue;
+            double *target = next.memptr() + num_done * (k + num_rows * r);
+            for (uint64_t m = 0; m < num_done; ++m) {
+              target[m] += factor * source[m];
+            }
+          }
+        }
+      }
+      num_done *= num_rows;
+      current = next;
+    }
+    return current;
+  }
+
+ private:
+  // Reorders the tensor [(j_0, k_0), ..., (j_{DIM-1}, k_{DIM-1})] into the matrix (j_0 + n_0 * j_1 + ..., k_0 + ...).
+  static arma::dmat Unfold(const std::array<arma::dmat, DIM> &test, const std::array<arma::dmat, DIM> &trial,
+                           const arma::dvec &tensor) {
+    uint64_t num_test = 1;
+    uint64_t num_trial = 1;
+    for (int d = 0; d < DIM; ++d) {
+      num_test *= test[d].n_cols;
+      num_trial *= trial[d].n_cols;
+    }
+    arma::dmat matrix(num_test, num_trial);
+    for (uint64_t k = 0; k < num_trial; ++k) {
+      for (uint64_t j = 0; j < num_test; ++j) {
+        uint64_t index = 0;
+        uint64_t stride = 1;
+        uint64_t rest_j = j;
+        uint64_t rest_k = k;
+        for (int d = 0; d < DIM; ++d) {
+          index += stride * (rest_j % test[d].n_cols + test[d].n_cols * (rest_k % trial[d].n_cols));
+          stride *= test[d].n_cols * trial[d].n_cols;
+          rest_j /= test[d].n_cols;
+          rest_k /= trial[d].n_cols;
+        }
+        matrix(j, k) = tensor(index);
+      }
+    }
+    return matrix;
+  }
+};
+}  // namespace iga
+
+#endif  // SRC_IGA_SUM_FACTORIZATION_H_
@@ -0,0 +1,136 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_TIME_INTEGRATOR_H_
+#define SRC_IGA_TIME_INTEGRATOR_H_
+
+#include <algorithm>
+#include <armadillo>
+#include <memory>
+#include <vector>
+
+#include "bdf_handler.h"
+#include "element_integral_calculator.h"
+#include "integration_rule.h"
+#include "linear_equation_assembler.h"
+#include "linear_solver.h"
+#include "nurbs.h"
+
+namespace iga {
+// BDF time stepping of order one to three for a fixed time step size. The boundary conditions are applied and the
+// solver is set up for the left side only when the order changes, so that each time step consists of one sparse
+// matrix-vector product and one call of the solver. The previous solutions are kept in a ring buffer. The scheme starts
+// itself by raising the order by one in each of the first steps. For BDF3 the first step is computed by Richardson
+// extrapolation of BDF1, so that the startup does not reduce the order of convergence.
+template<int DIM>
+class TimeIntegrator {
+ public:
+  // The assembler and the element integral calculator are those of the caller, e.g. of iga::PoissonProblem<DIM>. The
+  // mass matrix is assembled with them and the boundary indices are taken from the assembler.
+  TimeIntegrator(const std::shared_ptr<spl::NURBS<DIM>> &spl, const iga::itg::IntegrationRule &rule,
+                 std::shared_ptr<iga::LinearEquationAssembler<DIM>> linear_equation_assembler,
+                 const iga::ElementIntegralCalculator<DIM> &elm_itg_calc,
+                 std::shared_ptr<iga::slv::LinearSolver> solver, std::shared_ptr<arma::sp_mat> matA,
+                 std::shared_ptr<arma::dvec> vecB, double dt, const std::shared_ptr<arma::dvec> &Dirichlet = nullptr,
+                 int order = 1) : solver_(std::move(solver)), matA_(std::move(matA)), vecB_(std::move(vecB)),
+                                  dt_(dt), order_(order),
+                                  linear_equation_assembler_(std::move(linear_equation_assembler)) {
+    iga::BDFHandler<DIM>::GetBDFCoefficients(order_);  // Throws for unsupported orders.
+    bdf_handler_ = std::make_shared<iga::BDFHandler<DIM>>(spl, rule, *linear_equation_assembler_, elm_itg_calc);
+    auto num_cp = static_cast<uint64_t>(spl->GetNumberOfControlPoints());
+    time_discr_mat_ = std::make_shared<arma::sp_mat>(*bdf_handler_->GetTimeDiscretizationMatrix() / dt);
+    interior_ = arma::dvec(num_cp, arma::fill::ones);
+    boundary_values_ = arma::dvec(num_cp, arma::fill::zeros);
+    const std::vector<int> &boundary_indices = linear_equation_assembler_->GetBoundaryIndices();
+    for (uint64_t i = 0; i < boundary_indices.size(); ++i) {
+      interior_(static_cast<uint64_t>(boundary_indices[i])) = 0;
+      if (Dirichlet != nullptr) boundary_values_(static_cast<uint64_t>(boundary_indices[i])) = (*Dirichlet)(i);
+    }
+    SetInitialSolution(arma::dvec(num_cp, arma::fill::zeros));
+  }
+
+  void SetInitialSolution(const arma::dvec &initial_solution) {
+    history_.assign(static_cast<uint64_t>(order_), initial_solution);
+    latest_ = 0;
+    num_steps_ = 0;
+  }
+
+  const arma::dvec &Step() {
+    arma::dvec solution;
+    if (order_ == 3 && num_steps_ == 0) {
+      // The first step is extrapolated from one full and two half BDF1 steps, so that its error is of third order.
+      arma::dvec full_step = SolveStep(1, 1.0, GetPreviousSolution(1), GetPreviousSolution(1));
+      arma::dvec half_step = SolveStep(1, 0.5, GetPreviousSolution(1), GetPreviousSolution(1));
+      half_step = SolveStep(1, 0.5, half_step, half_step);
+      solution = 2 * half_step - full_step;
+    } else {
+      int order = std::min(order_, num_steps_ + 1);
+      std::vector<double> coefficients = iga::BDFHandler<DIM>::GetBDFCoefficients(order);
+      arma::dvec history(interior_.n_elem, arma::fill::zeros);
+      for (int j = 1; j <= order; ++j) {
+        history -= coefficients[j] * GetPreviousSolution(j);
+      }
+      solution = SolveStep(order, 1.0, history, GetPreviousSolution(1));
+    }
+    latest_ = (latest_ + 1) % order_;
+    history_[latest_] = solution;
+    ++num_steps_;
+    return history_[latest_];
+  }
+
+ private:
+  // Solves one step of size step_fraction * dt. The history is the sum of the previous solutions weighted with the
+  // negated BDF coefficients.
+  arma::dvec SolveStep(int order, double step_fraction, const arma::dvec &history, const arma::dvec &initial_guess) {
+    if (order != left_side_order_ || step_fraction != left_side_step_fraction_) SetUpLeftSide(order, step_fraction);
+    arma::dvec right = (right_side_ + ((*time_discr_mat_) * history) / step_fraction) % interior_ + boundary_values_;
+    arma::dvec solution = solver_->Solve(right, initial_guess);
+    solver_->ThrowIfNotConverged();
+    return solution;
+  }
+
+  void SetUpLeftSide(int order, double step_fraction) {
+    auto left = bdf_handler_->GetBDFLeftSide(matA_, dt_ * step_fraction, order);
+    right_side_ = (*vecB_) - (*left) * boundary_values_;
+    linear_equation_assembler_->SetDirichletBCLeftSide(left);
+    solver_->SetLeftSide(left);
+    left_side_order_ = order;
+    left_side_step_fraction_ = step_fraction;
+  }
+
+  // Returns the solution of j time steps ago, j = 1 being the latest one.
+  const arma::dvec &GetPreviousSolution(int j) const {
+    return history_[(latest_ - (j - 1) + order_) % order_];
+  }
+
+  std::shared_ptr<iga::slv::LinearSolver> solver_;
+  std::shared_ptr<arma::sp_mat> matA_;
+  std::shared_ptr<arma::dvec> vecB_;
+  double dt_;
+  int order_;
+  std::shared_ptr<iga::LinearEquationAssembler<DIM>> linear_equation_assembler_;
+  std::shared_ptr<iga::BDFHandler<DIM>> bdf_handler_;
+  std::shared_ptr<arma::sp_mat> time_discr_mat_;
+  arma::dvec right_side_;
+  arma::dvec interior_;
+  arma::dvec boundary_values_;
+  std::vector<arma::dvec> history_;
+  int latest_ = 0;
+  int num_steps_ = 0;
+  int left_side_order_ = 0;
+  double left_side_step_fraction_ = 0;
+};
+}  // namespace iga
+
+#endif  // SRC_IGA_TIME_INTEGRATOR_H_
@@ -0,0 +1,477 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IGA_TRUNCATED_HIERARCHICAL_SPACE_H_
+#define SRC_IGA_TRUNCATED_HIERARCHICAL_SPACE_H_
+
+#include <armadillo>
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "element_integral_calculator.h"
+#include "integration_rule.h"
+#include "multi_index_handler.h"
+#include "nurbs.h"
+#include "parameter_space.h"
+
+namespace iga {
+// Truncated hierarchical NURBS space on a single patch (Giannelli, Juettler and Speleers, 2012). Each level halves the
+// non-zero knot spans of the previous one, and GetElementBasis provides the active functions of an element.
+template<int DIM>
+class TruncatedHierarchicalSpace {
+ public:
+  using ElementBasis = typename iga::ElementIntegralCalculator<DIM>::ElementBasis;
+
+  explicit TruncatedHierarchicalSpace(std::shared_ptr<spl::NURBS<DIM>> spl) : spline_(std::move(spl)) {
+    std::array<std::vector<double>, DIM> knots;
+    std::array<int, DIM> degrees;
+    for (int d = 0; d < DIM; ++d) {
+      std::shared_ptr<baf::KnotVector> knot_vector = spline_->GetKnotVector(d);
+      for (size_t k = 0; k < knot_vector->GetNumberOfKnots(); ++k) {
+        knots[d].emplace_back(knot_vector->GetKnot(k).get());
+      }
+      degrees[d] = spline_->GetDegree(d).get();
+    }
+    AddLevel(knots, degrees);
+    util::MultiIndexHandler<DIM> element_handler(levels_[0].num_elements);
+    for (int e = 0; e < element_handler.Get1DLength(); ++e) {
+      levels_[0].domain.insert(levels_[0].domain.end(), static_cast<uint64_t>(e));
+    }
+    Update();
+  }
+
+  // Replaces each of the given active elements by its 2^DIM children on the next level. All element and function
+  // numbers change afterwards.
+  void Refine(const std::vector<int> &elements) {
+    std::vector<std::pair<int, uint64_t>> marked;
+    for (int element : elements) {
+      marked.emplace_back(active_elements_.at(static_cast<uint64_t>(element)));
+    }
+    for (const auto &element : marked) {
+      auto level = static_cast<uint64_t>(element.first);
+      if (level + 1 == levels_.size()) AddLevel(GetRefinedKnots(levels_.back()), levels_.back().degrees);
+      levels_[level].refined.insert(element.second);
+      std::array<int, DIM> indices = GetIndices(levels_[level].num_elements, element.second);
+      util::MultiIndexHandler<DIM> child_handler(GetFilledArray(2));
+      for (int c = 0; c < child_handler.Get1DLength(); ++c, ++child_handler) {
+        std::array<int, DIM> child;
+        for (int d = 0; d < DIM; ++d) {
+          child[d] = 2 * indices[d] + child_handler[d];
+        }
+        levels_[level + 1].domain.insert(Get1DIndex(levels_[level + 1].num_elements, child));
+      }
+    }
+    Update();
+  }
+
+  int GetNumberOfLevels() const {
+    return static_cast<int>(levels_.size());
+  }
+
+  int GetNumberOfBasisFunctions() const {
+    return num_functions_;
+  }
+
+  int GetNumberOfElements() const {
+    return static_cast<int>(active_elements_.size());
+  }
+
+  int GetLevel(int element) const {
+    return active_elements_[element].first;
+  }
+
+  // Returns the spline of level 0, which defines the geometry on all levels.
+  std::shared_ptr<spl::NURBS<DIM>> GetSpline() const {
+    return spline_;
+  }
+
+  // Returns the indices of the active functions that do not vanish on the element.
+  const std::vector<arma::uword> &GetGlobalIndices(int element) const {
+    return element_indices_[element];
+  }
+
+  // Returns the coefficients of the active functions of GetGlobalIndices (rows) with respect to the NURBS basis
+  // functions of the level on the element in the order of GetElementBasis.
+  const arma::dmat &GetExtractionMatrix(int element) const {
+    return element_extraction_[element];
+  }
+
+  // Returns the lower and the upper parametric coordinate of the element in each direction.
+  std::array<std::array<double, 2>, DIM> GetElementBounds(int element) const {
+    const Level &level = levels_[active_elements_[element].first];
+    std::array<int, DIM> indices = GetIndices(level.num_elements, active_elements_[element].second);
+    std::array<std::array<double, 2>, DIM> bounds;
+    for (int d = 0; d < DIM; ++d) {
+      int span = level.element_span[d][indices[d]];
+      bounds[d] = {level.knots[d][span], level.knots[d][span + 1]};
+    }
+    return bounds;
+  }
+
+  // Returns the NURBS basis functions of the level of the element that do not vanish on it. Their global indices are
+  // their indices in the tensor product of the level, with the first parametric direction running fastest.
+  ElementBasis GetElementBasis(int element, const iga::itg::IntegrationRule &rule) const {
+    const Level &level = levels_[active_elements_[element].first];
+    std::array<int, DIM> indices = GetIndices(level.num_elements, active_elements_[element].second);
+    ElementBasis basis{element, std::vector<iga::itg::IntegrationRule>(DIM, rule), GetLevelIndices(level, indices), {},
+                       {}, GetElementBounds(element), {}, {}};
+    int cp_dim = spline_->GetPointDim();
+    basis.control_points = arma::dmat(static_cast<uint64_t>(cp_dim), basis.global_indices.size());
+    for (uint64_t j = 0; j < basis.global_indices.size(); ++j) {
+      const Function &function = level.functions.at(basis.global_indices[j]);
+      basis.weights.emplace_back(function.weight);
+      for (int i = 0; i < cp_dim; ++i) {
+        basis.control_points(i, j) = function.weighted_point[i] / function.weight;
+      }
+    }
+    std::vector<iga::itg::IntegrationPoint> points = rule.GetIntegrationPoints();
+    for (int d = 0; d < DIM; ++d) {
+      basis.values[d] = arma::dmat(points.size(), static_cast<uint64_t>(level.degrees[d] + 1));
+      basis.derivatives[d] = arma::dmat(points.size(), static_cast<uint64_t>(level.degrees[d] + 1));
+      for (uint64_t q = 0; q < points.size(); ++q) {
+        ParamCoord param_coord{(basis.bounds[d][0] * (1 - points[q].GetCoordinate()) +
+                                basis.bounds[d][1] * (1 + points[q].GetCoordinate())) / 2};
+        std::vector<double> values = EvaluateLevelBasisFunctions(element, d, param_coord, 0);
+        std::vector<double> derivatives = EvaluateLevelBasisFunctions(element, d, param_coord, 1);
+        for (uint64_t j = 0; j < values.size(); ++j) {
+          basis.values[d](q, j) = values[j];
+          basis.derivatives[d](q, j) = derivatives[j];
+        }
+      }
+    }
+    return basis;
+  }
+
+  // Returns the given derivative of the univariate B-splines of the level of the element in the direction that do not
+  // vanish at the parametric coordinate, which has to lie inside the element.
+  std::vector<double> EvaluateLevelBasisFunctions(int element, int direction, ParamCoord param_coord,
+                                                  int derivative) const {
+    const spl::ParameterSpace<DIM> &parameter_space = *levels_[active_elements_[element].first].parameter_space;
+    if (derivative == 0) return parameter_space.EvaluateAllNonZeroBasisFunctions(direction, param_coord);
+    return parameter_space.EvaluateAllNonZeroBasisFunctionDerivatives(direction, param_coord, derivative);
+  }
+
+  // Returns the active functions that do not vanish on the boundary of the patch in ascending order.
+  const std::vector<int> &GetBoundaryIndices() const {
+    return boundary_indices_;
+  }
+
+ private:
+  struct Function {
+    double weight;
+    std::vector<double> weighted_point;
+    std::vector<std::pair<int, double>> representation;
+  };
+
+  struct Level {
+    std::shared_ptr<spl::ParameterSpace<DIM>> parameter_space;
+    std::array<std::vector<double>, DIM> knots;
+    std::array<int, DIM> degrees;
+    std::array<int, DIM> num_elements;
+    std::array<int, DIM> num_functions;
+    std::array<std::vector<int>, DIM> element_span;
+    std::array<std::vector<int>, DIM> first_element;
+    std::array<std::vector<int>, DIM> last_element;
+    std::array<std::vector<std::vector<std::pair<int, double>>>, DIM> refinement_rows;
+    std::set<uint64_t> domain;
+    std::set<uint64_t> refined;
+    std::map<uint64_t, Function> functions;
+  };
+
+  void AddLevel(const std::array<std::vector<double>, DIM> &knots, const std::array<int, DIM> &degrees) {
+    Level level;
+    level.knots = knots;
+    level.degrees = degrees;
+    KnotVectors<DIM> knot_vectors;
+    std::array<Degree, DIM> level_degrees;
+    for (int d = 0; d < DIM; ++d) {
+      std::vector<ParamCoord> param_coords;
+      for (double knot : level.knots[d]) {
+        param_coords.emplace_back(ParamCoord{knot});
+      }
+      knot_vectors[d] = std::make_shared<baf::KnotVector>(param_coords);
+      level_degrees[d] = Degree{level.degrees[d]};
+      level.num_functions[d] = static_cast<int>(level.knots[d].size()) - level.degrees[d] - 1;
+      std::vector<int> element_of_span(level.knots[d].size(), -1);
+      for (int k = 0; k < level.num_functions[d]; ++k) {
+        if (level.knots[d][k] != level.knots[d][k + 1]) {
+          element_of_span[k] = static_cast<int>(level.element_span[d].size());
+          level.element_span[d].emplace_back(k);
+        }
+      }
+      level.num_elements[d] = static_cast<int>(level.element_span[d].size());
+      for (int j = 0; j < level.num_functions[d]; ++j) {
+        int first = level.num_elements[d], last = -1;
+        for (int k = j; k <= j + level.degrees[d]; ++k) {
+          if (element_of_span[k] < 0) continue;
+          first = std::min(first, element_of_span[k]);
+          last = std::max(last, element_of_span[k]);
+        }
+        level.first_element[d].emplace_back(first);
+        level.last_element[d].emplace_back(last);
+      }
+      if (!levels_.empty()) {
+        level.refinement_rows[d] = GetRefinementRows(levels_.back().knots[d], level.knots[d], level.degrees[d]);
+      }
+    }
+    level.parameter_space = std::make_shared<spl::ParameterSpace<DIM>>(knot_vectors, level_degrees);
+    levels_.emplace_back(level);
+  }
+
+  // Returns the knot vectors of the level with the midpoint of every non-zero knot span inserted.
+  static std::array<std::vector<double>, DIM> GetRefinedKnots(const Level &level) {
+    std::array<std::vector<double>, DIM> knots;
+    for (int d = 0; d < DIM; ++d) {
+      for (uint64_t k = 0; k < level.knots[d].size(); ++k) {
+        knots[d].emplace_back(level.knots[d][k]);
+        if (k + 1 < level.knots[d].size() && level.knots[d][k] != level.knots[d][k + 1]) {
+          knots[d].emplace_back((level.knots[d][k] + level.knots[d][k + 1]) / 2);
+        }
+      }
+    }
+    return knots;
+  }
+
+  // Rows of the knot insertion matrix T with the B-spline coefficients c_fine = T * c_coarse.
+  static std::vector<std::vector<std::pair<int, double>>> GetRefinementRows(std::vector<double> knots,
+      const std::vector<double> &fine_knots, int degree) {
+    std::vector<std::map<int, double>> rows(knots.size() - degree - 1);
+    for (uint64_t i = 0; i < rows.size(); ++i) {
+      rows[i][static_cast<int>(i)] = 1;
+    }
+    for (double knot : fine_knots) {
+      if (std::find(knots.begin(), knots.end(), knot) != knots.end()) continue;
+      auto span = static_cast<int>(std::upper_bound(knots.begin(), knots.end(), knot) - knots.begin()) - 1;
+      std::vector<std::map<int, double>> new_rows(rows.size() + 1);
+      for (int i = 0; i < static_cast<int>(new_rows.size()); ++i) {
+        if (i <= span - degree) {
+          new_rows[i] = rows[i];
+        } else if (i > span) {
+          new_rows[i] = rows[i - 1];
+        } else {
+          double alpha = (knot - knots[i]) / (knots[i + degree] - knots[i]);
+          for (const auto &entry : rows[i]) new_rows[i][entry.first] += alpha * entry.second;
+          for (const auto &entry : rows[i - 1]) new_rows[i][entry.first] += (1 - alpha) * entry.second;
+        }
+      }
+      rows = new_rows;
+      knots.insert(knots.begin() + span + 1, knot);
+    }
+    std::vector<std::vector<std::pair<int, double>>> sparse_rows;
+    for (const auto &row : rows) {
+      sparse_rows.emplace_back();
+      for (const auto &entry : row) {
+        if (entry.second != 0) sparse_rows.back().emplace_back(entry);
+      }
+    }
+    return sparse_rows;
+  }
+
+  // Determines the active elements and functions and the extraction matrices of the active elements.
+  void Update() {
+    active_elements_.clear();
+    for (uint64_t l = 0; l < levels_.size(); ++l) {
+      for (uint64_t e : levels_[l].domain) {
+        if (levels_[l].refined.count(e) == 0) active_elements_.emplace_back(static_cast<int>(l), e);
+      }
+    }
+    num_functions_ = 0;
+    boundary_indices_.clear();
+    for (uint64_t l = 0; l < levels_.size(); ++l) {
+      Level &level = levels_[l];
+      AddFunctionsTouchingDomain(l);
+      for (auto &entry : level.functions) {
+        Function &function = entry.second;
+        std::array<int, DIM> indices = GetIndices(level.num_functions, entry.first);
+        function.representation.clear();
+        if (l > 0) function.representation = GetRefinedRepresentation(levels_[l - 1], level, indices, function);
+        if (!AllOfSupport(level, indices, level.domain)) continue;
+        function.representation.clear();
+        if (AllOfSupport(level, indices, level.refined)) continue;
+        function.representation.emplace_back(num_functions_, 1.0);
+        for (int d = 0; d < DIM; ++d) {
+          if (indices[d] == 0 || indices[d] == level.num_functions[d] - 1) {
+            boundary_indices_.emplace_back(num_functions_);
+            break;
+          }
+        }
+        ++num_functions_;
+      }
+    }
+    std::sort(boundary_indices_.begin(), boundary_indices_.end());
+    element_indices_.clear();
+    element_extraction_.clear();
+    for (const auto &element : active_elements_) {
+      const Level &level = levels_[element.first];
+      std::vector<arma::uword> local_functions = GetLevelIndices(level, GetIndices(level.num_elements, element.second));
+      std::map<int, std::vector<std::pair<uint64_t, double>>> coefficients;
+      for (uint64_t k = 0; k < local_functions.size(); ++k) {
+        for (const auto &entry : level.functions.at(local_functions[k]).representation) {
+          coefficients[entry.first].emplace_back(k, entry.second);
+        }
+      }
+      std::vector<arma::uword> global_indices;
+      arma::dmat extraction(coefficients.size(), local_functions.size(), arma::fill::zeros);
+      uint64_t row = 0;
+      for (const auto &function : coefficients) {
+        global_indices.emplace_back(static_cast<arma::uword>(function.first));
+        for (const auto &entry : function.second) {
+          extraction(row, entry.first) = entry.second;
+        }
+        ++row;
+      }
+      element_indices_.emplace_back(global_indices);
+      element_extraction_.emplace_back(extraction);
+    }
+  }
+
+  // Stores the functions of the level whose support touches its domain, refining weights and control points.
+  void AddFunctionsTouchingDomain(uint64_t l) {
+    Level &level = levels_[l];
+    int cp_dim = spline_->GetPointDim();
+    for (uint64_t e : level.domain) {
+      for (arma::uword index : GetLevelIndices(level, GetIndices(level.num_elements, e))) {
+        if (level.functions.count(index) > 0) continue;
+        std::array<int, DIM> indices = GetIndices(level.num_functions, index);
+        Function function{0, std::vector<double>(static_cast<uint64_t>(cp_dim), 0.0), {}};
+        if (l == 0) {
+          function.weight = spline_->GetWeight(indices);
+          for (int i = 0; i < cp_dim; ++i) {
+            function.weighted_point[i] = function.weight * spline_->GetControlPoint(indices, i);
+          }
+        } else {
+          for (const auto &parent : GetParents(levels_[l - 1], level, indices)) {
+            const Function &parent_function = levels_[l - 1].functions.at(parent.first);
+            function.weight += parent.second * parent_function.weight;
+            for (int i = 0; i < cp_dim; ++i) {
+              function.weighted_point[i] += parent.second * parent_function.weighted_point[i];
+            }
+          }
+        }
+        level.functions.emplace(index, function);
+      }
+    }
+  }
+
+  // Returns the parents of the function of the fine level with their coefficients T_ji.
+  static std::vector<std::pair<uint64_t, double>> GetParents(const Level &coarse, const Level &fine,
+                                                             const std::array<int, DIM> &indices) {
+    std::array<int, DIM> num_parents;
+    for (int d = 0; d < DIM; ++d) {
+      num_parents[d] = static_cast<int>(fine.refinement_rows[d][indices[d]].size());
+    }
+    std::vector<std::pair<uint64_t, double>> parents;
+    util::MultiIndexHandler<DIM> parent_handler(num_parents);
+    for (int k = 0; k < parent_handler.Get1DLength(); ++k, ++parent_handler) {
+      std::array<int, DIM> parent;
+      double coefficient = 1.0;
+      for (int d = 0; d < DIM; ++d) {
+        const auto &entry = fine.refinement_rows[d][indices[d]][parent_handler[d]];
+        parent[d] = entry.first;
+        coefficient *= entry.second;
+      }
+      parents.emplace_back(Get1DIndex(coarse.num_functions, parent), coefficient);
+    }
+    return parents;
+  }
+
+  // Pushes the representations of the previous level through R_i^{l-1} = sum_j T_ji * w_i^{l-1} / w_j^l * R_j^l.
+  static std::vector<std::pair<int, double>> GetRefinedRepresentation(const Level &coarse, const Level &fine,
+                                                                      const std::array<int, DIM> &indices,
+                                                                      const Function &function) {
+    std::map<int, double> coefficients;
+    for (const auto &parent : GetParents(coarse, fine, indices)) {
+      const Function &parent_function = coarse.functions.at(parent.first);
+      double factor = parent.second * parent_function.weight / function.weight;
+      for (const auto &entry : parent_function.representation) {
+        coefficients[entry.first] += factor * entry.second;
+      }
+    }
+    return std::vector<std::pair<int, double>>(coefficients.begin(), coefficients.end());
+  }
+
+  // Returns the functions of the level that do not vanish on the element, with the first direction running fastest.
+  static std::vector<arma::uword> GetLevelIndices(const Level &level, const std::array<int, DIM> &element) {
+    std::array<int, DIM> length;
+    for (int d = 0; d < DIM; ++d) {
+      length[d] = level.degrees[d] + 1;
+    }
+    std::vector<arma::uword> indices;
+    util::MultiIndexHandler<DIM> function_handler(length);
+    for (int k = 0; k < function_handler.Get1DLength(); ++k, ++function_handler) {
+      std::array<int, DIM> function;
+      for (int d = 0; d < DIM; ++d) {
+        function[d] = level.element_span[d][element[d]] - level.degrees[d] + function_handler[d];
+      }
+      indices.emplace_back(static_cast<arma::uword>(Get1DIndex(level.num_functions, function)));
+    }
+    return indices;
+  }
+
+  static bool AllOfSupport(const Level &level, const std::array<int, DIM> &function, const std::set<uint64_t> &flags) {
+    std::array<int, DIM> length;
+    for (int d = 0; d < DIM; ++d) {
+      length[d] = level.last_element[d][function[d]] - level.first_element[d][function[d]] + 1;
+    }
+    util::MultiIndexHandler<DIM> element_handler(length);
+    for (int k = 0; k < element_handler.Get1DLength(); ++k, ++element_handler) {
+      std::array<int, DIM> element;
+      for (int d = 0; d < DIM; ++d) {
+        element[d] = level.first_element[d][function[d]] + element_handler[d];
+      }
+      if (flags.count(Get1DIndex(level.num_elements, element)) == 0) return false;
+    }
+    return true;
+  }
+
+  static std::array<int, DIM> GetIndices(const std::array<int, DIM> &lengths, uint64_t index) {
+    std::array<int, DIM> indices;
+    for (int d = 0; d < DIM; ++d) {
+      indices[d] = static_cast<int>(index % static_cast<uint64_t>(lengths[d]));
+      index /= static_cast<uint64_t>(lengths[d]);
+    }
+    return indices;
+  }
+
+  static uint64_t Get1DIndex(const std::array<int, DIM> &lengths, const std::array<int, DIM> &indices) {
+    uint64_t index = 0;
+    for (int d = DIM - 1; d >= 0; --d) {
+      index = index * static_cast<uint64_t>(lengths[d]) + static_cast<uint64_t>(indices[d]);
+    }
+    return index;
+  }
+
+  static std::array<int, DIM> GetFilledArray(int value) {
+    std::array<int, DIM> array;
+    array.fill(value);
+    return array;
+  }
+
+  std::shared_ptr<spl::NURBS<DIM>> spline_;
+  std::vector<Level> levels_;
+  std::vector<std::pair<int, uint64_t>> active_elements_;
+  std::vector<std::vector<arma::uword>> element_indices_;
+  std::vector<arma::dmat> element_extraction_;
+  std::vector<int> boundary_indices_;
+  int num_functions_ = 0;
+};
+}  // namespace iga
+
+#endif  // SRC_IGA_TRUNCATED_HIERARCHICAL_SPACE_H_
@@ -12,16 +12,21 @@ You should have received a copy of the GNU Lesser General Public License along w
 <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <armadillo>
 
 #include "bdf_handler.h"
+#include "cholesky_solver.h"
+#include "conjugate_gradient_solver.h"
 #include "element_integral_calculator.h"
 #include "four_point_gauss_legendre.h"
 #include "gmock/gmock.h"
+#include "incomplete_cholesky_preconditioner.h"
 #include "linear_equation_assembler.h"
 #include "nurbs.h"
 #include "poisson_problem.h"
 #include "solution_vtk_writer.h"
+#include "time_integrator.h"
 #include "five_point_gauss_legendre.h"
 
 using testing::Test;
@@ -70,6 +75,133 @@ TEST_F(ALine, Test) { // NOLINT
 }*/
 }
 
+TEST_F(ALine, TestTimeIntegrator) { // NOLINT
+  iga::itg::IntegrationRule rule = iga::itg::FourPointGaussLegendre();
+  auto linear_equation_assembler = std::make_shared<iga::LinearEquationAssembler<1>>(nurbs_);
+  iga::ElementIntegralCalculator<1> elm_itg_calc(nurbs_);
+  iga::BDFHandler<1> bdf_handler(nurbs_, rule, *linear_equation_assembler, elm_itg_calc);
+  auto n = static_cast<uint64_t>(nurbs_->GetNumberOfControlPoints());
+  auto matA = std::make_shared<arma::dmat>(n, n, arma::fill::zeros);
+  auto sparse_matA = std::make_shared<arma::sp_mat>(n, n);
+  auto vecB = std::make_shared<arma::dvec>(n, arma::fill::zeros);
+  auto srcCp = std::make_shared<arma::dvec>(n, arma::fill::ones);
+  auto dirichlet = std::make_shared<arma::dvec>(arma::dvec({1.0, 2.0}));
+  linear_equation_assembler->GetLeftSide(rule, matA, elm_itg_calc);
+  linear_equation_assembler->GetLeftSide(rule, sparse_matA, elm_itg_calc);
+  linear_equation_assembler->GetRightSide(rule, vecB, elm_itg_calc, srcCp);
+  auto solver = std::make_shared<iga::slv::CholeskySolver>();
+  iga::TimeIntegrator<1> time_integrator(nurbs_, rule, linear_equation_assembler, elm_itg_calc, solver, sparse_matA,
+                                         vecB, 0.1, dirichlet);
+  auto left = bdf_handler.GetBDF1LeftSide(matA, 0.1);
+  auto uprev = std::make_shared<arma::dvec>(n, arma::fill::zeros);
+  arma::dvec u;
+  for (int i = 0; i < 5; ++i) {
+    auto right = bdf_handler.GetBDF1RightSide(vecB, uprev, 0.1);
+    linear_equation_assembler->SetDirichletBC(left, right, dirichlet);
+    uprev = std::make_shared<arma::dvec>(arma::solve(*left, *right));
+    u = time_integrator.Step();
+    for (uint64_t j = 0; j < n; ++j) {
+      ASSERT_THAT(u(j), DoubleNear((*uprev)(j), 1e-10));
+    }
+  }
+  ASSERT_THAT(u(0), DoubleNear(1.0, 1e-12));
+  ASSERT_THAT(u(n - 1), DoubleNear(2.0, 1e-12));
+}
+
+TEST_F(ALine, TestTimeIntegratorWithBDF2History) { // NOLINT
+  iga::itg::IntegrationRule rule = iga::itg::FourPointGaussLegendre();
+  auto linear_equation_assembler = std::make_shared<iga::LinearEquationAssembler<1>>(nurbs_);
+  iga::ElementIntegralCalculator<1> elm_itg_calc(nurbs_);
+  iga::BDFHandler<1> bdf_handler(nurbs_, rule, *linear_equation_assembler, elm_itg_calc);
+  auto n = static_cast<uint64_t>(nurbs_->GetNumberOfControlPoints());
+  auto sparse_matA = std::make_shared<arma::sp_mat>(n, n);
+  auto vecB = std::make_shared<arma::dvec>(n, arma::fill::zeros);
+  auto srcCp = std::make_shared<arma::dvec>(n, arma::fill::ones);
+  auto dirichlet = std::make_shared<arma::dvec>(arma::dvec({1.0, 2.0}));
+  linear_equation_assembler->GetLeftSide(rule, sparse_matA, elm_itg_calc);
+  linear_equation_assembler->GetRightSide(rule, vecB, elm_itg_calc, srcCp);
+  auto solver = std::make_shared<iga::slv::CholeskySolver>();
+  iga::TimeIntegrator<1> time_integrator(nurbs_, rule, linear_equation_assembler, elm_itg_calc, solver, sparse_matA,
+                                         vecB, 0.1, dirichlet, 2);
+  arma::dmat mass(*bdf_handler.GetTimeDiscretizationMatrix());
+  std::vector<arma::dvec> previous = {arma::dvec(n, arma::fill::zeros)};
+  for (int i = 0; i < 5; ++i) {
+    // The first step is a BDF1 step, since there is only one previous solution.
+    int order = std::min(2, i + 1);
+    std::vector<double> coefficients = iga::BDFHandler<1>::GetBDFCoefficients(order);
+    arma::dvec history(n, arma::fill::zeros);
+    for (int j = 1; j <= order; ++j) {
+      history -= coefficients[j] * previous[previous.size() - j];
+    }
+    auto left = std::make_shared<arma::dmat>(arma::dmat(*sparse_matA) + mass * (coefficients[0] / 0.1));
+    auto right = std::make_shared<arma::dvec>((*vecB) + mass * history / 0.1);
+    linear_equation_assembler->SetDirichletBC(left, right, dirichlet);
+    previous.emplace_back(arma::solve(*left, *right));
+    arma::dvec u = time_integrator.Step();
+    for (uint64_t j = 0; j < n; ++j) {
+      ASSERT_THAT(u(j), DoubleNear(previous.back()(j), 1e-10));
+    }
+  }
+}
+
+TEST_F(ALine, TestConvergenceOrderOfBDFSchemes) { // NOLINT
+  iga::itg::IntegrationRule rule = iga::itg::FourPointGaussLegendre();
+  iga::PoissonProblem<1> poisson_problem(nurbs_, rule);
+  arma::dvec reference = *poisson_problem.GetUnsteadyStateSolution(0.0025, 1, nullptr, 3).back();
+  for (int order = 1; order <= 3; ++order) {
+    double error_coarse = arma::norm(*poisson_problem.GetUnsteadyStateSolution(0.1, 1, nullptr, order).back() -
+        reference);
+    double error_fine = arma::norm(*poisson_problem.GetUnsteadyStateSolution(0.05, 1, nullptr, order).back() -
+        reference);
+    ASSERT_THAT(error_coarse / error_fine, DoubleNear(pow(2, order), 0.2 * pow(2, order)));
+  }
+}
+
+TEST_F(ALine, TestStreamedSolutions) { // NOLINT
+  iga::itg::IntegrationRule rule = iga::itg::FourPointGaussLegendre();
+  iga::PoissonProblem<1> poisson_problem(nurbs_, rule);
+  auto solutions = poisson_problem.GetUnsteadyStateSolution(0.5, 5.5);
+  std::vector<int> reported_steps;
+  poisson_problem.StreamUnsteadyStateSolution(0.5, 5.5, [&](int step, double time, const arma::dvec &solution) {
+    reported_steps.emplace_back(step);
+    ASSERT_THAT(time, DoubleNear(0.5 * step, 1e-12));
+    for (uint64_t j = 0; j < solution.size(); ++j) {
+      ASSERT_THAT(solution(j), DoubleNear((*solutions[static_cast<uint64_t>(step)])(j), 1e-12));
+    }
+  }, 4);
+  ASSERT_THAT(reported_steps, testing::ElementsAre(0, 4, 8, 11));
+}
+
+TEST_F(ALine, TestWithConjugateGradientSolver) { // NOLINT
+  iga::itg::IntegrationRule rule = iga::itg::FourPointGaussLegendre();
+  iga::PoissonProblem<1> poisson_problem(nurbs_, rule);
+  auto solver = std::make_shared<iga::slv::ConjugateGradientSolver>(
+      std::make_shared<iga::slv::IncompleteCholeskyPreconditioner>(), 1e-12);
+  iga::PoissonProblem<1> poisson_problem_cg(nurbs_, rule, solver);
+  auto solutions = poisson_problem.GetUnsteadyStateSolution(0.5, 10);
+  auto solutions_cg = poisson_problem_cg.GetUnsteadyStateSolution(0.5, 10);
+  ASSERT_THAT(solutions_cg.size(), solutions.size());
+  for (uint64_t i = 0; i < solutions.size(); ++i) {
+    for (uint64_t j = 0; j < solutions[i]->size(); ++j) {
+      ASSERT_THAT((*solutions_cg[i])(j), DoubleNear((*solutions[i])(j), 1e-8));
+    }
+  }
+  auto steady_solution = poisson_problem.GetSteadyStateSolution();
+  auto steady_solution_cg = poisson_problem_cg.GetSteadyStateSolution();
+  for (uint64_t i = 0; i < steady_solution.size(); ++i) {
+    ASSERT_THAT(steady_solution_cg(i), DoubleNear(steady_solution(i), 1e-8));
+  }
+}
+
+TEST_F(ALine, ThrowsIfSolverDoesNotConverge) { // NOLINT
+  iga::itg::IntegrationRule rule = iga::itg::FourPointGaussLegendre();
+  auto solver = std::make_shared<iga::slv::ConjugateGradientSolver>(nullptr, 1e-12, 1);
+  iga::PoissonProblem<1> poisson_problem(nurbs_, rule, solver);
+  ASSERT_THROW(poisson_problem.GetSteadyStateSolution(), std::runtime_error);
+  ASSERT_THROW(poisson_problem.GetUnsteadyStateSolution(0.5, 10), std::runtime_error);
+  ASSERT_THROW(poisson_problem.GetMatrixFreeSteadyStateSolution(1e-12, 1), std::runtime_error);
+}
+
 /*class ASquarePlate : public Test {
  public:
   std::array<baf::KnotVector, 2> knot_vector =
@@ -0,0 +1,88 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <armadillo>
+
+#include "bicgstab_solver.h"
+#include "gmock/gmock.h"
+#include "jacobi_preconditioner.h"
+#include "preconditioner.h"
+
+using testing::Test;
+using testing::DoubleNear;
+using testing::Eq;
+
+class IdentityPreconditioner : public iga::slv::Preconditioner {
+ public:
+  void SetUp(const arma::sp_mat &) override {}
+
+  arma::dvec Apply(const arma::dvec &residual) const override {
+    return residual;
+  }
+};
+
+class ABiCGStabSolver : public Test {
+ public:
+  ABiCGStabSolver() {
+    arma::dmat matA(n, n, arma::fill::zeros);
+    for (uint64_t i = 0; i < n; ++i) {
+      matA(i, i) = 3.0 + 0.1 * i;
+      if (i > 0) matA(i, i - 1) = -1.5;
+      if (i < n - 1) matA(i, i + 1) = -0.5;
+      if (i + 3 < n) matA(i, i + 3) = 0.25;
+      vecB(i) = 1.0 - 0.2 * i;
+    }
+    sparse_matA = std::make_shared<arma::sp_mat>(matA);
+    solution = arma::solve(matA, vecB);
+  }
+
+ protected:
+  uint64_t n = 15;
+  arma::dvec vecB = arma::dvec(n, arma::fill::zeros);
+  arma::dvec solution;
+  std::shared_ptr<arma::sp_mat> sparse_matA;
+};
+
+TEST_F(ABiCGStabSolver, ReturnsSolutionOfNonSymmetricSystem) { // NOLINT
+  iga::slv::BiCGStabSolver solver(std::make_shared<iga::slv::JacobiPreconditioner>(), 1e-12);
+  solver.SetLeftSide(sparse_matA);
+  arma::dvec x = solver.Solve(vecB);
+  ASSERT_THAT(solver.HasConverged(), true);
+  for (uint64_t i = 0; i < n; ++i) {
+    ASSERT_THAT(x(i), DoubleNear(solution(i), 1e-10));
+  }
+}
+
+TEST_F(ABiCGStabSolver, NeedsNoIterationIfWarmStartedWithSolution) { // NOLINT
+  iga::slv::BiCGStabSolver solver(nullptr, 1e-8);
+  solver.SetLeftSide(sparse_matA);
+  solver.Solve(vecB, solution);
+  ASSERT_THAT(solver.GetNumberOfIterations(), Eq(0));
+}
+
+TEST_F(ABiCGStabSolver, ThrowsIfLeftSideIsNotSet) { // NOLINT
+  iga::slv::BiCGStabSolver solver;
+  ASSERT_THROW(solver.Solve(vecB), std::runtime_error);
+}
+
+TEST_F(ABiCGStabSolver, StopsWithoutConvergenceIfItBreaksDownRightAfterRestart) { // NOLINT
+  arma::dmat matA = {{0.0, 1.0}, {-1.0, 0.0}};
+  iga::slv::BiCGStabSolver solver(std::make_shared<IdentityPreconditioner>(), 1e-10, 100);
+  solver.SetLeftSide(std::make_shared<arma::sp_mat>(matA));
+  arma::dvec x = solver.Solve(arma::dvec({1.0, 1.0}));
+  ASSERT_THAT(solver.HasConverged(), false);
+  ASSERT_THAT(solver.GetNumberOfIterations(), Eq(0));
+  ASSERT_THAT(x(0), DoubleNear(0.0, 1e-14));
+  ASSERT_THAT(x(1), DoubleNear(0.0, 1e-14));
+}
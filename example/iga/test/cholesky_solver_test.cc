@@ -0,0 +1,87 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <armadillo>
+
+#include "cholesky_solver.h"
+#include "gmock/gmock.h"
+
+using testing::Test;
+using testing::DoubleNear;
+
+class ACholeskySolver : public Test {
+ public:
+  ACholeskySolver() {
+    arma::dmat matA(n, n, arma::fill::zeros);
+    for (uint64_t i = 0; i < n; ++i) {
+      matA(i, i) = 4;
+      if (i > 0) matA(i, i - 1) = matA(i - 1, i) = -1;
+      if (i > 2) matA(i, i - 3) = matA(i - 3, i) = -0.5;
+      vecB(i) = 1.0 - 0.2 * i;
+    }
+    sparse_matA = std::make_shared<arma::sp_mat>(matA);
+    solution = arma::solve(matA, vecB);
+  }
+
+ protected:
+  uint64_t n = 10;
+  arma::dvec vecB = arma::dvec(n, arma::fill::zeros);
+  arma::dvec solution;
+  std::shared_ptr<arma::sp_mat> sparse_matA;
+};
+
+TEST_F(ACholeskySolver, ReturnsSolution) { // NOLINT
+  iga::slv::CholeskySolver solver;
+  solver.SetLeftSide(sparse_matA);
+  arma::dvec x = solver.Solve(vecB);
+  for (uint64_t i = 0; i < n; ++i) {
+    ASSERT_THAT(x(i), DoubleNear(solution(i), 1e-12));
+  }
+}
+
+TEST_F(ACholeskySolver, ReusesFactorizationForSeveralRightSides) { // NOLINT
+  iga::slv::CholeskySolver solver;
+  solver.SetLeftSide(sparse_matA);
+  solver.Solve(2 * vecB);
+  arma::dvec x = solver.Solve(vecB);
+  for (uint64_t i = 0; i < n; ++i) {
+    ASSERT_THAT(x(i), DoubleNear(solution(i), 1e-12));
+  }
+}
+
+TEST_F(ACholeskySolver, ThrowsForMatrixThatIsNotPositiveDefinite) { // NOLINT
+  iga::slv::CholeskySolver solver;
+  *sparse_matA *= -1;
+  ASSERT_THROW(solver.SetLeftSide(sparse_matA), std::runtime_error);
+}
+
+TEST_F(ACholeskySolver, StoresBandOfFactorForScrambledNumbering) { // NOLINT
+  uint64_t size = 50;
+  arma::dmat matA(size, size, arma::fill::zeros);
+  arma::dvec vecB(size);
+  for (uint64_t i = 0; i < size; ++i) {
+    uint64_t node = (7 * i) % size;
+    matA(node, node) = 2.5;
+    if (i > 0) matA(node, (7 * (i - 1)) % size) = matA((7 * (i - 1)) % size, node) = -1;
+    vecB(i) = 0.1 * i;
+  }
+  arma::dvec expected = arma::solve(matA, vecB);
+  iga::slv::CholeskySolver solver;
+  solver.SetLeftSide(std::make_shared<arma::sp_mat>(matA));
+  ASSERT_THAT(solver.GetNumberOfFactorEntries(), 2 * size - 1);
+  arma::dvec x = solver.Solve(vecB);
+  for (uint64_t i = 0; i < size; ++i) {
+    ASSERT_THAT(x(i), DoubleNear(expected(i), 1e-12));
+  }
+}
@@ -0,0 +1,135 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <armadillo>
+
+#include "collocation_assembler.h"
+#include "gmock/gmock.h"
+#include "poisson_problem.h"
+#include "test_spline.h"
+
+using testing::DoubleNear;
+
+class ACollocationAssembler : public AnIGATestSpline2 {
+ protected:
+  iga::CollocationAssembler<2> collocation_assembler = iga::CollocationAssembler<2>(nurbs_);
+};
+
+TEST_F(ACollocationAssembler, ReturnsGrevilleAbscissae) { // NOLINT
+  std::array<std::vector<double>, 2> greville = collocation_assembler.GetGrevilleAbscissae();
+  std::vector<double> expected = {0, 0.165, 0.495, 0.83, 1};
+  ASSERT_THAT(greville[0].size(), expected.size());
+  for (uint64_t i = 0; i < expected.size(); ++i) {
+    ASSERT_THAT(greville[0][i], DoubleNear(expected[i], 1e-14));
+  }
+}
+
+TEST_F(ACollocationAssembler, AnnihilatesLinearFunctions) { // NOLINT
+  auto left_side = std::make_shared<arma::sp_mat>(n, n);
+  collocation_assembler.GetLeftSide(left_side);
+  std::vector<int> boundary_indices = linear_equation_assembler.GetBoundaryIndices();
+  for (int dimension = 0; dimension < 2; ++dimension) {
+    arma::dvec coordinates(static_cast<uint64_t>(n));
+    util::MultiIndexHandler<2> point_handler(nurbs_->GetPointsPerDirection());
+    for (int i = 0; i < n; ++i, ++point_handler) {
+      coordinates(i) = nurbs_->GetControlPoint(point_handler.GetIndices(), dimension);
+    }
+    arma::dvec result = (*left_side) * coordinates;
+    for (int i = 0; i < n; ++i) {
+      if (std::find(boundary_indices.begin(), boundary_indices.end(), i) != boundary_indices.end()) continue;
+      ASSERT_THAT(result(i), DoubleNear(0, 1e-10));
+    }
+  }
+}
+
+TEST_F(ACollocationAssembler, SetsDirichletValuesInTheOrderOfTheBoundaryIndices) { // NOLINT
+  auto left_side = std::make_shared<arma::sp_mat>(n, n);
+  auto right_side = std::make_shared<arma::dvec>(n, arma::fill::zeros);
+  auto source = std::make_shared<arma::dvec>(n, arma::fill::zeros);
+  std::vector<int> boundary_indices = linear_equation_assembler.GetBoundaryIndices();
+  auto dirichlet = std::make_shared<arma::dvec>(boundary_indices.size());
+  for (uint64_t i = 0; i < boundary_indices.size(); ++i) {
+    (*dirichlet)(i) = 1.0 + i;
+  }
+  collocation_assembler.GetLeftSide(left_side);
+  collocation_assembler.GetRightSide(right_side, source, dirichlet);
+  arma::dmat dense_left_side(*left_side);
+  for (uint64_t i = 0; i < boundary_indices.size(); ++i) {
+    auto index = static_cast<uint64_t>(boundary_indices[i]);
+    ASSERT_THAT((*right_side)(index), DoubleNear(1.0 + i, 1e-14));
+    for (uint64_t j = 0; j < static_cast<uint64_t>(n); ++j) {
+      ASSERT_THAT(dense_left_side(index, j), DoubleNear(j == index ? 1 : 0, 1e-14));
+    }
+  }
+}
+
+TEST_F(ACollocationAssembler, ApproximatesGalerkinSolution) { // NOLINT
+  std::vector<ParamCoord> new_knots;
+  for (int k = 1; k < 8; ++k) {
+    new_knots.emplace_back(ParamCoord{k / 8.0});
+  }
+  nurbs_->RefineKnots(new_knots, 0);
+  nurbs_->RefineKnots(new_knots, 1);
+  iga::PoissonProblem<2> poisson_problem(nurbs_, rule);
+  arma::dvec galerkin = poisson_problem.GetSteadyStateSolution();
+  arma::dvec collocation = poisson_problem.GetCollocationSteadyStateSolution(1e-12);
+  double maximum = arma::norm(galerkin, "inf");
+  for (uint64_t i = 0; i < galerkin.n_elem; ++i) {
+    ASSERT_THAT(collocation(i), DoubleNear(galerkin(i), 0.05 * maximum));
+  }
+}
+
+// x^2 lies in the space of the quadratic B-splines on an affine geometry, with the coefficients 4 * t_{i+1} * t_{i+2}
+// for x = 2 * xi, so that its collocated laplacian is exactly 2.
+TEST(AnAffineCollocationAssembler, ReproducesLaplacianOfQuadraticFunction) { // NOLINT
+  std::vector<ParamCoord> knots = {ParamCoord{0}, ParamCoord{0}, ParamCoord{0}, ParamCoord{0.25}, ParamCoord{0.6},
+                                   ParamCoord{1}, ParamCoord{1}, ParamCoord{1}};
+  std::vector<double> greville = {0, 0.125, 0.425, 0.8, 1};
+  std::vector<baf::ControlPoint> control_points;
+  arma::dvec coefficients(greville.size() * greville.size());
+  uint64_t index = 0;
+  for (double y : greville) {
+    for (uint64_t i = 0; i < greville.size(); ++i) {
+      control_points.emplace_back(std::vector<double>({2 * greville[i], y}));
+      coefficients(index++) = 4 * knots[i + 1].get() * knots[i + 2].get();
+    }
+  }
+  std::array<std::shared_ptr<baf::KnotVector>, 2> knot_vectors = {std::make_shared<baf::KnotVector>(knots),
+                                                                  std::make_shared<baf::KnotVector>(knots)};
+  auto nurbs = std::make_shared<spl::NURBS<2>>(knot_vectors, std::array<Degree, 2>{Degree{2}, Degree{2}},
+                                               control_points, std::vector<double>(control_points.size(), 1.0));
+  iga::CollocationAssembler<2> collocation_assembler(nurbs);
+  auto left_side = std::make_shared<arma::sp_mat>(coefficients.n_elem, coefficients.n_elem);
+  collocation_assembler.GetLeftSide(left_side);
+  arma::dvec result = (*left_side) * coefficients;
+  for (uint64_t j = 1; j + 1 < greville.size(); ++j) {
+    for (uint64_t i = 1; i + 1 < greville.size(); ++i) {
+      ASSERT_THAT(result(i + greville.size() * j), DoubleNear(-2, 1e-10));
+    }
+  }
+}
+
+TEST_F(AnIGATestSpline, ThrowsForCollocationWithC0Knot) { // NOLINT
+  ASSERT_THROW(iga::CollocationAssembler<2>{nurbs_}, std::runtime_error);
+}
+
+TEST(ALinearCollocationAssembler, ThrowsForDegreeOne) { // NOLINT
+  std::array<std::shared_ptr<baf::KnotVector>, 1> knot_vector = {std::make_shared<baf::KnotVector>(
+      baf::KnotVector({ParamCoord{0}, ParamCoord{0}, ParamCoord{1}, ParamCoord{1}}))};
+  std::vector<baf::ControlPoint> control_points = {baf::ControlPoint(std::vector<double>({0.0})),
+                                                   baf::ControlPoint(std::vector<double>({1.0}))};
+  auto nurbs = std::make_shared<spl::NURBS<1>>(knot_vector, std::array<Degree, 1>{Degree{1}}, control_points,
+                                               std::vector<double>({1, 1}));
+  ASSERT_THROW(iga::CollocationAssembler<1>{nurbs}, std::runtime_error);
+}
@@ -0,0 +1,118 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <armadillo>
+#include <utility>
+
+#include "conjugate_gradient_solver.h"
+#include "gmock/gmock.h"
+#include "incomplete_cholesky_preconditioner.h"
+#include "jacobi_preconditioner.h"
+#include "linear_operator.h"
+
+using testing::Test;
+using testing::DoubleNear;
+using testing::Eq;
+
+class AConjugateGradientSolver : public Test {
+ public:
+  AConjugateGradientSolver() {
+    arma::dmat matA(n, n, arma::fill::zeros);
+    for (uint64_t i = 0; i < n; ++i) {
+      matA(i, i) = 2.5;
+      if (i > 0) matA(i, i - 1) = -1;
+      if (i < n - 1) matA(i, i + 1) = -1;
+      vecB(i) = 1.0 + 0.1 * i;
+    }
+    matA(0, n - 1) = matA(n - 1, 0) = -0.5;
+    sparse_matA = std::make_shared<arma::sp_mat>(matA);
+    solution = arma::solve(matA, vecB);
+  }
+
+ protected:
+  uint64_t n = 12;
+  arma::dvec vecB = arma::dvec(n, arma::fill::zeros);
+  arma::dvec solution;
+  std::shared_ptr<arma::sp_mat> sparse_matA;
+};
+
+TEST_F(AConjugateGradientSolver, ReturnsSolutionWithJacobiPreconditioner) { // NOLINT
+  iga::slv::ConjugateGradientSolver solver(std::make_shared<iga::slv::JacobiPreconditioner>(), 1e-12);
+  solver.SetLeftSide(sparse_matA);
+  arma::dvec x = solver.Solve(vecB);
+  ASSERT_THAT(solver.HasConverged(), true);
+  for (uint64_t i = 0; i < n; ++i) {
+    ASSERT_THAT(x(i), DoubleNear(solution(i), 1e-10));
+  }
+}
+
+TEST_F(AConjugateGradientSolver, ReturnsSolutionWithIncompleteCholeskyPreconditioner) { // NOLINT
+  iga::slv::ConjugateGradientSolver solver(std::make_shared<iga::slv::IncompleteCholeskyPreconditioner>(), 1e-12);
+  solver.SetLeftSide(sparse_matA);
+  arma::dvec x = solver.Solve(vecB);
+  ASSERT_THAT(solver.HasConverged(), true);
+  for (uint64_t i = 0; i < n; ++i) {
+    ASSERT_THAT(x(i), DoubleNear(solution(i), 1e-10));
+  }
+}
+
+TEST_F(AConjugateGradientSolver, NeedsNoIterationIfWarmStartedWithSolution) { // NOLINT
+  iga::slv::ConjugateGradientSolver solver(std::make_shared<iga::slv::JacobiPreconditioner>(), 1e-8);
+  solver.SetLeftSide(sparse_matA);
+  solver.Solve(vecB, solution);
+  ASSERT_THAT(solver.GetNumberOfIterations(), Eq(0));
+}
+
+TEST_F(AConjugateGradientSolver, StopsAfterMaximumNumberOfIterations) { // NOLINT
+  iga::slv::ConjugateGradientSolver solver(std::make_shared<iga::slv::JacobiPreconditioner>(), 1e-14, 2);
+  solver.SetLeftSide(sparse_matA);
+  solver.Solve(vecB);
+  ASSERT_THAT(solver.GetNumberOfIterations(), Eq(2));
+  ASSERT_THAT(solver.HasConverged(), false);
+  ASSERT_THROW(solver.ThrowIfNotConverged(), std::runtime_error);
+}
+
+TEST_F(AConjugateGradientSolver, ThrowsIfNoLeftSideIsSet) { // NOLINT
+  iga::slv::ConjugateGradientSolver solver;
+  ASSERT_THROW(solver.Solve(vecB), std::runtime_error);
+}
+
+class ADenseOperator : public iga::slv::LinearOperator {
+ public:
+  explicit ADenseOperator(arma::dmat matA) : matA_(std::move(matA)) {}
+
+  arma::dvec Apply(const arma::dvec &vector) const override {
+    return matA_ * vector;
+  }
+
+  arma::dvec GetDiagonal() const override {
+    arma::dvec diagonal(matA_.n_rows);
+    for (uint64_t i = 0; i < matA_.n_rows; ++i) {
+      diagonal(i) = matA_(i, i);
+    }
+    return diagonal;
+  }
+
+ private:
+  arma::dmat matA_;
+};
+
+TEST_F(AConjugateGradientSolver, ReturnsSolutionForLinearOperator) { // NOLINT
+  iga::slv::ConjugateGradientSolver solver(nullptr, 1e-12);
+  arma::dvec x = solver.Solve(ADenseOperator(arma::dmat(*sparse_matA)), vecB, arma::dvec(n, arma::fill::zeros));
+  ASSERT_THAT(solver.HasConverged(), true);
+  for (uint64_t i = 0; i < n; ++i) {
+    ASSERT_THAT(x(i), DoubleNear(solution(i), 1e-10));
+  }
+}
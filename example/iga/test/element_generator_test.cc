@@ -16,6 +16,7 @@ You should have received a copy of the GNU Lesser General Public License along w
 #include "gmock/gmock.h"
 
 #include "element_generator.h"
+#include "test_spline.h"
 
 using testing::Test;
 
@@ -55,3 +56,13 @@ TEST_F(A1DElementGenerator, ReturnsElementsWithCorrectNodes) { // NOLINT
     ASSERT_THAT(element_list[element].GetUpperBound().get(), element + 1);
   }
 }
+
+TEST_F(AnIGATestSpline3, ReturnsElementIndicesWithFirstDirectionRunningFastest) { // NOLINT
+  iga::elm::ElementGenerator<3> element_generator(nurbs_);
+  std::array<int, 3> num_elements = element_generator.GetNumElementsPerParamDir();
+  util::MultiIndexHandler<3> element_handler(num_elements);
+  for (int e = 0; e < element_generator.GetNumberOfElements(); ++e, ++element_handler) {
+    ASSERT_THAT(element_generator.GetElementIndices(e), element_handler.GetIndices());
+    ASSERT_THAT(element_generator.Get1DElementIndex(element_generator.GetElementIndices(e)), e);
+  }
+}
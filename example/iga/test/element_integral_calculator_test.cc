@@ -15,6 +15,8 @@ You should have received a copy of the GNU Lesser General Public License along w
 #include <armadillo>
 #include <array>
 
+#include "connectivity_handler.h"
+#include "four_point_gauss_legendre.h"
 #include "gmock/gmock.h"
 #include "matlab_test_data.h"
 #include "test_spline.h"
@@ -29,3 +31,118 @@ TEST_F(AnIGATestSpline, TestElementIntegralCalculator) { // NOLINT
     }
   }
 }
+
+TEST_F(AnIGATestSpline, TestSumFactorizedElementMatrices) { // NOLINT
+  for (int e : {0, 3, 5}) {
+    arma::dmat laplace = elm_itg_calc.GetLaplaceElementMatrix(e, rule);
+    arma::dmat laplace_sum_factorized = elm_itg_calc.GetLaplaceElementMatrixSumFactorized(e, rule);
+    arma::dmat mass = elm_itg_calc.GetMassElementMatrix(e, rule);
+    arma::dmat mass_sum_factorized = elm_itg_calc.GetMassElementMatrixSumFactorized(e, rule);
+    ASSERT_THAT(laplace_sum_factorized.n_rows, laplace.n_rows);
+    ASSERT_THAT(laplace_sum_factorized.n_cols, laplace.n_cols);
+    for (uint64_t i = 0; i < laplace.n_rows; ++i) {
+      for (uint64_t j = 0; j < laplace.n_cols; ++j) {
+        ASSERT_THAT(laplace_sum_factorized(i, j), DoubleNear(laplace(i, j), 1e-12));
+        ASSERT_THAT(mass_sum_factorized(i, j), DoubleNear(mass(i, j), 1e-12));
+      }
+    }
+  }
+}
+
+TEST_F(AnIGATestSpline3, TestGlobalIndicesMatchConnectivityHandlerForRepeatedKnots) { // NOLINT
+  iga::ElementIntegralCalculator<3> elm_itg_calc(nurbs_);
+  iga::ConnectivityHandler<3> connectivity_handler(nurbs_);
+  iga::elm::ElementGenerator<3> elm_gen(nurbs_);
+  for (int e = 0; e < elm_gen.GetNumberOfElements(); ++e) {
+    std::vector<arma::uword> global_indices = elm_itg_calc.GetGlobalIndices(e);
+    ASSERT_THAT(global_indices.size(), 64);
+    for (uint64_t j = 0; j < global_indices.size(); ++j) {
+      ASSERT_THAT(global_indices[j] + 1, connectivity_handler.GetGlobalIndex(e, static_cast<int>(j)));
+    }
+  }
+}
+
+class AQuarterAnnulus : public testing::Test {
+ public:
+  std::array<std::shared_ptr<baf::KnotVector>, 2> kv_ptr = {
+      std::make_shared<baf::KnotVector>(baf::KnotVector({ParamCoord{0}, ParamCoord{0}, ParamCoord{0}, ParamCoord{1},
+                                                         ParamCoord{1}, ParamCoord{1}})),
+      std::make_shared<baf::KnotVector>(baf::KnotVector({ParamCoord{0}, ParamCoord{0}, ParamCoord{1},
+                                                         ParamCoord{1}}))};
+  std::array<Degree, 2> degree = {Degree{2}, Degree{1}};
+  std::vector<double> weights = {1, sqrt(0.5), 1, 1, sqrt(0.5), 1};
+  std::vector<baf::ControlPoint> control_points = {
+      baf::ControlPoint(std::vector<double>({1.0, 0.0})),
+      baf::ControlPoint(std::vector<double>({1.0, 1.0})),
+      baf::ControlPoint(std::vector<double>({0.0, 1.0})),
+      baf::ControlPoint(std::vector<double>({2.0, 0.0})),
+      baf::ControlPoint(std::vector<double>({2.0, 2.0})),
+      baf::ControlPoint(std::vector<double>({0.0, 2.0}))};
+  std::shared_ptr<spl::NURBS<2>> nurbs_ = std::make_shared<spl::NURBS<2>>(kv_ptr, degree, control_points, weights);
+  iga::ElementIntegralCalculator<2> elm_itg_calc = iga::ElementIntegralCalculator<2>(nurbs_);
+  iga::itg::IntegrationRule rule = iga::itg::FourPointGaussLegendre();
+};
+
+TEST_F(AQuarterAnnulus, TestSumFactorizedElementMatricesOfRationalSpline) { // NOLINT
+  arma::dmat laplace = elm_itg_calc.GetLaplaceElementMatrix(0, rule);
+  arma::dmat laplace_sum_factorized = elm_itg_calc.GetLaplaceElementMatrixSumFactorized(0, rule);
+  arma::dmat mass = elm_itg_calc.GetMassElementMatrix(0, rule);
+  arma::dmat mass_sum_factorized = elm_itg_calc.GetMassElementMatrixSumFactorized(0, rule);
+  double area = 0;
+  for (uint64_t i = 0; i < laplace.n_rows; ++i) {
+    double row_sum = 0;
+    for (uint64_t j = 0; j < laplace.n_cols; ++j) {
+      ASSERT_THAT(laplace_sum_factorized(i, j), DoubleNear(laplace(i, j), 1e-12));
+      ASSERT_THAT(mass_sum_factorized(i, j), DoubleNear(mass(i, j), 1e-12));
+      row_sum += laplace_sum_factorized(i, j);
+      area += mass_sum_factorized(i, j);
+    }
+    ASSERT_THAT(row_sum, DoubleNear(0, 1e-12));
+  }
+  ASSERT_THAT(area, DoubleNear(0.75 * M_PI, 1e-4));
+}
+
+TEST_F(AQuarterAnnulus, TestSumFactorizedSourceVectorIsMassMatrixTimesSource) { // NOLINT
+  arma::dvec source = {1.0, -2.0, 0.5, 3.0, 0.25, -1.0};
+  auto basis = elm_itg_calc.GetElementBasis(0, rule);
+  arma::dvec source_vector = elm_itg_calc.GetSourceElementVectorSumFactorized(basis, source);
+  arma::dvec local_source(basis.global_indices.size());
+  for (uint64_t j = 0; j < local_source.n_elem; ++j) {
+    local_source(j) = source(basis.global_indices[j]);
+  }
+  arma::dvec expected = elm_itg_calc.GetMassElementMatrixSumFactorized(basis) * local_source;
+  for (uint64_t j = 0; j < expected.n_elem; ++j) {
+    ASSERT_THAT(source_vector(j), DoubleNear(expected(j), 1e-12));
+  }
+}
+
+TEST(AnEmbeddedSurface, HasSameElementMatricesAsPlanarSurface) { // NOLINT
+  std::array<std::shared_ptr<baf::KnotVector>, 2> kv_ptr = {
+      std::make_shared<baf::KnotVector>(baf::KnotVector({ParamCoord{0}, ParamCoord{0}, ParamCoord{0}, ParamCoord{1},
+                                                         ParamCoord{1}, ParamCoord{1}})),
+      std::make_shared<baf::KnotVector>(baf::KnotVector({ParamCoord{0}, ParamCoord{0}, ParamCoord{1},
+                                                         ParamCoord{1}}))};
+  std::array<Degree, 2> degree = {Degree{2}, Degree{1}};
+  std::vector<double> weights = {1, 1, 1, 1, 1, 1};
+  std::vector<std::array<double, 2>> planar = {{0.0, 0.0}, {0.5, 0.2}, {1.0, 0.0}, {0.0, 1.0}, {0.6, 1.3}, {1.0, 1.0}};
+  std::vector<baf::ControlPoint> planar_points, embedded_points;
+  for (const auto &point : planar) {
+    planar_points.emplace_back(std::vector<double>({point[0], point[1]}));
+    embedded_points.emplace_back(std::vector<double>({0.6 * point[0], point[1], 0.8 * point[0]}));
+  }
+  iga::ElementIntegralCalculator<2> planar_calc(
+      std::make_shared<spl::NURBS<2>>(kv_ptr, degree, planar_points, weights));
+  iga::ElementIntegralCalculator<2> embedded_calc(
+      std::make_shared<spl::NURBS<2>>(kv_ptr, degree, embedded_points, weights));
+  iga::itg::IntegrationRule rule = iga::itg::FourPointGaussLegendre();
+  arma::dmat planar_laplace = planar_calc.GetLaplaceElementMatrixSumFactorized(0, rule);
+  arma::dmat embedded_laplace = embedded_calc.GetLaplaceElementMatrixSumFactorized(0, rule);
+  arma::dmat planar_mass = planar_calc.GetMassElementMatrixSumFactorized(0, rule);
+  arma::dmat embedded_mass = embedded_calc.GetMassElementMatrixSumFactorized(0, rule);
+  for (uint64_t i = 0; i < planar_laplace.n_rows; ++i) {
+    for (uint64_t j = 0; j < planar_laplace.n_cols; ++j) {
+      ASSERT_THAT(embedded_laplace(i, j), DoubleNear(planar_laplace(i, j), 1e-12));
+      ASSERT_THAT(embedded_mass(i, j), DoubleNear(planar_mass(i, j), 1e-12));
+    }
+  }
+}
@@ -16,6 +16,7 @@ You should have received a copy of the GNU Lesser General Public License along w
 
 #include "five_point_gauss_legendre.h"
 #include "four_point_gauss_legendre.h"
+#include "gauss_legendre.h"
 #include "integration_rule.h"
 #include "numeric_settings.h"
 #include "one_point_gauss_legendre.h"
@@ -65,3 +66,33 @@ TEST_F(AnIntegrationRule, ReturnsCorrectPointSum) { // NOLINT
     ASSERT_THAT(point_sum, DoubleNear(0.0, util::NumericSettings<double>::kEpsilon()));
   }
 }
+
+TEST_F(AnIntegrationRule, IsReproducedByGeneratedGaussLegendreRule) { // NOLINT
+  for (int points = 1; points <= 5; points++) {
+    iga::itg::GaussLegendre rule(points);
+    ASSERT_THAT(rule.GetNumberOfIntegrationPoints(), points);
+    for (int point = 0; point < points; point++) {
+      ASSERT_THAT(rule.GetIntegrationPoints()[point].GetCoordinate(),
+                  DoubleNear(rules_[points - 1].GetIntegrationPoints()[point].GetCoordinate(), 1e-14));
+      ASSERT_THAT(rule.GetIntegrationPoints()[point].GetWeight(),
+                  DoubleNear(rules_[points - 1].GetIntegrationPoints()[point].GetWeight(), 1e-14));
+    }
+  }
+}
+
+TEST(AGaussLegendreRule, IntegratesPolynomialsExactly) { // NOLINT
+  for (int points : {8, 17, 40}) {
+    iga::itg::GaussLegendre rule(points);
+    for (int degree = 0; degree < 2 * points; degree++) {
+      double integral = 0;
+      for (const auto &point : rule.GetIntegrationPoints()) {
+        integral += point.GetWeight() * pow(point.GetCoordinate(), degree);
+      }
+      ASSERT_THAT(integral, DoubleNear(degree % 2 == 0 ? 2.0 / (degree + 1) : 0.0, 1e-13));
+    }
+  }
+}
+
+TEST(AGaussLegendreRule, ThrowsForNonPositiveNumberOfPoints) { // NOLINT
+  ASSERT_THROW(iga::itg::GaussLegendre(0), std::runtime_error);
+}
@@ -14,7 +14,9 @@ You should have received a copy of the GNU Lesser General Public License along w
 
 #include <armadillo>
 
+#include "conjugate_gradient_solver.h"
 #include "gmock/gmock.h"
+#include "incomplete_cholesky_preconditioner.h"
 #include "matlab_test_data_2.h"
 #include "test_spline.h"
 
@@ -60,3 +62,109 @@ TEST_F(AnIGATestSpline, TestSolution) { // NOLINT
     ASSERT_THAT(solution(i), DoubleNear(matlab_solution[i], 0.00005));
   }
 }
+
+TEST_F(AnIGATestSpline, TestSymmetricSparseDirichletBC) { // NOLINT
+  auto sparse_matA = std::make_shared<arma::sp_mat>(n, n);
+  auto sparse_vecB = std::make_shared<arma::dvec>(n, arma::fill::zeros);
+  linear_equation_assembler.GetLeftSide(rule, matA, elm_itg_calc);
+  linear_equation_assembler.GetLeftSide(rule, sparse_matA, elm_itg_calc);
+  linear_equation_assembler.GetRightSide(rule, vecB, elm_itg_calc, srcCp);
+  *sparse_vecB = *vecB;
+  const std::vector<int> &boundary_indices = linear_equation_assembler.GetBoundaryIndices();
+  ASSERT_THAT(boundary_indices.size(), 24);
+  auto dirichlet = std::make_shared<arma::dvec>(boundary_indices.size());
+  for (uint64_t i = 0; i < dirichlet->n_elem; ++i) {
+    (*dirichlet)(i) = 0.5 * static_cast<double>(i % 4);
+  }
+  linear_equation_assembler.SetDirichletBC(matA, vecB, dirichlet);
+  linear_equation_assembler.SetDirichletBC(sparse_matA, sparse_vecB, dirichlet);
+  arma::dmat dense_matA(*sparse_matA);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      ASSERT_THAT(dense_matA(i, j), DoubleNear(dense_matA(j, i), 1e-14));
+      if (linear_equation_assembler.IsOnBoundary(i) || linear_equation_assembler.IsOnBoundary(j)) {
+        ASSERT_THAT(dense_matA(i, j), DoubleNear(i == j ? 1 : 0, 1e-14));
+      }
+    }
+  }
+  arma::dvec solution = arma::solve(*matA, *vecB);
+  arma::dvec sparse_solution = arma::solve(dense_matA, *sparse_vecB);
+  for (int i = 0; i < n; ++i) {
+    ASSERT_THAT(sparse_solution(i), DoubleNear(solution(i), 1e-10));
+  }
+  for (uint64_t i = 0; i < boundary_indices.size(); ++i) {
+    ASSERT_THAT(sparse_solution(static_cast<uint64_t>(boundary_indices[i])), DoubleNear((*dirichlet)(i), 1e-12));
+  }
+}
+
+TEST_F(AnIGATestSpline, TestSparseLeftSide) { // NOLINT
+  auto n = static_cast<uint64_t>(nurbs_->GetNumberOfControlPoints());
+  auto sparse_matA = std::make_shared<arma::sp_mat>(n, n);
+  linear_equation_assembler.GetLeftSide(rule, sparse_matA, elm_itg_calc);
+  arma::dmat dense_matA(*sparse_matA);
+  for (uint64_t i = 0; i < matlab_matrix_a.size(); ++i) {
+    for (uint64_t j = 0; j < matlab_matrix_a[0].size(); ++j) {
+      ASSERT_THAT(dense_matA(i, j), DoubleNear(matlab_matrix_a[i][j], 0.00005));
+    }
+  }
+}
+
+TEST_F(AnIGATestSpline, TestSparseSolutionWithConjugateGradientSolver) { // NOLINT
+  iga::itg::IntegrationRule rule = iga::itg::TwoPointGaussLegendre();
+  auto n = static_cast<uint64_t>(nurbs_->GetNumberOfControlPoints());
+  auto sparse_matA = std::make_shared<arma::sp_mat>(n, n);
+  linear_equation_assembler.GetLeftSide(rule, sparse_matA, elm_itg_calc);
+  linear_equation_assembler.GetRightSide(rule, vecB, elm_itg_calc, srcCp);
+  linear_equation_assembler.SetZeroBC(sparse_matA, vecB);
+  iga::slv::ConjugateGradientSolver solver(std::make_shared<iga::slv::IncompleteCholeskyPreconditioner>(), 1e-12);
+  solver.SetLeftSide(sparse_matA);
+  arma::dvec solution = solver.Solve(*vecB);
+  for (uint64_t i = 0; i < matlab_solution.size(); ++i) {
+    ASSERT_THAT(solution(i), DoubleNear(matlab_solution[i], 0.00005));
+  }
+}
+
+TEST_F(AnIGATestSpline, TestSparseLeftSideWithRepeatedKnots) { // NOLINT
+  auto n = static_cast<uint64_t>(nurbs_->GetNumberOfControlPoints());
+  auto sparse_matA = std::make_shared<arma::sp_mat>(n, n);
+  linear_equation_assembler.GetLeftSide(rule, matA, elm_itg_calc);
+  linear_equation_assembler.GetLeftSide(rule, sparse_matA, elm_itg_calc);
+  arma::dmat dense_matA(*sparse_matA);
+  for (uint64_t i = 0; i < n; ++i) {
+    for (uint64_t j = 0; j < n; ++j) {
+      ASSERT_THAT(dense_matA(i, j), DoubleNear((*matA)(i, j), 1e-12));
+    }
+  }
+}
+
+TEST_F(AnIGATestSpline, TestSystemInOnePass) { // NOLINT
+  auto n = static_cast<uint64_t>(nurbs_->GetNumberOfControlPoints());
+  auto sparse_matA = std::make_shared<arma::sp_mat>(n, n);
+  linear_equation_assembler.GetSystem(rule, sparse_matA, vecB, elm_itg_calc, srcCp);
+  arma::dmat dense_matA(*sparse_matA);
+  for (uint64_t i = 0; i < matlab_matrix_a.size(); ++i) {
+    for (uint64_t j = 0; j < matlab_matrix_a[0].size(); ++j) {
+      ASSERT_THAT(dense_matA(i, j), DoubleNear(matlab_matrix_a[i][j], 0.00005));
+    }
+  }
+  for (uint64_t i = 0; i < matlab_vector_b.size(); ++i) {
+    ASSERT_THAT((*vecB)(i), DoubleNear(matlab_vector_b[i], 0.00005));
+  }
+}
+
+TEST_F(AnIGATestSpline2, IntegratesNeumannFluxOverBoundary) { // NOLINT
+  std::array<std::array<std::shared_ptr<arma::dvec>, 2>, 2> NeumannCp;
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      NeumannCp[i][j] = std::make_shared<arma::dvec>(nurbs_->GetPointsPerDirection()[1 - i], arma::fill::ones);
+    }
+  }
+  linear_equation_assembler.GetRightSideNeumann(rule, vecB, NeumannCp);
+  ASSERT_THAT(arma::accu(*vecB), DoubleNear(6, 1e-12));
+  *NeumannCp[1][1] *= 2;
+  linear_equation_assembler.GetRightSideNeumann(rule, vecB, NeumannCp);
+  ASSERT_THAT(arma::accu(*vecB), DoubleNear(6 + 8, 1e-12));
+  for (int index : linear_equation_assembler.GetBoundarySplineConnectivity()[0][0]) {
+    ASSERT_THAT((*vecB)(static_cast<uint64_t>(index)), testing::Gt(0));
+  }
+}
@@ -0,0 +1,77 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <armadillo>
+
+#include "gmock/gmock.h"
+#include "matrix_free_operator.h"
+#include "poisson_problem.h"
+#include "test_spline.h"
+
+using testing::DoubleNear;
+
+class AMatrixFreeOperator : public AnIGATestSpline {
+ public:
+  AMatrixFreeOperator() {
+    vector = arma::dvec(static_cast<uint64_t>(n));
+    for (uint64_t i = 0; i < vector.n_elem; ++i) {
+      vector(i) = 1.0 + 0.3 * i - 0.01 * i * i;
+    }
+    auto mass = std::make_shared<arma::sp_mat>(n, n);
+    linear_equation_assembler.GetLeftSide(rule, left_side, elm_itg_calc);
+    linear_equation_assembler.GetMassMatrix(rule, mass, elm_itg_calc);
+    *left_side += 0.5 * (*mass);
+  }
+
+ protected:
+  std::shared_ptr<arma::sp_mat> left_side = std::make_shared<arma::sp_mat>(n, n);
+  arma::dvec vector;
+};
+
+TEST_F(AMatrixFreeOperator, AppliesLaplaceAndMassOperator) { // NOLINT
+  iga::MatrixFreeOperator<2> matrix_free_operator(nurbs_, rule, 1.0, 0.5);
+  arma::dvec expected = (*left_side) * vector;
+  arma::dvec result = matrix_free_operator.Apply(vector);
+  for (uint64_t i = 0; i < expected.n_elem; ++i) {
+    ASSERT_THAT(result(i), DoubleNear(expected(i), 1e-10));
+  }
+}
+
+TEST_F(AMatrixFreeOperator, ReturnsDiagonal) { // NOLINT
+  iga::MatrixFreeOperator<2> matrix_free_operator(nurbs_, rule, 1.0, 0.5);
+  arma::dvec diagonal = matrix_free_operator.GetDiagonal();
+  for (uint64_t i = 0; i < diagonal.n_elem; ++i) {
+    ASSERT_THAT(diagonal(i), DoubleNear((*left_side)(i, i), 1e-10));
+  }
+}
+
+TEST_F(AMatrixFreeOperator, AppliesDirichletBoundary) { // NOLINT
+  iga::MatrixFreeOperator<2> matrix_free_operator(nurbs_, rule, 1.0, 0.5);
+  matrix_free_operator.SetDirichletBoundary(linear_equation_assembler.GetBoundaryIndices());
+  linear_equation_assembler.SetDirichletBCLeftSide(left_side);
+  arma::dvec expected = (*left_side) * vector;
+  arma::dvec result = matrix_free_operator.Apply(vector);
+  for (uint64_t i = 0; i < expected.n_elem; ++i) {
+    ASSERT_THAT(result(i), DoubleNear(expected(i), 1e-10));
+  }
+}
+
+TEST_F(AMatrixFreeOperator, SolvesPoissonProblem) { // NOLINT
+  iga::PoissonProblem<2> poisson_problem(nurbs_, rule);
+  arma::dvec expected = poisson_problem.GetSteadyStateSolution();
+  arma::dvec result = poisson_problem.GetMatrixFreeSteadyStateSolution(1e-12);
+  for (uint64_t i = 0; i < expected.n_elem; ++i) {
+    ASSERT_THAT(result(i), DoubleNear(expected(i), 1e-8));
+  }
+}
@@ -0,0 +1,98 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <armadillo>
+
+#include "gmock/gmock.h"
+#include "multi_patch_problem.h"
+#include "poisson_problem.h"
+#include "three_point_gauss_legendre.h"
+
+using testing::DoubleNear;
+using testing::Test;
+
+// Two quadratic patches on [0, 1] x [0, 1] and [1, 2] x [0, 1] span the same space as a single patch on [0, 2] x [0, 1]
+// with a double knot at 0.5 in the first direction. All control points lie at the Greville abscissae, so that the
+// geometries are affine.
+class TwoPatches : public Test {
+ protected:
+  static std::shared_ptr<spl::NURBS<2>> GetPatch(const std::vector<double> &knots_x, const std::vector<double> &x) {
+    std::vector<double> knots_y = {0, 0, 0, 0.5, 1, 1, 1};
+    std::vector<double> y = {0, 0.25, 0.75, 1};
+    auto to_knot_vector = [](const std::vector<double> &knots) {
+      std::vector<ParamCoord> param_coords;
+      for (double knot : knots) param_coords.emplace_back(ParamCoord{knot});
+      return std::make_shared<baf::KnotVector>(param_coords);
+    };
+    std::vector<baf::ControlPoint> control_points;
+    for (double y_coordinate : y) {
+      for (double x_coordinate : x) {
+        control_points.emplace_back(std::vector<double>({x_coordinate, y_coordinate, 0.0}));
+      }
+    }
+    std::vector<double> weights(control_points.size(), 1.0);
+    KnotVectors<2> knot_vectors = {to_knot_vector(knots_x), to_knot_vector(knots_y)};
+    return std::make_shared<spl::NURBS<2>>(knot_vectors, std::array<Degree, 2>{Degree{2}, Degree{2}},
+                                           control_points, weights);
+  }
+
+  std::vector<double> patch_knots = {0, 0, 0, 0.5, 1, 1, 1};
+  std::shared_ptr<spl::NURBS<2>> left = GetPatch(patch_knots, {0, 0.25, 0.75, 1});
+  std::shared_ptr<spl::NURBS<2>> right = GetPatch(patch_knots, {1, 1.25, 1.75, 2});
+  std::shared_ptr<spl::NURBS<2>> single = GetPatch({0, 0, 0, 0.25, 0.5, 0.5, 0.75, 1, 1, 1},
+                                                   {0, 0.25, 0.75, 1, 1.25, 1.75, 2});
+  iga::itg::IntegrationRule rule = iga::itg::ThreePointGaussLegendre();
+  iga::MultiPatchProblem<2> multi_patch_problem = iga::MultiPatchProblem<2>({left, right}, rule);
+};
+
+TEST_F(TwoPatches, GlueTheInterfaceIntoOneNumbering) { // NOLINT
+  ASSERT_THAT(multi_patch_problem.GetNumberOfDegreesOfFreedom(), 28);
+  ASSERT_THAT(multi_patch_problem.GetBoundaryIndices().size(), 18);
+  for (int j = 0; j < 4; ++j) {
+    ASSERT_THAT(multi_patch_problem.GetGlobalIndices(1)[4 * j], multi_patch_problem.GetGlobalIndices(0)[4 * j + 3]);
+  }
+}
+
+TEST_F(TwoPatches, ReproduceSinglePatchSolution) { // NOLINT
+  arma::dvec solution = multi_patch_problem.GetSteadyStateSolution();
+  arma::dvec expected = iga::PoissonProblem<2>(single, rule).GetSteadyStateSolution();
+  for (int p = 0; p < 2; ++p) {
+    arma::dvec patch_solution = multi_patch_problem.GetPatchSolution(solution, p);
+    for (uint64_t j = 0; j < 4; ++j) {
+      for (uint64_t i = 0; i < 4; ++i) {
+        ASSERT_THAT(patch_solution(4 * j + i), DoubleNear(expected(7 * j + 3 * p + i), 1e-12));
+      }
+    }
+  }
+}
+
+TEST_F(TwoPatches, AreTakenFromReaderOutput) { // NOLINT
+  std::vector<std::any> splines = {std::make_any<std::shared_ptr<spl::NURBS<2>>>(left),
+                                   std::make_any<std::shared_ptr<spl::NURBS<1>>>(nullptr),
+                                   std::make_any<std::shared_ptr<spl::NURBS<2>>>(right)};
+  ASSERT_THAT(iga::MultiPatchProblem<2>::GetPatches(splines).size(), 2);
+}
+
+TEST_F(TwoPatches, AssembleTheSameSystemOnOneThread) { // NOLINT
+  iga::MultiPatchProblem<2> sequential_problem({left, right}, rule, nullptr, 1e-10, 1);
+  auto matA = std::make_shared<arma::sp_mat>();
+  auto vecB = std::make_shared<arma::dvec>();
+  auto sequential_matA = std::make_shared<arma::sp_mat>();
+  auto sequential_vecB = std::make_shared<arma::dvec>();
+  multi_patch_problem.GetSystem(matA, vecB);
+  sequential_problem.GetSystem(sequential_matA, sequential_vecB);
+  ASSERT_THAT(sequential_matA->n_rows, 28);
+  ASSERT_THAT(arma::norm(arma::dmat(*sequential_matA - *matA), "inf"), DoubleNear(0, 1e-12));
+  ASSERT_THAT(arma::norm(*sequential_vecB - *vecB, "inf"), DoubleNear(0, 1e-12));
+}
@@ -0,0 +1,132 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <armadillo>
+
+#include "conjugate_gradient_solver.h"
+#include "gmock/gmock.h"
+#include "multigrid_preconditioner.h"
+#include "poisson_problem.h"
+#include "test_spline.h"
+
+using testing::DoubleNear;
+using testing::Le;
+
+class AMultigridPreconditioner : public AnIGATestSpline2 {
+ protected:
+  void Refine(int number_of_elements) {
+    std::vector<ParamCoord> new_knots;
+    for (int k = 1; k < number_of_elements; ++k) {
+      ParamCoord knot{static_cast<double>(k) / number_of_elements};
+      if (k * 3 % number_of_elements != 0 && nurbs_->GetKnotVector(0)->GetMultiplicity(knot) == 0) {
+        new_knots.emplace_back(knot);
+      }
+    }
+    nurbs_->RefineKnots(new_knots, 0);
+    nurbs_->RefineKnots(new_knots, 1);
+  }
+
+  int GetNumberOfIterations() {
+    int num_cp = nurbs_->GetNumberOfControlPoints();
+    iga::LinearEquationAssembler<2> assembler(nurbs_);
+    iga::ElementIntegralCalculator<2> calculator(nurbs_);
+    auto left_side = std::make_shared<arma::sp_mat>(num_cp, num_cp);
+    auto right_side = std::make_shared<arma::dvec>(num_cp, arma::fill::zeros);
+    assembler.GetLeftSide(rule, left_side, calculator);
+    assembler.GetRightSide(rule, right_side, calculator, std::make_shared<arma::dvec>(num_cp, arma::fill::ones));
+    assembler.SetZeroBC(left_side, right_side);
+    iga::slv::ConjugateGradientSolver solver(std::make_shared<iga::MultigridPreconditioner<2>>(nurbs_), 1e-10);
+    solver.SetLeftSide(left_side);
+    solver.Solve(*right_side);
+    EXPECT_TRUE(solver.HasConverged());
+    return solver.GetNumberOfIterations();
+  }
+};
+
+TEST_F(AMultigridPreconditioner, KeepsEverySecondDistinctInteriorKnot) { // NOLINT
+  std::vector<double> coarse_knots = iga::MultigridPreconditioner<2>::GetCoarseKnots(
+      {0, 0, 0, 0.25, 0.5, 0.5, 0.75, 1, 1, 1}, 2);
+  std::vector<double> expected = {0, 0, 0, 0.5, 0.5, 1, 1, 1};
+  ASSERT_THAT(coarse_knots, testing::ContainerEq(expected));
+}
+
+TEST_F(AMultigridPreconditioner, ReturnsKnotInsertionMatrixOfRefinedSpline) { // NOLINT
+  std::vector<double> coarse_knots = {0, 0, 0, 0.4, 1, 1, 1};
+  std::vector<double> fine_knots = {0, 0, 0, 0.2, 0.4, 0.4, 0.7, 1, 1, 1};
+  arma::sp_mat insertion_matrix = iga::MultigridPreconditioner<2>::GetKnotInsertionMatrix(coarse_knots, fine_knots, 2);
+  ASSERT_THAT(insertion_matrix.n_rows, 7);
+  ASSERT_THAT(insertion_matrix.n_cols, 4);
+  ASSERT_THAT(insertion_matrix.n_nonzero, Le(7 * 3));
+  std::vector<double> coefficients = {1.0, -0.5, 2.0, 0.25};
+  std::vector<baf::ControlPoint> coarse_points, fine_points;
+  for (uint64_t i = 0; i < insertion_matrix.n_rows; ++i) {
+    double fine_coefficient = 0;
+    double row_sum = 0;
+    for (uint64_t j = 0; j < insertion_matrix.n_cols; ++j) {
+      fine_coefficient += insertion_matrix(i, j) * coefficients[j];
+      row_sum += insertion_matrix(i, j);
+    }
+    ASSERT_THAT(row_sum, DoubleNear(1, 1e-14));
+    fine_points.emplace_back(std::vector<double>({fine_coefficient}));
+  }
+  for (double coefficient : coefficients) {
+    coarse_points.emplace_back(std::vector<double>({coefficient}));
+  }
+  auto to_knot_vector = [](const std::vector<double> &knots) {
+    std::vector<ParamCoord> param_coords;
+    for (double knot : knots) param_coords.emplace_back(ParamCoord{knot});
+    return std::make_shared<baf::KnotVector>(param_coords);
+  };
+  spl::BSpline<1> coarse(KnotVectors<1>{to_knot_vector(coarse_knots)}, {Degree{2}}, coarse_points);
+  spl::BSpline<1> fine(KnotVectors<1>{to_knot_vector(fine_knots)}, {Degree{2}}, fine_points);
+  for (double xi = 0; xi <= 1; xi += 0.05) {
+    ASSERT_THAT(fine.Evaluate({ParamCoord{xi}}, {0})[0], DoubleNear(coarse.Evaluate({ParamCoord{xi}}, {0})[0], 1e-13));
+  }
+}
+
+TEST_F(AMultigridPreconditioner, ProlongatesRationalFunctions) { // NOLINT
+  for (uint64_t i = 0; i < weights.size(); ++i) {
+    weights[i] = 1 + 0.1 * static_cast<double>(i % 3);
+  }
+  auto rational = std::make_shared<spl::NURBS<2>>(kv_ptr, degree, control_points, weights);
+  std::vector<ParamCoord> new_knots = {ParamCoord{0.165}, ParamCoord{0.495}, ParamCoord{0.83}};
+  rational->RefineKnots(new_knots, 0);
+  rational->RefineKnots(new_knots, 1);
+  iga::MultigridPreconditioner<2> multigrid(rational, false, 2);
+  ASSERT_THAT(multigrid.GetNumberOfDegreesOfFreedom(0), 64);
+  ASSERT_THAT(multigrid.GetNumberOfDegreesOfFreedom(1), 25);
+  arma::dvec constant = multigrid.GetProlongation(0) * arma::dvec(25, arma::fill::ones);
+  for (uint64_t i = 0; i < constant.n_elem; ++i) {
+    ASSERT_THAT(constant(i), DoubleNear(1, 1e-12));
+  }
+}
+
+TEST_F(AMultigridPreconditioner, ReproducesDirectSolution) { // NOLINT
+  Refine(12);
+  iga::PoissonProblem<2> poisson_problem(nurbs_, rule);
+  arma::dvec direct = poisson_problem.GetSteadyStateSolution();
+  arma::dvec multigrid = poisson_problem.GetMultigridSteadyStateSolution(1e-12);
+  for (uint64_t i = 0; i < direct.n_elem; ++i) {
+    ASSERT_THAT(multigrid(i), DoubleNear(direct(i), 1e-9));
+  }
+}
+
+TEST_F(AMultigridPreconditioner, NeedsNumberOfIterationsIndependentOfMeshSize) { // NOLINT
+  Refine(6);
+  int coarse_iterations = GetNumberOfIterations();
+  Refine(18);
+  int fine_iterations = GetNumberOfIterations();
+  ASSERT_THAT(coarse_iterations, Le(15));
+  ASSERT_THAT(fine_iterations, Le(coarse_iterations + 3));
+}
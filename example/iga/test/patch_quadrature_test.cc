@@ -0,0 +1,120 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <armadillo>
+
+#include "gmock/gmock.h"
+#include "linear_equation_assembler.h"
+#include "patch_quadrature.h"
+#include "three_point_gauss_legendre.h"
+
+using testing::DoubleNear;
+using testing::Test;
+
+// Quadratic C^1 splines on three elements with the control points at the Greville abscissae, so that the geometry
+// mapping is affine and the integrands of the stiffness and the mass matrix are piecewise polynomials.
+class APatchQuadrature : public Test {
+ public:
+  APatchQuadrature() {
+    std::vector<ParamCoord> knots = {ParamCoord{0}, ParamCoord{0}, ParamCoord{0}, ParamCoord{1.0 / 3},
+                                     ParamCoord{2.0 / 3}, ParamCoord{1}, ParamCoord{1}, ParamCoord{1}};
+    std::vector<double> greville = {0, 1.0 / 6, 0.5, 5.0 / 6, 1};
+    std::vector<baf::ControlPoint> control_points;
+    for (double y : greville) {
+      for (double x : greville) {
+        control_points.emplace_back(std::vector<double>({2 * x, y}));
+      }
+    }
+    std::array<std::shared_ptr<baf::KnotVector>, 2> knot_vectors = {std::make_shared<baf::KnotVector>(knots),
+                                                                    std::make_shared<baf::KnotVector>(knots)};
+    nurbs_ = std::make_shared<spl::NURBS<2>>(knot_vectors, std::array<Degree, 2>{Degree{2}, Degree{2}}, control_points,
+                                             std::vector<double>(control_points.size(), 1.0));
+  }
+
+ protected:
+  std::shared_ptr<spl::NURBS<2>> nurbs_;
+};
+
+TEST_F(APatchQuadrature, NeedsAboutHalfOfTheGaussLegendrePoints) { // NOLINT
+  iga::PatchQuadrature<2> quadrature(nurbs_);
+  for (int d = 0; d < 2; ++d) {
+    ASSERT_TRUE(quadrature.IsReduced(d));
+    // The products of the quadratic C^1 splines on three elements and of their derivatives lie in a space of dimension
+    // 13, which needs 7 points instead of 3 * 3.
+    ASSERT_THAT(quadrature.GetNumberOfIntegrationPoints(d), 7);
+  }
+}
+
+TEST_F(APatchQuadrature, ReturnsSameMatricesAsGaussLegendreForAffineGeometry) { // NOLINT
+  iga::PatchQuadrature<2> quadrature(nurbs_);
+  iga::LinearEquationAssembler<2> linear_equation_assembler(nurbs_);
+  iga::ElementIntegralCalculator<2> elm_itg_calc(nurbs_);
+  iga::itg::ThreePointGaussLegendre rule;
+  int n = nurbs_->GetNumberOfControlPoints();
+  auto laplace = std::make_shared<arma::sp_mat>(n, n);
+  auto laplace_reduced = std::make_shared<arma::sp_mat>(n, n);
+  auto mass = std::make_shared<arma::sp_mat>(n, n);
+  auto mass_reduced = std::make_shared<arma::sp_mat>(n, n);
+  linear_equation_assembler.GetLeftSide(rule, laplace, elm_itg_calc);
+  linear_equation_assembler.GetLeftSide(quadrature, laplace_reduced, elm_itg_calc);
+  linear_equation_assembler.GetMassMatrix(rule, mass, elm_itg_calc);
+  linear_equation_assembler.GetMassMatrix(quadrature, mass_reduced, elm_itg_calc);
+  for (int j = 0; j < n; ++j) {
+    for (int k = 0; k < n; ++k) {
+      ASSERT_THAT(static_cast<double>((*laplace_reduced)(j, k)), DoubleNear((*laplace)(j, k), 1e-12));
+      ASSERT_THAT(static_cast<double>((*mass_reduced)(j, k)), DoubleNear((*mass)(j, k), 1e-12));
+    }
+  }
+}
+
+TEST(AReducedSplineRule, IntegratesProductSpaceOfNonUniformKnotVectorExactly) { // NOLINT
+  for (int degree = 2; degree <= 4; ++degree) {
+    std::vector<ParamCoord> knots(static_cast<uint64_t>(degree + 1), ParamCoord{0});
+    for (double knot : {0.1, 0.25, 0.3, 0.3, 0.6, 0.8}) {
+      knots.emplace_back(ParamCoord{knot});
+    }
+    knots.insert(knots.end(), static_cast<uint64_t>(degree + 1), ParamCoord{1});
+    baf::KnotVector knot_vector(knots);
+    SCOPED_TRACE(degree);
+    std::vector<std::pair<double, double>> points = iga::PatchQuadrature<1>::GetReducedPoints(knot_vector, degree);
+    ASSERT_FALSE(points.empty());
+    int num_baf = static_cast<int>(knots.size()) - degree - 1;
+    ASSERT_LT(points.size(), static_cast<uint64_t>(6 * (degree + 1)));
+    for (int j = 0; j < num_baf; ++j) {
+      std::unique_ptr<baf::BasisFunction> first(
+          baf::BasisFunctionFactory::CreateDynamic(knot_vector, KnotSpan{j}, Degree{degree}));
+      for (int k = j; k < num_baf && k <= j + degree; ++k) {
+        std::unique_ptr<baf::BasisFunction> second(
+            baf::BasisFunctionFactory::CreateDynamic(knot_vector, KnotSpan{k}, Degree{degree}));
+        double reduced = 0;
+        for (const auto &point : points) {
+          reduced += point.second * first->Evaluate(ParamCoord{point.first}) *
+              second->Evaluate(ParamCoord{point.first});
+        }
+        double gauss = 0;
+        iga::itg::GaussLegendre rule(degree + 1);
+        for (uint64_t e = 0; e + 1 < knots.size(); ++e) {
+          double lower = knots[e].get();
+          double upper = knots[e + 1].get();
+          if (upper <= lower) continue;
+          for (const auto &point : rule.GetIntegrationPoints()) {
+            ParamCoord x{((upper - lower) * point.GetCoordinate() + upper + lower) / 2.0};
+            gauss += (upper - lower) / 2.0 * point.GetWeight() * first->Evaluate(x) * second->Evaluate(x);
+          }
+        }
+        ASSERT_THAT(reduced, DoubleNear(gauss, 1e-12));
+      }
+    }
+  }
+}
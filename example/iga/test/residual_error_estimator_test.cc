@@ -0,0 +1,94 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <armadillo>
+
+#include "adaptive_refinement.h"
+#include "gmock/gmock.h"
+#include "hierarchical_poisson_problem.h"
+#include "residual_error_estimator.h"
+#include "test_spline.h"
+
+using testing::DoubleNear;
+using testing::ElementsAre;
+using testing::Eq;
+using testing::Gt;
+using testing::Le;
+using testing::Lt;
+
+class AResidualErrorEstimator : public AnIGATestSpline2 {
+ protected:
+  std::shared_ptr<iga::HierarchicalPoissonProblem<2>> problem =
+      std::make_shared<iga::HierarchicalPoissonProblem<2>>(nurbs_, rule);
+};
+
+TEST_F(AResidualErrorEstimator, VanishesForLinearFunctionWithoutSource) { // NOLINT
+  iga::ResidualErrorEstimator<2> estimator(*problem->GetSpace(), rule, 0.0);
+  for (int dimension = 0; dimension < 2; ++dimension) {
+    arma::dvec coordinates(static_cast<uint64_t>(n));
+    util::MultiIndexHandler<2> point_handler(nurbs_->GetPointsPerDirection());
+    for (int i = 0; i < n; ++i, ++point_handler) {
+      coordinates(i) = nurbs_->GetControlPoint(point_handler.GetIndices(), dimension);
+    }
+    ASSERT_THAT(estimator.GetEstimate(coordinates), DoubleNear(0, 1e-10));
+  }
+}
+
+TEST_F(AResidualErrorEstimator, ReturnsSameIndicatorsForAnyNumberOfThreads) { // NOLINT
+  problem->Refine({0, 1});
+  arma::dvec solution = problem->GetSteadyStateSolution();
+  std::vector<double> serial = iga::ResidualErrorEstimator<2>(*problem->GetSpace(), rule, 1.0, 1)
+      .GetSquaredIndicators(solution);
+  std::vector<double> parallel = iga::ResidualErrorEstimator<2>(*problem->GetSpace(), rule, 1.0, 4)
+      .GetSquaredIndicators(solution);
+  ASSERT_THAT(parallel, Eq(serial));
+  ASSERT_THAT(serial.size(), Eq(static_cast<uint64_t>(problem->GetSpace()->GetNumberOfElements())));
+}
+
+TEST_F(AResidualErrorEstimator, DecreasesUnderUniformRefinement) { // NOLINT
+  double coarse = iga::ResidualErrorEstimator<2>(*problem->GetSpace(), rule).GetEstimate(
+      problem->GetSteadyStateSolution());
+  std::vector<int> elements;
+  for (int e = 0; e < problem->GetSpace()->GetNumberOfElements(); ++e) {
+    elements.emplace_back(e);
+  }
+  problem->Refine(elements);
+  double fine = iga::ResidualErrorEstimator<2>(*problem->GetSpace(), rule).GetEstimate(
+      problem->GetSteadyStateSolution());
+  ASSERT_THAT(fine, Lt(coarse));
+}
+
+TEST(AnAdaptiveRefinement, MarksSmallestSetWithLargestIndicators) { // NOLINT
+  ASSERT_THAT(iga::AdaptiveRefinement<2>::GetMarkedElements({0.1, 0.5, 0.3, 0.1}, 0.6), ElementsAre(1, 2));
+  ASSERT_THAT(iga::AdaptiveRefinement<2>::GetMarkedElements({0.1, 0.5, 0.3, 0.1}, 0.5), ElementsAre(1));
+  ASSERT_THAT(iga::AdaptiveRefinement<2>::GetMarkedElements({0.1, 0.5, 0.3, 0.1}, 1.0), ElementsAre(1, 2, 0, 3));
+}
+
+TEST_F(AResidualErrorEstimator, DrivesAdaptiveRefinementBelowTolerance) { // NOLINT
+  iga::AdaptiveRefinement<2> adaptive_refinement(problem, rule);
+  double initial = iga::ResidualErrorEstimator<2>(*problem->GetSpace(), rule).GetEstimate(
+      problem->GetSteadyStateSolution());
+  arma::dvec solution = adaptive_refinement.Solve(0.5 * initial, 10);
+  const std::vector<double> &estimates = adaptive_refinement.GetEstimates();
+  for (uint64_t i = 1; i < estimates.size(); ++i) {
+    ASSERT_THAT(estimates[i], Lt(estimates[i - 1]));
+  }
+  ASSERT_THAT(estimates.back(), Le(0.5 * initial));
+  ASSERT_THAT(solution.n_elem, Eq(static_cast<uint64_t>(problem->GetSpace()->GetNumberOfBasisFunctions())));
+  ASSERT_THAT(problem->GetSpace()->GetNumberOfLevels(), Gt(1));
+}
+
+TEST_F(AResidualErrorEstimator, ThrowsForInvalidMarkingParameter) { // NOLINT
+  ASSERT_THROW(iga::AdaptiveRefinement<2>(problem, rule, 0.0), std::runtime_error);
+}
@@ -14,10 +14,19 @@ You should have received a copy of the GNU Lesser General Public License along w
 
 #include <armadillo>
 
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
 #include "gmock/gmock.h"
+#include "solution_spline.h"
 #include "solution_vtk_writer.h"
+#include "solution_xdmf_time_series_writer.h"
 #include "test_spline.h"
 
+using testing::DoubleNear;
+
 // only needed for tests that are currently commented out
 // #include "four_point_gauss_legendre.h"
 
@@ -28,9 +37,85 @@ TEST_F(AnIGATestSpline, TestSolutionVTKWriter) { // NOLINT
   arma::dvec solution = arma::solve(*matA, *vecB);
   iga::SolutionVTKWriter<2> solution_vtk_writer;
   solution_vtk_writer.WriteSolutionToVTK(nurbs_, solution, {{10, 10}}, "solution.vtk");
+  std::ifstream file("solution.vtk");
+  std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  ASSERT_THAT(content, testing::HasSubstr("\nPOINT_DATA 121\nSCALARS solution double 1\nLOOKUP_TABLE default\n"));
   remove("solution.vtk");
 }
 
+TEST_F(AnIGATestSpline, TestSolutionXDMFTimeSeriesWriter) { // NOLINT
+  arma::dvec solution(static_cast<uint64_t>(nurbs_->GetNumberOfControlPoints()));
+  for (uint64_t i = 0; i < solution.n_elem; ++i) {
+    solution(i) = 0.1 * i;
+  }
+  iga::SolutionXDMFTimeSeriesWriter<2> time_series_writer(nurbs_, {4, 5}, "solution_series");
+  arma::dvec point_data = time_series_writer.GetPointData(solution);
+  std::shared_ptr<spl::NURBS<2>> solution_spl = iga::SolutionSpline<2>(nurbs_, solution).GetSolutionSpline();
+  ASSERT_THAT(point_data.n_elem, 30);
+  for (int j = 0, point = 0; j <= 5; ++j) {
+    for (int i = 0; i <= 4; ++i, ++point) {
+      ASSERT_THAT(point_data(static_cast<uint64_t>(point)),
+                  DoubleNear(solution_spl->Evaluate({ParamCoord{i / 4.0}, ParamCoord{j / 5.0}}, {3})[0], 1e-12));
+    }
+  }
+  time_series_writer.WriteStep(0, 0.0, solution);
+  time_series_writer.WriteStep(2, 0.5, 2 * solution);
+  time_series_writer.Finish();
+  ASSERT_THROW(time_series_writer.WriteStep(3, 1.0, solution), std::runtime_error);
+  std::ifstream index("solution_series.xmf");
+  std::string content((std::istreambuf_iterator<char>(index)), std::istreambuf_iterator<char>());
+  ASSERT_THAT(content, testing::HasSubstr("<Topology TopologyType=\"Quadrilateral\" NumberOfElements=\"20\">\n"
+                                          "<DataItem Dimensions=\"20 4\" NumberType=\"Int\" Precision=\"8\" "
+                                          "Format=\"Binary\" Seek=\"720\">solution_series_grid.bin</DataItem>\n"));
+  ASSERT_THAT(content, testing::HasSubstr("<Grid Name=\"step_2\" GridType=\"Uniform\">\n<Time Value=\"0.5\"/>\n"
+                                          "<Topology Reference=\"/Xdmf/Domain/Topology[1]\"/>\n"));
+  ASSERT_THAT(content, testing::HasSubstr("Format=\"Binary\">solution_series_2.bin</DataItem>\n</Attribute>\n"
+                                          "</Grid>\n</Grid>\n</Domain>\n</Xdmf>\n"));
+  std::ifstream grid("solution_series_grid.bin", std::ios::binary);
+  for (int j = 0; j <= 5; ++j) {
+    for (int i = 0; i <= 4; ++i) {
+      for (int k = 0; k < 3; ++k) {
+        double coordinate;
+        grid.read(reinterpret_cast<char *>(&coordinate), sizeof(double));
+        double expected = nurbs_->Evaluate({ParamCoord{i / 4.0}, ParamCoord{j / 5.0}}, {k})[0];
+        ASSERT_THAT(coordinate, DoubleNear(expected, 1e-12));
+      }
+    }
+  }
+  std::array<int64_t, 4> first_cell{};
+  grid.read(reinterpret_cast<char *>(first_cell.data()), sizeof(first_cell));
+  ASSERT_THAT(first_cell, testing::ElementsAre(0, 1, 6, 5));
+  std::ifstream step("solution_series_2.bin", std::ios::binary);
+  for (uint64_t point = 0; point < point_data.n_elem; ++point) {
+    double value;
+    step.read(reinterpret_cast<char *>(&value), sizeof(double));
+    ASSERT_THAT(value, DoubleNear(2 * point_data(point), 1e-12));
+  }
+  remove("solution_series_0.bin");
+  remove("solution_series_2.bin");
+  remove("solution_series_grid.bin");
+  remove("solution_series.xmf");
+}
+
+TEST_F(AnIGATestSpline, TestSolutionXDMFTimeSeriesWriterDistinguishesCloseTimes) { // NOLINT
+  arma::dvec solution(static_cast<uint64_t>(nurbs_->GetNumberOfControlPoints()), arma::fill::ones);
+  {
+    iga::SolutionXDMFTimeSeriesWriter<2> time_series_writer(nurbs_, {2, 2}, "solution_series");
+    time_series_writer.WriteStep(1000000, 10.0, solution);
+    time_series_writer.WriteStep(1000001, 10.00001, solution / 3);
+  }
+  std::ifstream index("solution_series.xmf");
+  std::string content((std::istreambuf_iterator<char>(index)), std::istreambuf_iterator<char>());
+  ASSERT_THAT(content, testing::HasSubstr("<Grid Name=\"step_1000000\" GridType=\"Uniform\">\n<Time Value=\"10\"/>"));
+  ASSERT_THAT(content, testing::HasSubstr("<Grid Name=\"step_1000001\" GridType=\"Uniform\">\n"
+                                          "<Time Value=\"10.00001\"/>"));
+  ASSERT_THAT(content, testing::HasSubstr("</Grid>\n</Domain>\n</Xdmf>\n"));
+  remove("solution_series_1000000.bin");
+  remove("solution_series_1000001.bin");
+  remove("solution_series_grid.bin");
+  remove("solution_series.xmf");
+}
+
 // The tests below compute the solution of Laplace's equation on a line and inside a cube.
 
 /*class ALine : public Test {
@@ -0,0 +1,148 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <armadillo>
+
+#include "gmock/gmock.h"
+#include "hierarchical_poisson_problem.h"
+#include "poisson_problem.h"
+#include "test_spline.h"
+#include "truncated_hierarchical_space.h"
+
+using testing::DoubleNear;
+using testing::Eq;
+using testing::Lt;
+
+class ATruncatedHierarchicalSpace : public AnIGATestSpline2 {
+ protected:
+  std::shared_ptr<spl::NURBS<2>> GetUniformlyRefinedSpline() {
+    auto refined = std::make_shared<spl::NURBS<2>>(*nurbs_);
+    for (int d = 0; d < 2; ++d) {
+      std::vector<ParamCoord> midpoints;
+      std::shared_ptr<baf::KnotVector> knot_vector = nurbs_->GetKnotVector(d);
+      for (int k = 0; k + 1 < knot_vector->GetNumberOfKnots(); ++k) {
+        double lower = knot_vector->GetKnot(static_cast<size_t>(k)).get();
+        double upper = knot_vector->GetKnot(static_cast<size_t>(k + 1)).get();
+        if (lower != upper) midpoints.emplace_back(ParamCoord{(lower + upper) / 2});
+      }
+      refined->RefineKnots(midpoints, d);
+    }
+    return refined;
+  }
+
+  static double GetEnergy(const iga::HierarchicalPoissonProblem<2> &problem) {
+    int num_dof = problem.GetSpace()->GetNumberOfBasisFunctions();
+    auto matA = std::make_shared<arma::sp_mat>(num_dof, num_dof);
+    auto vecB = std::make_shared<arma::dvec>(num_dof, arma::fill::zeros);
+    problem.GetSystem(matA, vecB);
+    problem.SetZeroBC(matA, vecB);
+    return arma::dot(*vecB, problem.GetSteadyStateSolution());
+  }
+
+  iga::TruncatedHierarchicalSpace<2> space = iga::TruncatedHierarchicalSpace<2>(nurbs_);
+};
+
+TEST_F(ATruncatedHierarchicalSpace, EqualsTheSplineWithoutRefinement) { // NOLINT
+  ASSERT_THAT(space.GetNumberOfLevels(), Eq(1));
+  ASSERT_THAT(space.GetNumberOfBasisFunctions(), Eq(n));
+  ASSERT_THAT(space.GetBoundaryIndices(), Eq(linear_equation_assembler.GetBoundaryIndices()));
+  for (int e = 0; e < space.GetNumberOfElements(); ++e) {
+    std::vector<arma::uword> global_indices = elm_itg_calc.GetGlobalIndices(e);
+    const std::vector<arma::uword> &space_indices = space.GetGlobalIndices(e);
+    ASSERT_THAT(space_indices.size(), Eq(global_indices.size()));
+    const arma::dmat &extraction = space.GetExtractionMatrix(e);
+    for (uint64_t j = 0; j < global_indices.size(); ++j) {
+      auto row = std::find(space_indices.begin(), space_indices.end(), global_indices[j]) - space_indices.begin();
+      ASSERT_THAT(extraction(static_cast<uint64_t>(row), j), DoubleNear(1, 1e-14));
+    }
+  }
+}
+
+TEST_F(ATruncatedHierarchicalSpace, FormsPartitionOfUnityAfterLocalRefinement) { // NOLINT
+  int num_elements = space.GetNumberOfElements();
+  space.Refine({0});
+  space.Refine({num_elements - 1});
+  ASSERT_THAT(space.GetNumberOfLevels(), Eq(3));
+  ASSERT_THAT(space.GetNumberOfElements(), Eq(num_elements + 6));
+  for (int e = 0; e < space.GetNumberOfElements(); ++e) {
+    const arma::dmat &extraction = space.GetExtractionMatrix(e);
+    arma::dvec sums = extraction.t() * arma::dvec(extraction.n_rows, arma::fill::ones);
+    for (uint64_t j = 0; j < sums.n_elem; ++j) {
+      ASSERT_THAT(sums(j), DoubleNear(1, 1e-12));
+    }
+  }
+}
+
+TEST_F(ATruncatedHierarchicalSpace, ReturnsElementBoundsOfChildren) { // NOLINT
+  std::array<std::array<double, 2>, 2> parent = space.GetElementBounds(0);
+  space.Refine({0});
+  std::array<std::array<double, 2>, 2> child = space.GetElementBounds(space.GetNumberOfElements() - 4);
+  for (int d = 0; d < 2; ++d) {
+    ASSERT_THAT(child[d][0], DoubleNear(parent[d][0], 1e-14));
+    ASSERT_THAT(child[d][1], DoubleNear((parent[d][0] + parent[d][1]) / 2, 1e-14));
+  }
+}
+
+TEST_F(ATruncatedHierarchicalSpace, EvaluatesLevelBasisLikeTheRefinedSpline) { // NOLINT
+  std::vector<int> elements;
+  for (int e = 0; e < space.GetNumberOfElements(); ++e) {
+    elements.emplace_back(e);
+  }
+  space.Refine(elements);
+  iga::ElementIntegralCalculator<2> refined_elm_itg_calc(GetUniformlyRefinedSpline());
+  for (int e = 0; e < space.GetNumberOfElements(); ++e) {
+    auto basis = space.GetElementBasis(e, rule);
+    auto expected = refined_elm_itg_calc.GetElementBasis(e, rule);
+    ASSERT_THAT(basis.global_indices, Eq(expected.global_indices));
+    arma::dmat element_matrix = iga::ElementIntegralCalculator<2>::GetLaplaceElementMatrixSumFactorized(basis);
+    arma::dmat expected_matrix = refined_elm_itg_calc.GetLaplaceElementMatrixSumFactorized(expected);
+    for (uint64_t j = 0; j < expected_matrix.n_rows; ++j) {
+      for (uint64_t k = 0; k < expected_matrix.n_cols; ++k) {
+        ASSERT_THAT(element_matrix(j, k), DoubleNear(expected_matrix(j, k), 1e-12));
+      }
+    }
+  }
+}
+
+TEST_F(ATruncatedHierarchicalSpace, EqualsUniformRefinementIfAllElementsAreRefined) { // NOLINT
+  iga::HierarchicalPoissonProblem<2> hierarchical_problem(nurbs_, rule);
+  std::vector<int> elements;
+  for (int e = 0; e < hierarchical_problem.GetSpace()->GetNumberOfElements(); ++e) {
+    elements.emplace_back(e);
+  }
+  hierarchical_problem.Refine(elements);
+  std::shared_ptr<spl::NURBS<2>> refined = GetUniformlyRefinedSpline();
+  ASSERT_THAT(hierarchical_problem.GetSpace()->GetNumberOfBasisFunctions(), Eq(refined->GetNumberOfControlPoints()));
+  arma::dvec expected = iga::PoissonProblem<2>(refined, rule).GetSteadyStateSolution();
+  arma::dvec solution = hierarchical_problem.GetSteadyStateSolution();
+  for (uint64_t i = 0; i < expected.n_elem; ++i) {
+    ASSERT_THAT(solution(i), DoubleNear(expected(i), 1e-10));
+  }
+}
+
+TEST_F(ATruncatedHierarchicalSpace, LiesBetweenCoarseAndFineSpaceAfterLocalRefinement) { // NOLINT
+  iga::HierarchicalPoissonProblem<2> coarse(nurbs_, rule), local(nurbs_, rule), fine(nurbs_, rule);
+  std::vector<int> all_elements;
+  for (int e = 0; e < coarse.GetSpace()->GetNumberOfElements(); ++e) {
+    all_elements.emplace_back(e);
+  }
+  fine.Refine(all_elements);
+  local.Refine({0, 1});
+  ASSERT_THAT(local.GetSpace()->GetNumberOfBasisFunctions(), Lt(fine.GetSpace()->GetNumberOfBasisFunctions()));
+  double coarse_energy = GetEnergy(coarse);
+  double local_energy = GetEnergy(local);
+  double fine_energy = GetEnergy(fine);
+  ASSERT_THAT(coarse_energy, Lt(local_energy));
+  ASSERT_THAT(local_energy, Lt(fine_energy));
+}
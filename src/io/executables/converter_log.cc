@@ -22,9 +22,9 @@ You should have received a copy of the GNU Lesser General Public License along w
 #include "system_operations.h"
 #include "vector_utils.h"
 
-io::ConverterLog::ConverterLog() : log_file_("") {}
+io::ConverterLog::ConverterLog() : log_file_(""), binary_(false) {}
 
-io::ConverterLog::ConverterLog(const char *log_file) : log_file_(log_file) {
+io::ConverterLog::ConverterLog(const char *log_file) : log_file_(log_file), binary_(false) {
   std::ifstream log;
   log.open(log_file);
   if (!log.good()) {
@@ -39,7 +39,7 @@ io::ConverterLog::ConverterLog(const char *log_file) : log_file_(log_file) {
       getline(log, output_);
     }
     if (util::StringOperations::StartsWith(line, "options:")) {
-      while (getline(log, line) && !util::StringOperations::EndsWith(util::StringOperations::trim(line), ":")) {
+      while (getline(log, line) && !IsEndOfSection(line)) {
         if (line == "all") {
           positions_.clear();
           positions_.emplace_back(-1);
@@ -49,11 +49,16 @@ io::ConverterLog::ConverterLog(const char *log_file) : log_file_(log_file) {
       }
     }
     if (util::StringOperations::StartsWith(line, "scattering:")) {
-      while (getline(log, line) && !util::StringOperations::EndsWith(util::StringOperations::trim(line), ":")) {
+      while (getline(log, line) && !IsEndOfSection(line)) {
         std::vector<std::string> strings = util::StringOperations::split(line, ' ');
         scattering_.emplace_back(util::StringOperations::StringVectorToNumberVector<int>(strings));
       }
     }
+    if (util::StringOperations::StartsWith(line, "format:")) {
+      std::string format;
+      getline(log, format);
+      binary_ = util::StringOperations::trim(format) == "binary";
+    }
   }
 }
 
@@ -65,6 +70,10 @@ const char *io::ConverterLog::GetOutput() const {
   return output_.c_str();
 }
 
+bool io::ConverterLog::IsBinary() const {
+  return binary_;
+}
+
 std::vector<int> io::ConverterLog::GetPositions(std::vector<int> possible_positions) {
   if (positions_[0] == -1) {
     written_ = possible_positions;
@@ -119,10 +128,19 @@ void io::ConverterLog::PrintHelp() const {
             << "If this is a converter to VTK format, the log file has to expanded by the following entry:" << std::endl
             << "scattering:\n# scattering for each spline separated by line breaks and for each dimension separated "
             << "by spaces\n" << std::endl
+            << "The data of VTK files is written as text unless the log file contains the following entry:" << std::endl
+            << "format:\n# 'binary' for binary data, 'ascii' for text\n" << std::endl
+            << "Files ending with '.vtu' are written in the XML format of VTK with raw binary data.\n" << std::endl
             << "The log file is expanded by a log entry if converting succeed:" << std::endl
             << "log:\n# time date\n# spline positions in input file that have been written to output file.\n";
 }
 
+// A section ends with an empty line or with the header of the next section.
+bool io::ConverterLog::IsEndOfSection(const std::string &line) {
+  std::string trimmed = util::StringOperations::trim(line);
+  return trimmed.empty() || util::StringOperations::EndsWith(trimmed, ":");
+}
+
 std::string io::ConverterLog::GetTime() const {
   struct tm timeinfo = util::SystemOperations::GetTime();
   return asctime(&timeinfo);
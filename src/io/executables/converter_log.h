@@ -25,6 +25,8 @@ class ConverterLog {
 
   const char *GetInput() const;
   const char *GetOutput() const;
+  // Returns whether the data of VTK files is to be written as binary data instead of text.
+  bool IsBinary() const;
   std::vector<int> GetPositions(std::vector<int> possible_positions);
   std::vector<std::vector<int>> GetScattering();
 
@@ -32,6 +34,7 @@ class ConverterLog {
   void PrintHelp() const;
 
  private:
+  static bool IsEndOfSection(const std::string &line);
   std::string GetTime() const;
   bool OneSpline() const;
 
@@ -42,6 +45,7 @@ class ConverterLog {
   std::vector<int> written_;
   std::vector<int> not_written_;
   std::vector<std::vector<int>> scattering_;
+  bool binary_;
 };
 }  // namespace io
 
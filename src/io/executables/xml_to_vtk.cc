@@ -40,7 +40,7 @@ int main(int argc, char *argv[]) {
     throw std::runtime_error(R"(The input file isn't of correct ".xml" format.)");
   }
 
-  io::VTKWriter vtk_writer;
+  io::VTKWriter vtk_writer(io::VTKWriter::GetFormat(log.GetOutput(), log.IsBinary()));
   std::vector<int> positions = log.GetPositions(io::IOConverter::GetSplinePositionsOfCorrectDimension(splines, 3));
   std::vector<std::vector<int>> scattering = log.GetScattering();
   std::vector<std::any> splines_with_max_dim = util::VectorUtils<std::any>::FilterVector(splines, positions);
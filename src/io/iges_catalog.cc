@@ -0,0 +1,159 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "iges_catalog.h"
+
+#include <stdexcept>
+
+#include "iges_reader.h"
+#include "parallel_operations.h"
+#include "string_operations.h"
+
+io::IGESCatalog::IGESCatalog(const char *filename) : filename_(filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.good()) {
+    throw std::runtime_error("IGES file could not be opened.");
+  }
+  std::string line;
+  std::string first_directory_record;
+  bool first_record_read = false;
+  std::streamoff line_start = file.tellg();
+  while (getline(file, line)) {
+    if (line.size() > 72 && line[72] == 'P') {
+      parameter_section_start_ = line_start;
+      record_length_ = static_cast<std::streamoff>(file.tellg()) - line_start;
+      break;
+    }
+    if (line.size() > 72 && line[72] == 'D') {
+      if (first_record_read) {
+        entities_.emplace_back(GetEntity(first_directory_record, line));
+      } else {
+        first_directory_record = line;
+      }
+      first_record_read = !first_record_read;
+    }
+    line_start = file.tellg();
+  }
+}
+
+const std::vector<io::IGESCatalog::Entity> &io::IGESCatalog::GetEntities() const {
+  return entities_;
+}
+
+std::vector<int> io::IGESCatalog::GetSplineEntities() const {
+  std::vector<int> spline_entities;
+  for (int i = 0; i < static_cast<int>(entities_.size()); ++i) {
+    if (entities_[i].entity_type == 126 || entities_[i].entity_type == 128) spline_entities.emplace_back(i);
+  }
+  return spline_entities;
+}
+
+std::any io::IGESCatalog::GetSpline(int entity) const {
+  std::ifstream file(filename_, std::ios::binary);
+  return GetSpline(&file, entity);
+}
+
+std::vector<std::any> io::IGESCatalog::GetSplines(const std::vector<int> &entities, int number_of_threads) const {
+  std::vector<std::any> splines(entities.size());
+  auto number_of_entities = static_cast<int>(entities.size());
+  util::ParallelOperations::ForEachRange(number_of_entities, number_of_threads, [&](int first, int last) {
+    std::ifstream file(filename_, std::ios::binary);
+    for (int i = first; i < last; ++i) {
+      splines[i] = GetSpline(&file, entities[i]);
+    }
+  });
+  return splines;
+}
+
+io::IGESCatalog::Entity io::IGESCatalog::GetEntity(std::string_view first_record, std::string_view second_record) {
+  Entity entity{};
+  entity.entity_type = GetField(first_record, 1);
+  entity.parameter_data_start = GetField(first_record, 2);
+  entity.parameter_data_line_count = GetField(second_record, 4);
+  entity.form = GetField(second_record, 5);
+  return entity;
+}
+
+std::any io::IGESCatalog::GetSpline(std::ifstream *file, int entity) const {
+  const Entity &catalog_entity = entities_.at(static_cast<size_t>(entity));
+  if (catalog_entity.entity_type != 126 && catalog_entity.entity_type != 128) {
+    throw std::runtime_error("Only IGES entities of type 126 and 128 can be converted to splines.");
+  }
+  return io::IGESReader::CreateSpline(
+      util::StringOperations::DelimitedStringToVector(GetParameterData(file, catalog_entity)));
+}
+
+std::string io::IGESCatalog::GetParameterData(std::ifstream *file, const Entity &entity) const {
+  if (parameter_section_start_ < 0 || entity.parameter_data_start < 1) {
+    throw std::runtime_error("The parameter data of an IGES entity is out of the parameter data section.");
+  }
+  std::string parameter_data;
+  if (ReadFixedLengthRecords(file, entity, &parameter_data)) return parameter_data;
+  std::call_once(index_flag_, [this]() {
+    std::ifstream index_file(filename_, std::ios::binary);
+    IndexParameterRecords(&index_file);
+  });
+  auto first = static_cast<size_t>(entity.parameter_data_start - 1);
+  if (first + entity.parameter_data_line_count > record_offsets_.size()) {
+    throw std::runtime_error("The parameter data of an IGES entity is out of the parameter data section.");
+  }
+  file->clear();
+  std::string line;
+  for (size_t i = first; i < first + entity.parameter_data_line_count; ++i) {
+    file->seekg(record_offsets_[i]);
+    getline(*file, line);
+    parameter_data.append(line, 0, 64);
+  }
+  return parameter_data;
+}
+
+// Reads the records of the entity with one read, assuming that all parameter records have the length of the first.
+bool io::IGESCatalog::ReadFixedLengthRecords(std::ifstream *file, const Entity &entity,
+                                             std::string *parameter_data) const {
+  std::string records(static_cast<size_t>(entity.parameter_data_line_count * record_length_), ' ');
+  file->clear();
+  file->seekg(parameter_section_start_ + (entity.parameter_data_start - 1) * record_length_);
+  file->read(records.data(), static_cast<std::streamsize>(records.size()));
+  if (file->gcount() != static_cast<std::streamsize>(records.size())) return false;
+  for (int i = 0; i < entity.parameter_data_line_count; ++i) {
+    std::string_view record(records.data() + i * record_length_, static_cast<size_t>(record_length_));
+    if (record.size() < 80 || record[72] != 'P' || GetSequenceNumber(record) != entity.parameter_data_start + i) {
+      parameter_data->clear();
+      return false;
+    }
+    parameter_data->append(record.substr(0, 64));
+  }
+  return true;
+}
+
+void io::IGESCatalog::IndexParameterRecords(std::ifstream *file) const {
+  file->seekg(parameter_section_start_);
+  std::string line;
+  std::streamoff line_start = parameter_section_start_;
+  while (getline(*file, line) && line.size() > 72 && line[72] == 'P') {
+    record_offsets_.emplace_back(line_start);
+    line_start = file->tellg();
+  }
+}
+
+// Returns the integer in the given field (counted from one) of a directory entry record. Empty fields default to zero.
+int io::IGESCatalog::GetField(std::string_view record, int field) {
+  std::string_view value = util::StringOperations::TrimView(record.substr(static_cast<size_t>(8 * (field - 1)), 8));
+  return value.empty() ? 0 : static_cast<int>(util::StringOperations::StringToDouble(value));
+}
+
+int io::IGESCatalog::GetSequenceNumber(std::string_view record) {
+  std::string_view value = util::StringOperations::TrimView(record.substr(73, 7));
+  return value.empty() ? 0 : static_cast<int>(util::StringOperations::StringToDouble(value));
+}
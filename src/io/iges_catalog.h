@@ -0,0 +1,75 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IO_IGES_CATALOG_H_
+#define SRC_IO_IGES_CATALOG_H_
+
+#include <any>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace io {
+// Index of the entities of an IGES file. Only the start, global and directory entry sections are read on
+// construction; the parameter data of an entity is read from the file when its spline is requested. The parameter
+// records are located by their fixed length, which is checked against their sequence numbers, and indexed by a single
+// scan of the parameter data section only if the records do not have the same length.
+class IGESCatalog {
+ public:
+  // The fields of a directory entry, which consists of two records with ten fields of eight columns each.
+  struct Entity {
+    int entity_type;
+    int form;
+    int parameter_data_start;
+    int parameter_data_line_count;
+  };
+
+  explicit IGESCatalog(const char *filename);
+
+  const std::vector<Entity> &GetEntities() const;
+
+  // Returns the indices of the rational B-spline curves (entity 126) and surfaces (entity 128).
+  std::vector<int> GetSplineEntities() const;
+
+  std::any GetSpline(int entity) const;
+
+  // Creates the splines of the given entities in their order. The entities are distributed over the given number of
+  // threads, each reading the file with its own stream. A non-positive number uses one thread per hardware thread.
+  std::vector<std::any> GetSplines(const std::vector<int> &entities, int number_of_threads = 1) const;
+
+  static Entity GetEntity(std::string_view first_record, std::string_view second_record);
+
+ private:
+  std::any GetSpline(std::ifstream *file, int entity) const;
+
+  // Returns the columns 1 to 64 of the parameter records of the entity joined to one string.
+  std::string GetParameterData(std::ifstream *file, const Entity &entity) const;
+  bool ReadFixedLengthRecords(std::ifstream *file, const Entity &entity, std::string *parameter_data) const;
+  void IndexParameterRecords(std::ifstream *file) const;
+
+  static int GetField(std::string_view record, int field);
+  static int GetSequenceNumber(std::string_view record);
+
+  std::string filename_;
+  std::vector<Entity> entities_;
+  std::streamoff parameter_section_start_ = -1;
+  std::streamoff record_length_ = 0;
+  mutable std::once_flag index_flag_;
+  mutable std::vector<std::streamoff> record_offsets_;
+};
+}  // namespace io
+
+#endif  // SRC_IO_IGES_CATALOG_H_
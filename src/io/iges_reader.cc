@@ -14,12 +14,13 @@ You should have received a copy of the GNU Lesser General Public License along w
 
 #include "iges_reader.h"
 
+#include <algorithm>
 #include <fstream>
-#include <sstream>
-#include <utility>
+#include <stdexcept>
 
 #include "b_spline.h"
 #include "nurbs.h"
+#include "parallel_operations.h"
 #include "string_operations.h"
 
 std::vector<std::any> io::IGESReader::ReadFile(const char *filename) {
@@ -29,32 +30,45 @@ std::vector<std::any> io::IGESReader::ReadFile(const char *filename) {
     throw std::runtime_error("IGES file could not be opened.");
   }
   std::string line;
-  std::vector<std::string> directoryEntrySection;
-  std::vector<std::string> parameterDataSection;
+  std::string first_directory_record;
+  bool first_record_read = false;
+  std::vector<io::IGESCatalog::Entity> entities;
+  std::string parameter_data;
+  std::vector<size_t> line_offsets = {0};
   while (getline(newFile, line)) {
+    if (line.size() <= 72) continue;
     if (line[72] == 'D') {
-      directoryEntrySection.push_back(line.substr(0, 72));
-    }
-    if (line[72] == 'P') {
-      parameterDataSection.push_back(line.substr(0, 64));
+      if (!first_record_read) {
+        first_directory_record = line;
+      } else {
+        entities.emplace_back(io::IGESCatalog::GetEntity(first_directory_record, line));
+      }
+      first_record_read = !first_record_read;
+    } else if (line[72] == 'P') {
+      parameter_data.append(line, 0, 64);
+      line_offsets.emplace_back(parameter_data.size());
     }
   }
-  std::vector<std::any> splines;
-  for (int i = 0; i < directoryEntrySection.size() * 0.5; ++i) {
-    int entityType = std::stoi(trim(directoryEntrySection[i * 2].substr(5, 3)));
-    if (entityType == 126) {
-      splines.push_back(Create1DSpline(ParameterSectionToVector(parameterDataSection,
-                                                                GetParameterSectionStartEndPointers(
-                                                                    directoryEntrySection, i))));
-    } else if (entityType == 128) {
-      splines.push_back(Create2DSpline(ParameterSectionToVector(parameterDataSection,
-                                                                GetParameterSectionStartEndPointers(
-                                                                    directoryEntrySection, i))));
+  entities.erase(std::remove_if(entities.begin(), entities.end(), [](const io::IGESCatalog::Entity &entity) {
+    return entity.entity_type != 126 && entity.entity_type != 128;
+  }), entities.end());
+  std::vector<std::any> splines(entities.size());
+  auto number_of_entities = static_cast<int>(entities.size());
+  util::ParallelOperations::ForEachRange(number_of_entities, number_of_threads_, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      splines[i] = CreateSpline(ParameterDataToVector(parameter_data, line_offsets, entities[i]));
     }
-  }
+  });
   return splines;
 }
 
+std::any io::IGESReader::CreateSpline(const std::vector<double> &parameter_data) {
+  if (parameter_data.empty() || (parameter_data[0] != 126 && parameter_data[0] != 128)) {
+    throw std::runtime_error("Only IGES entities of type 126 and 128 can be converted to splines.");
+  }
+  return parameter_data[0] == 126 ? Create1DSpline(parameter_data) : Create2DSpline(parameter_data);
+}
+
 std::any io::IGESReader::Create1DSpline(const std::vector<double> &parameterData) {
   auto upperSumIndex = static_cast<int>(parameterData[1]);
   std::array<Degree, 1> degree{};
@@ -154,28 +168,16 @@ std::any io::IGESReader::Create2DSpline(const std::vector<double> &parameterData
   return std::make_any<std::shared_ptr<spl::NURBS<2>>>(spl);
 }
 
-std::array<int, 2> io::IGESReader::GetParameterSectionStartEndPointers(std::vector<std::string> directoryEntrySection,
-                                                                       int entityToBeRead) {
-  std::string parameterDataStartPointer = trim(directoryEntrySection[entityToBeRead * 2].substr(8, 8));
-  std::string parameterDataLineCount = trim(directoryEntrySection[entityToBeRead * 2 + 1].substr(24, 8));
-  std::array<int, 2> ParameterSectionStartEndPointers{};
-  ParameterSectionStartEndPointers[0] = std::stoi(trim(parameterDataStartPointer));
-  ParameterSectionStartEndPointers[1] =
-      std::stoi(trim(parameterDataStartPointer)) + std::stoi(trim(parameterDataLineCount)) - 1;
-  return ParameterSectionStartEndPointers;
-}
-
-std::vector<double> io::IGESReader::ParameterSectionToVector(std::vector<std::string> parameterSection,
-                                                             std::array<int, 2> ParameterSectionStartEndPointers) {
-  int first = ParameterSectionStartEndPointers[0] - 1;
-  int last = ParameterSectionStartEndPointers[1] - 1;
-  std::string temp;
-  for (int i = first; i <= last; ++i) {
-    temp.append(parameterSection[i]);
-  }
-  return util::StringOperations::DelimitedStringToVector(temp);
-}
-
-std::string io::IGESReader::trim(std::string s) {
-  return util::StringOperations::trim(std::move(s));
+// Converts the parameters of the entity in its parameter data lines, which are contiguous in the parameter data, so
+// that parameters continued on the next line are joined as well.
+std::vector<double> io::IGESReader::ParameterDataToVector(std::string_view parameter_data,
+                                                          const std::vector<size_t> &line_offsets,
+                                                          const io::IGESCatalog::Entity &entity) {
+  auto first = static_cast<size_t>(entity.parameter_data_start - 1);
+  size_t last = first + static_cast<size_t>(entity.parameter_data_line_count);
+  if (entity.parameter_data_start < 1 || last >= line_offsets.size()) {
+    throw std::runtime_error("The parameter data of an IGES entity is out of the parameter data section.");
+  }
+  return util::StringOperations::DelimitedStringToVector(
+      parameter_data.substr(line_offsets[first], line_offsets[last] - line_offsets[first]));
 }
@@ -18,28 +18,36 @@ You should have received a copy of the GNU Lesser General Public License along w
 #include <any>
 #include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "iges_catalog.h"
 #include "reader.h"
 
 namespace io {
+// Reads the rational B-spline curves (entity 126) and surfaces (entity 128) of an IGES file. The records are read once:
+// the directory entries are decoded into their fields and the parameter data of all records is kept in one string,
+// in which the parameters of each entity are converted in place. The conversion of the parameters and the construction
+// of the splines are distributed over the given number of threads, by default one per hardware thread. To read only
+// some entities of a large file, use io::IGESCatalog instead.
 class IGESReader : public Reader {
  public:
-  IGESReader() = default;
+  explicit IGESReader(int number_of_threads = 0) : number_of_threads_(number_of_threads) {}
 
   std::vector<std::any> ReadFile(const char *filename) override;
 
- private:
-  std::any Create1DSpline(const std::vector<double> &parameterData);
-  std::any Create2DSpline(const std::vector<double> &parameterData);
+  // Creates the spline of the parameter data of an entity of type 126 or 128.
+  static std::any CreateSpline(const std::vector<double> &parameter_data);
 
-  std::array<int, 2> GetParameterSectionStartEndPointers(std::vector<std::string> directoryEntrySection,
-                                                         int entityToBeRead);
+ private:
+  static std::any Create1DSpline(const std::vector<double> &parameterData);
+  static std::any Create2DSpline(const std::vector<double> &parameterData);
 
-  std::vector<double> ParameterSectionToVector(std::vector<std::string> parameterSection,
-                                               std::array<int, 2> ParameterSectionStartEndPointers);
+  static std::vector<double> ParameterDataToVector(std::string_view parameter_data,
+                                                   const std::vector<size_t> &line_offsets,
+                                                   const io::IGESCatalog::Entity &entity);
 
-  static inline std::string trim(std::string s);
+  int number_of_threads_;
 };
 }  // namespace io
 
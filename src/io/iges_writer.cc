@@ -14,12 +14,12 @@ You should have received a copy of the GNU Lesser General Public License along w
 
 #include "iges_writer.h"
 
-#include <iomanip>
 #include <limits>
-#include <sstream>
+#include <type_traits>
 
 #include "any_casts.h"
 #include "multi_index_handler.h"
+#include "string_operations.h"
 #include "system_operations.h"
 
 void io::IGESWriter::WriteFile(const std::vector<std::any> &splines, const char *filename) const {
@@ -273,10 +273,11 @@ std::string io::IGESWriter::GetBlock(const std::string &str, int width, bool rig
 
 template<typename T>
 std::string io::IGESWriter::GetString(const T value) const {
-  std::ostringstream out;
-  out.precision(18);
-  out << value;
-  return out.str();
+  if constexpr (std::is_floating_point_v<T>) {
+    return util::StringOperations::DoubleToString(value);
+  } else {
+    return std::to_string(value);
+  }
 }
 
 void io::IGESWriter::WriteFile(std::ofstream &file,
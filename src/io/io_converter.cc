@@ -14,11 +14,12 @@ You should have received a copy of the GNU Lesser General Public License along w
 
 #include "io_converter.h"
 
-io::IOConverter::IOConverter(const char *input_filename, const char *output_filename)
+io::IOConverter::IOConverter(const char *input_filename, const char *output_filename, bool binary)
     : input_filename_(input_filename),
       output_filename_(output_filename),
       input_format_(GetFileFormat(input_filename)),
-      output_format_(GetFileFormat(output_filename)) {}
+      output_format_(GetFileFormat(output_filename)),
+      binary_(binary) {}
 
 std::vector<int> io::IOConverter::ConvertFile(const std::vector<int> &positions,
                                               const std::vector<std::vector<int>> &scattering) {
@@ -45,7 +46,7 @@ io::IOConverter::file_format io::IOConverter::GetFileFormat(const char *filename
   if (util::StringOperations::EndsWith(filename, ".itd")) {
     return irit;
   }
-  if (util::StringOperations::EndsWith(filename, ".vtk")) {
+  if (util::StringOperations::EndsWith(filename, ".vtk") || util::StringOperations::EndsWith(filename, ".vtu")) {
     return vtk;
   }
   if (util::StringOperations::EndsWith(filename, ".xml")) {
@@ -76,7 +77,7 @@ void io::IOConverter::GetWriter(const std::vector<std::any> &splines, const std:
     std::shared_ptr<io::IRITWriter> ptr = std::make_shared<io::IRITWriter>(io::IRITWriter());
     WriteFile(splines, positions, 3, std::dynamic_pointer_cast<io::Writer>(ptr));
   } else if (output_format_ == vtk) {
-    std::shared_ptr<io::VTKWriter> ptr = std::make_shared<io::VTKWriter>(io::VTKWriter());
+    auto ptr = std::make_shared<io::VTKWriter>(io::VTKWriter::GetFormat(output_filename_, binary_));
     GetPositions(positions, GetSplinePositionsOfCorrectDimension(splines, 3));
     std::vector<std::any> splines_with_max_dim = util::VectorUtils<std::any>::FilterVector(splines, written_);
     ptr->WriteFile(splines_with_max_dim, output_filename_, GetScattering(scattering, positions, written_));
@@ -84,7 +85,7 @@ void io::IOConverter::GetWriter(const std::vector<std::any> &splines, const std:
     std::shared_ptr<io::XMLWriter> ptr = std::make_shared<io::XMLWriter>(io::XMLWriter());
     WriteFile(splines, positions, 4, std::dynamic_pointer_cast<io::Writer>(ptr));
   } else {
-    throw std::runtime_error(R"(Only files of format ".iges", ".itd", ".vtk" and ".xml" can be written.)");
+    throw std::runtime_error(R"(Only files of format ".iges", ".itd", ".vtk", ".vtu" and ".xml" can be written.)");
   }
 }
 
@@ -30,9 +30,11 @@ You should have received a copy of the GNU Lesser General Public License along w
 #include "xml_writer.h"
 
 namespace io {
+// Converts the splines of a file into another format given by the file name extensions. The data of VTK files is
+// written as binary data if binary is true; files ending with ".vtu" are always written with raw binary data.
 class IOConverter {
  public:
-  IOConverter(const char *input_filename, const char *output_filename);
+  IOConverter(const char *input_filename, const char *output_filename, bool binary = false);
 
   std::vector<int> ConvertFile(const std::vector<int> &positions = {},
                                const std::vector<std::vector<int>> &scattering = {});
@@ -59,6 +61,7 @@ class IOConverter {
   const char *output_filename_;
   file_format input_format_;
   file_format output_format_;
+  bool binary_;
   std::vector<int> written_;
 };
 }  // namespace io
@@ -16,36 +16,36 @@ You should have received a copy of the GNU Lesser General Public License along w
 #define SRC_IO_IRIT_READER_H_
 
 #include <any>
-#include <string>
+#include <ios>
+#include <string_view>
 #include <vector>
 
 #include "b_spline.h"
 #include "reader.h"
+#include "stream_tokenizer.h"
 
 namespace io {
+// Reads the B-spline curves, surfaces and trivariates of an IRIT file. A first pass over the tokens only records the
+// dimension and the file offset of each spline block. The blocks are then parsed and their splines built concurrently
+// on the given number of threads, by default one per hardware thread, each streaming its blocks from the file with its
+// own tokenizer, so that only the tokens of one spline per thread are held in memory at a time.
 class IRITReader : public Reader {
  public:
-  IRITReader() = default;
+  explicit IRITReader(int number_of_threads = 0) : number_of_threads_(number_of_threads) {}
 
   std::vector<std::any> ReadFile(const char *filename) override;
 
  private:
-  std::vector<int> GetSplinePositions(const std::vector<std::string> &entries) const;
+  struct SplineBlock {
+    int dimension;
+    std::streamoff offset;
+  };
 
-  static int GetDimension(const std::string &type);
+  static std::vector<SplineBlock> FindSplineBlocks(const char *filename);
+  static std::any ReadSpline(io::StreamTokenizer *tokenizer, const SplineBlock &block);
+  static int GetDimension(std::string_view type);
 
-  std::any Get1DSpline(int start, const std::vector<std::string> &entries) const;
-  std::any Get2DSpline(int start, const std::vector<std::string> &entries) const;
-  std::any Get3DSpline(int start, const std::vector<std::string> &entries) const;
-
-  static int GetNumberOfControlPoints(int start, const std::vector<std::string> &entries);
-
-  std::vector<baf::ControlPoint> GetControlPoints(int start, const std::vector<std::string> &entries,
-                                                  bool rational, std::vector<double> weights) const;
-
-  std::vector<double> GetWeights(int start, const std::vector<std::string> &entries, bool rational) const;
-
-  int GetPositionOfFirstControlPoint(int start, const std::vector<std::string> &entries) const;
+  int number_of_threads_;
 };
 }  // namespace io
 
@@ -15,43 +15,88 @@ You should have received a copy of the GNU Lesser General Public License along w
 #ifndef SRC_IO_IRIT_READER_UTILS_H_
 #define SRC_IO_IRIT_READER_UTILS_H_
 
-#include <string>
+#include <any>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
 #include <vector>
 
 #include "b_spline.h"
 #include "nurbs.h"
+#include "stream_tokenizer.h"
 #include "string_operations.h"
 
 namespace io {
 class IRITReaderUtils {
  public:
+  // Reads the block of a spline following its BSPLINE token: the numbers of control points and the orders in each
+  // parametric direction, the point type, the knot vectors and the control points. Rational control points are given
+  // as [w w*x w*y ...].
   template<int DIM>
-  static std::array<Degree, DIM> GetDegrees(int start, const std::vector<std::string> &entries) {
+  static std::any ReadSpline(io::StreamTokenizer *tokenizer) {
+    int number_of_control_points = 1;
+    for (int i = 0; i < DIM; i++) {
+      number_of_control_points *= GetInteger(NextToken(tokenizer));
+    }
     std::array<Degree, DIM> degrees;
     for (int i = 0; i < DIM; i++) {
-      degrees[i] =
-          Degree(util::StringOperations::StringVectorToNumberVector<int>({entries[start + DIM + 2 + i]})[0] - 1);
+      degrees[i] = Degree(GetInteger(NextToken(tokenizer)) - 1);
     }
-    return degrees;
-  }
-
-  template<int DIM>
-  static KnotVectors<DIM> GetKnotVectors(int start, const std::vector<std::string> &entries) {
+    bool rational = util::StringOperations::StartsWith(NextToken(tokenizer), "P");
     KnotVectors<DIM> knot_vectors;
     for (int i = 0; i < DIM; i++) {
-      while (!util::StringOperations::StartsWith(entries[start++], "[KV")) {}
+      while (!util::StringOperations::StartsWith(NextToken(tokenizer), "[KV")) {}
       std::vector<ParamCoord> knots;
-      while (!util::StringOperations::StartsWith(entries[start], "[")) {
-        knots.emplace_back(util::StringOperations::StringToDouble(util::StringOperations::trim(entries[start++])));
-      }
+      ReadBracketedValues(tokenizer, NextToken(tokenizer), &knots);
       knot_vectors[i] = std::make_shared<baf::KnotVector>(knots);
     }
-    return knot_vectors;
+    std::vector<double> weights(static_cast<size_t>(number_of_control_points), 1.0);
+    std::vector<baf::ControlPoint> control_points;
+    std::vector<double> values;
+    for (int i = 0; i < number_of_control_points; i++) {
+      values.clear();
+      ReadBracketedValues(tokenizer, NextToken(tokenizer), &values);
+      if (rational) {
+        if (values.size() < 2) {
+          throw std::runtime_error("A rational IRIT control point needs a weight and coordinates.");
+        }
+        weights[i] = values.front();
+        values.erase(values.begin());
+        for (double &value : values) {
+          value /= weights[i];
+        }
+      }
+      control_points.emplace_back(values);
+    }
+    if (!rational) {
+      return std::make_any<std::shared_ptr<spl::BSpline<DIM>>>(
+          std::make_shared<spl::BSpline<DIM>>(knot_vectors, degrees, control_points));
+    }
+    return std::make_any<std::shared_ptr<spl::NURBS<DIM>>>(
+        std::make_shared<spl::NURBS<DIM>>(knot_vectors, degrees, control_points, weights));
   }
 
-  template<int DIM>
-  static bool IsRational(int start_of_spline, const std::vector<std::string> &entries) {
-    return util::StringOperations::StartsWith(entries[start_of_spline + 2 * DIM + 2], "P");
+ private:
+  static std::string_view NextToken(io::StreamTokenizer *tokenizer) {
+    std::string_view token;
+    if (!tokenizer->Next(&token)) throw std::runtime_error("The IRIT file ends within a spline.");
+    return token;
+  }
+
+  static int GetInteger(std::string_view token) {
+    return static_cast<int>(util::StringOperations::StringToDouble(token));
+  }
+
+  // Appends the values from the given token up to the token ending with ']'.
+  template<class T>
+  static void ReadBracketedValues(io::StreamTokenizer *tokenizer, std::string_view token, std::vector<T> *values) {
+    while (true) {
+      std::string_view value = util::StringOperations::TrimView(token);
+      if (!value.empty()) values->emplace_back(util::StringOperations::StringToDouble(value));
+      if (util::StringOperations::EndsWith(token, "]")) return;
+      token = NextToken(tokenizer);
+    }
   }
 };
 }  // namespace io
@@ -20,6 +20,7 @@ You should have received a copy of the GNU Lesser General Public License along w
 #include "any_casts.h"
 #include "b_spline.h"
 #include "nurbs.h"
+#include "string_operations.h"
 
 namespace io {
 template<int DIM>
@@ -48,8 +49,8 @@ class IRITWriterUtils {
       string += "      [KV ";
       std::shared_ptr<baf::KnotVector> knot_vector = spline->GetKnotVector(dimension);
       for (size_t knot = 0; knot < knot_vector->GetNumberOfKnots(); knot++) {
-        string += std::to_string(knot_vector->GetKnot(knot).get()) +
-            (knot < knot_vector->GetNumberOfKnots() - 1 ? " " : "]\n");
+        util::StringOperations::AppendShortest(&string, knot_vector->GetKnot(knot).get());
+        string += (knot < knot_vector->GetNumberOfKnots() - 1 ? " " : "]\n");
       }
     }
     return string;
@@ -64,11 +65,16 @@ class IRITWriterUtils {
       nurbs = std::any_cast<std::shared_ptr<spl::NURBS<DIM>>>(spline);
     }
     for (int control_point = 0; control_point < point_handler.Get1DLength(); ++control_point, point_handler++) {
-      string += "      [" + (rational ? std::to_string(nurbs->GetWeight(point_handler.GetIndices())) + " " : "");
+      string += "      [";
+      if (rational) {
+        util::StringOperations::AppendShortest(&string, nurbs->GetWeight(point_handler.GetIndices()));
+        string += " ";
+      }
       for (int dimension = 0; dimension < spline_ptr->GetPointDim(); dimension++) {
-        string += std::to_string(spline_ptr->GetControlPoint(point_handler.GetIndices(), dimension)
-                                     * (rational ? nurbs->GetWeight(point_handler.GetIndices()) : 1))
-            + (dimension < spline_ptr->GetPointDim() - 1 ? " " : "]\n");
+        util::StringOperations::AppendShortest(&string,
+            spline_ptr->GetControlPoint(point_handler.GetIndices(), dimension)
+                * (rational ? nurbs->GetWeight(point_handler.GetIndices()) : 1));
+        string += (dimension < spline_ptr->GetPointDim() - 1 ? " " : "]\n");
       }
     }
     return string;
@@ -0,0 +1,73 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "mapped_file.h"
+
+#include <stdexcept>
+
+#if __has_include(<fcntl.h>) && __has_include(<sys/mman.h>) && __has_include(<sys/stat.h>) && __has_include(<unistd.h>)
+#define SRC_IO_MAPPED_FILE_SUPPORTED
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef SRC_IO_MAPPED_FILE_SUPPORTED
+io::MappedFile::MappedFile(const char *filename) {
+  int file_descriptor = open(filename, O_RDONLY);
+  if (file_descriptor < 0) {
+    throw std::runtime_error("File could not be opened.");
+  }
+  struct stat file_status{};
+  if (fstat(file_descriptor, &file_status) != 0) {
+    close(file_descriptor);
+    throw std::runtime_error("File could not be opened.");
+  }
+  size_ = static_cast<std::size_t>(file_status.st_size);
+  if (size_ > 0) {
+    data_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, file_descriptor, 0);
+  }
+  close(file_descriptor);
+  if (data_ == MAP_FAILED) {
+    throw std::runtime_error("File could not be mapped into memory.");
+  }
+}
+
+io::MappedFile::~MappedFile() {
+  if (data_ != nullptr) munmap(data_, size_);
+}
+
+bool io::MappedFile::IsSupported() {
+  return true;
+}
+#else
+io::MappedFile::MappedFile(const char *) {
+  throw std::runtime_error("Files cannot be mapped into memory on this platform.");
+}
+
+io::MappedFile::~MappedFile() = default;
+
+bool io::MappedFile::IsSupported() {
+  return false;
+}
+#endif
+
+char *io::MappedFile::GetData() {
+  return static_cast<char *>(data_);
+}
+
+std::size_t io::MappedFile::GetSize() const {
+  return size_;
+}
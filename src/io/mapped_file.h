@@ -0,0 +1,44 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IO_MAPPED_FILE_H_
+#define SRC_IO_MAPPED_FILE_H_
+
+#include <cstddef>
+
+namespace io {
+// Maps a file privately into memory with read and write access. The pages are only read from the file when they are
+// accessed and are only copied when they are written to, which leaves the file unchanged. This allows parsers to work
+// in place on the contents of a file without a separate copy of it. Mapping requires the POSIX calls open, fstat and
+// mmap; on platforms without them IsSupported returns false and the constructor throws.
+class MappedFile {
+ public:
+  explicit MappedFile(const char *filename);
+  MappedFile(const MappedFile &other) = delete;
+  MappedFile &operator=(const MappedFile &other) = delete;
+  ~MappedFile();
+
+  // Returns nullptr for an empty file.
+  char *GetData();
+  std::size_t GetSize() const;
+
+  static bool IsSupported();
+
+ private:
+  void *data_ = nullptr;
+  std::size_t size_ = 0;
+};
+}  // namespace io
+
+#endif  // SRC_IO_MAPPED_FILE_H_
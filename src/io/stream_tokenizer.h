@@ -0,0 +1,104 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IO_STREAM_TOKENIZER_H_
+#define SRC_IO_STREAM_TOKENIZER_H_
+
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+namespace io {
+// Splits a text file into whitespace separated tokens in a single pass. The file is read in chunks into one buffer,
+// which only grows if a single token is longer than a chunk, so that the memory needed does not depend on the size of
+// the file. The tokens are views into the buffer and stay valid until the next call of Next or Seek.
+class StreamTokenizer {
+ public:
+  explicit StreamTokenizer(const char *filename, std::size_t chunk_size = 1u << 16u)
+      : file_(filename, std::ios::binary), buffer_(std::max(chunk_size, std::size_t{1})) {}
+
+  bool IsOpen() const {
+    return file_.good();
+  }
+
+  // Returns false if there are no more tokens.
+  bool Next(std::string_view *token) {
+    while (true) {
+      while (begin_ < end_ && IsWhitespace(buffer_[begin_])) ++begin_;
+      if (begin_ < end_) break;
+      if (!Fill()) return false;
+    }
+    std::size_t length = 0;
+    while (true) {
+      while (begin_ + length < end_ && !IsWhitespace(buffer_[begin_ + length])) ++length;
+      if (begin_ + length < end_ || !Fill()) break;
+    }
+    *token = std::string_view(buffer_.data() + begin_, length);
+    begin_ += length;
+    return true;
+  }
+
+  // Returns the offset in the file behind the last token.
+  std::streamoff GetOffset() const {
+    return buffer_offset_ + static_cast<std::streamoff>(begin_);
+  }
+
+  // Continues with the token at or behind the given offset. The file is only read again if the offset is not in the
+  // buffer, so that seeking forward to nearby offsets is cheap.
+  void Seek(std::streamoff offset) {
+    if (offset >= buffer_offset_ && offset <= buffer_offset_ + static_cast<std::streamoff>(end_)) {
+      begin_ = static_cast<std::size_t>(offset - buffer_offset_);
+      return;
+    }
+    file_.clear();
+    file_.seekg(offset);
+    buffer_offset_ = offset;
+    begin_ = 0;
+    end_ = 0;
+    end_of_file_ = false;
+  }
+
+ private:
+  static bool IsWhitespace(char character) {
+    return character == ' ' || character == '\n' || character == '\r' || character == '\t' || character == '\f' ||
+        character == '\v';
+  }
+
+  // Moves the unread characters to the front of the buffer and appends the next chunk of the file.
+  bool Fill() {
+    if (end_of_file_) return false;
+    std::copy(buffer_.begin() + begin_, buffer_.begin() + end_, buffer_.begin());
+    buffer_offset_ += static_cast<std::streamoff>(begin_);
+    end_ -= begin_;
+    begin_ = 0;
+    if (end_ == buffer_.size()) buffer_.resize(2 * buffer_.size());
+    file_.read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+    auto count = static_cast<std::size_t>(file_.gcount());
+    end_ += count;
+    if (count == 0) end_of_file_ = true;
+    return count > 0;
+  }
+
+  std::ifstream file_;
+  std::vector<char> buffer_;
+  // The offset in the file of the first character in the buffer.
+  std::streamoff buffer_offset_ = 0;
+  std::size_t begin_ = 0;
+  std::size_t end_ = 0;
+  bool end_of_file_ = false;
+};
+}  // namespace io
+
+#endif  // SRC_IO_STREAM_TOKENIZER_H_
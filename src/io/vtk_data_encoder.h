@@ -0,0 +1,99 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_IO_VTK_DATA_ENCODER_H_
+#define SRC_IO_VTK_DATA_ENCODER_H_
+
+#include <algorithm>
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <type_traits>
+
+#include "string_operations.h"
+
+namespace io {
+// Writes the values of the data arrays of VTK files. As text, the values of each call are written in one line separated
+// by spaces. As binary data, they are written without separators in the given byte order, e.g. big-endian for legacy
+// VTK files.
+class VTKDataEncoder {
+ public:
+  enum encoding { ascii, big_endian, little_endian };
+
+  VTKDataEncoder(std::ostream *file, encoding data_encoding) : file_(file), encoding_(data_encoding) {}
+
+  bool IsBinary() const {
+    return encoding_ != ascii;
+  }
+
+  template<class T>
+  void Write(const T *values, int number_of_values) {
+    Write(values, number_of_values, number_of_values);
+  }
+
+  // As text, a line break follows every values_per_line values, e.g. after each point of a contiguous block of points.
+  template<class T>
+  void Write(const T *values, int number_of_values, int values_per_line) {
+    for (int i = 0; i < number_of_values; ++i) {
+      if (encoding_ == ascii) {
+        WriteText(values[i]);
+        file_->put((i + 1) % values_per_line != 0 ? ' ' : '\n');
+      } else {
+        WriteBinary(values[i]);
+      }
+    }
+  }
+
+ private:
+  static bool IsLittleEndianMachine() {
+    const uint16_t one = 1;
+    unsigned char first_byte;
+    std::memcpy(&first_byte, &one, 1);
+    return first_byte == 1;
+  }
+
+  void WriteText(double value) {
+    util::StringOperations::WriteShortest(file_, value);
+  }
+
+  // Integers are written with std::to_chars where the standard library provides it and with the stream otherwise.
+  template<class T>
+  void WriteText(T value) {
+#ifdef __cpp_lib_to_chars
+    char buffer[24];
+    std::to_chars_result written = std::to_chars(buffer, buffer + sizeof(buffer), +value);
+    file_->write(buffer, written.ptr - buffer);
+#else
+    *file_ << +value;
+#endif
+  }
+
+  template<class T>
+  void WriteBinary(T value) {
+    static_assert(std::is_arithmetic_v<T>, "Only numbers can be written as binary data.");
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    if ((encoding_ == little_endian) != IsLittleEndianMachine()) std::reverse(bytes, bytes + sizeof(T));
+    file_->write(bytes, sizeof(T));
+  }
+
+  std::ostream *file_;
+  encoding encoding_;
+};
+}  // namespace io
+
+#endif  // SRC_IO_VTK_DATA_ENCODER_H_
@@ -14,37 +14,130 @@ You should have received a copy of the GNU Lesser General Public License along w
 
 #include "vtk_writer.h"
 
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
 #include "any_casts.h"
+#include "string_operations.h"
 #include "vtk_writer_utils.h"
 
 void io::VTKWriter::WriteFile(const std::vector<std::any> &splines,
                               const std::string &filename,
                               const std::vector<std::vector<int>> &scattering) const {
+  std::vector<int> dimensions = GetSplineDimensions(splines);
+  ThrowIfScatteringHasWrongSizes(scattering, dimensions);
+  std::vector<char> buffer(1u << 20u);
   std::ofstream newFile;
-  newFile.open(filename);
+  newFile.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  newFile.open(filename, std::ios::binary);
   if (newFile.is_open()) {
-    newFile << "# vtk DataFile Version 3.0\nSpline from Splinelib\nASCII\n\nDATASET UNSTRUCTURED_GRID\n";
-    std::vector<int> dimensions = GetSplineDimensions(splines);
-    ThrowIfScatteringHasWrongSizes(scattering, dimensions);
-    std::vector<int> cells = GetNumberOfAllCells(dimensions, scattering);
-    std::vector<int> points = GetNumberOfAllPoints(dimensions, scattering);
-    newFile << "POINTS " << std::accumulate(points.begin(), points.end(), 0) << " double\n";
-    for (auto i = 0u; i < splines.size(); ++i) {
-      AddPoints(newFile, splines[i], scattering[i], dimensions[i]);
-    }
-    newFile << "\nCELLS " << std::accumulate(cells.begin(), cells.end(), 0) << " "
-            << GetNumberOfCellEntries(dimensions, cells) << "\n";
-    for (auto i = 0u; i < splines.size(); ++i) {
-      AddCells(newFile, scattering[i], std::accumulate(points.begin(), points.begin() + i, 0), dimensions[i]);
-    }
-    newFile << "\nCELL_TYPES " << std::accumulate(cells.begin(), cells.end(), 0) << "\n";
-    for (auto i = 0u; i < splines.size(); ++i) {
-      AddCellTypes(newFile, scattering[i], dimensions[i]);
+    if (format_ == vtu) {
+      WriteVTUFile(&newFile, splines, scattering, dimensions);
+    } else {
+      WriteLegacyFile(&newFile, splines, scattering, dimensions);
     }
     newFile.close();
   }
 }
 
+io::VTKWriter::output_format io::VTKWriter::GetFormat(const std::string &filename, bool binary_format) {
+  if (util::StringOperations::EndsWith(filename, ".vtu")) return vtu;
+  return binary_format ? binary : ascii;
+}
+
+void io::VTKWriter::WriteLegacyFile(std::ostream *file,
+                                    const std::vector<std::any> &splines,
+                                    const std::vector<std::vector<int>> &scattering,
+                                    const std::vector<int> &dimensions) const {
+  io::VTKDataEncoder encoder(file, format_ == binary ? io::VTKDataEncoder::big_endian : io::VTKDataEncoder::ascii);
+  *file << "# vtk DataFile Version 3.0\nSpline from Splinelib\n" << (encoder.IsBinary() ? "BINARY" : "ASCII")
+        << "\n\nDATASET UNSTRUCTURED_GRID\n";
+  std::vector<int> cells = GetNumberOfAllCells(dimensions, scattering);
+  std::vector<int> points = GetNumberOfAllPoints(dimensions, scattering);
+  *file << "POINTS " << std::accumulate(points.begin(), points.end(), 0) << " double\n";
+  for (auto i = 0u; i < splines.size(); ++i) {
+    AddPoints(&encoder, splines[i], scattering[i], dimensions[i]);
+  }
+  *file << "\nCELLS " << std::accumulate(cells.begin(), cells.end(), 0) << " "
+        << GetNumberOfCellEntries(dimensions, cells) << "\n";
+  for (auto i = 0u; i < splines.size(); ++i) {
+    AddCells(scattering[i], std::accumulate(points.begin(), points.begin() + i, 0), dimensions[i],
+             [&encoder](const int *cell, int number_of_points) {
+      std::array<int, 9> entries{number_of_points};
+      std::copy(cell, cell + number_of_points, entries.begin() + 1);
+      encoder.Write(entries.data(), number_of_points + 1);
+    });
+  }
+  *file << "\nCELL_TYPES " << std::accumulate(cells.begin(), cells.end(), 0) << "\n";
+  for (auto i = 0u; i < splines.size(); ++i) {
+    AddCellTypes<int>(&encoder, scattering[i], dimensions[i]);
+  }
+  if (encoder.IsBinary()) *file << "\n";
+}
+
+// The appended data consists of the points, the connectivity, the offsets and the types of the cells, each preceded
+// by its size in bytes. The offsets of the data arrays in the header refer to the character following the '_'.
+void io::VTKWriter::WriteVTUFile(std::ostream *file,
+                                 const std::vector<std::any> &splines,
+                                 const std::vector<std::vector<int>> &scattering,
+                                 const std::vector<int> &dimensions) const {
+  std::vector<int> cells = GetNumberOfAllCells(dimensions, scattering);
+  std::vector<int> points = GetNumberOfAllPoints(dimensions, scattering);
+  int number_of_cells = std::accumulate(cells.begin(), cells.end(), 0);
+  int number_of_points = std::accumulate(points.begin(), points.end(), 0);
+  std::array<uint64_t, 4> sizes = {3 * sizeof(double) * number_of_points,
+                                   sizeof(int) * (GetNumberOfCellEntries(dimensions, cells) - number_of_cells),
+                                   sizeof(int) * number_of_cells, sizeof(uint8_t) * number_of_cells};
+  std::array<uint64_t, 4> offsets{};
+  for (int i = 1; i < 4; ++i) {
+    offsets[i] = offsets[i - 1] + sizeof(uint64_t) + sizes[i - 1];
+  }
+  std::string int_type = "Int" + std::to_string(8 * sizeof(int));
+  *file << "<?xml version=\"1.0\"?>\n"
+        << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n"
+        << "  <UnstructuredGrid>\n"
+        << "    <Piece NumberOfPoints=\"" << number_of_points << "\" NumberOfCells=\"" << number_of_cells << "\">\n"
+        << "      <Points>\n"
+        << "        <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"appended\" offset=\"" << offsets[0]
+        << "\"/>\n"
+        << "      </Points>\n"
+        << "      <Cells>\n"
+        << "        <DataArray type=\"" << int_type << "\" Name=\"connectivity\" format=\"appended\" offset=\""
+        << offsets[1] << "\"/>\n"
+        << "        <DataArray type=\"" << int_type << "\" Name=\"offsets\" format=\"appended\" offset=\""
+        << offsets[2] << "\"/>\n"
+        << "        <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"" << offsets[3] << "\"/>\n"
+        << "      </Cells>\n"
+        << "    </Piece>\n"
+        << "  </UnstructuredGrid>\n"
+        << "  <AppendedData encoding=\"raw\">\n"
+        << "   _";
+  io::VTKDataEncoder encoder(file, io::VTKDataEncoder::little_endian);
+  encoder.Write(&sizes[0], 1);
+  for (auto i = 0u; i < splines.size(); ++i) {
+    AddPoints(&encoder, splines[i], scattering[i], dimensions[i]);
+  }
+  encoder.Write(&sizes[1], 1);
+  for (auto i = 0u; i < splines.size(); ++i) {
+    AddCells(scattering[i], std::accumulate(points.begin(), points.begin() + i, 0), dimensions[i],
+             [&encoder](const int *cell, int number_of_points) { encoder.Write(cell, number_of_points); });
+  }
+  encoder.Write(&sizes[2], 1);
+  int offset = 0;
+  for (auto i = 0u; i < splines.size(); ++i) {
+    for (int cell = 0; cell < cells[i]; ++cell) {
+      offset += GetNumberOfCellPoints(dimensions[i]);
+      encoder.Write(&offset, 1);
+    }
+  }
+  encoder.Write(&sizes[3], 1);
+  for (auto i = 0u; i < splines.size(); ++i) {
+    AddCellTypes<uint8_t>(&encoder, scattering[i], dimensions[i]);
+  }
+  *file << "\n  </AppendedData>\n</VTKFile>\n";
+}
+
 std::vector<int> io::VTKWriter::GetSplineDimensions(const std::vector<std::any> &splines) const {
   std::vector<int> dimensions(splines.size());
   for (size_t i = 0; i < splines.size(); ++i) {
@@ -90,79 +183,97 @@ std::vector<int> io::VTKWriter::GetNumberOfAllCells(const std::vector<int> &dime
 int io::VTKWriter::GetNumberOfCellEntries(const std::vector<int> &dimensions, const std::vector<int> &cells) const {
   int sum = 0;
   for (auto i = 0u; i < dimensions.size(); ++i) {
-    sum += cells[i] * (dimensions[i] == 1 ? 3 : (dimensions[i] == 2 ? 5 : 9));
+    sum += cells[i] * (GetNumberOfCellPoints(dimensions[i]) + 1);
   }
   return sum;
 }
 
-void io::VTKWriter::AddPoints(std::ofstream &file,
+int io::VTKWriter::GetNumberOfCellPoints(int spl_dim) {
+  return spl_dim == 1 ? 2 : (spl_dim == 2 ? 4 : 8);
+}
+
+// The VTK cell types line, quad and hexahedron.
+int io::VTKWriter::GetCellType(int spl_dim) {
+  return spl_dim == 1 ? 3 : (spl_dim == 2 ? 9 : 12);
+}
+
+void io::VTKWriter::AddPoints(io::VTKDataEncoder *encoder,
                               const std::any &spline,
                               const std::vector<int> &scattering,
                               int spl_dim) const {
   if (spl_dim == 1) {
-    VTKWriterUtils<1>::WritePoints(file, spline, {scattering[0]});
+    VTKWriterUtils<1>::WritePoints(encoder, spline, {scattering[0]});
   } else if (spl_dim == 2) {
-    VTKWriterUtils<2>::WritePoints(file, spline, {scattering[0], scattering[1]});
+    VTKWriterUtils<2>::WritePoints(encoder, spline, {scattering[0], scattering[1]});
   } else if (spl_dim == 3) {
-    VTKWriterUtils<3>::WritePoints(file, spline, {scattering[0], scattering[1], scattering[2]});
+    VTKWriterUtils<3>::WritePoints(encoder, spline, {scattering[0], scattering[1], scattering[2]});
   } else {
     throw std::runtime_error("Only splines of dimensions 1 to 3 can be written to a vtk file.");
   }
 }
 
-void io::VTKWriter::AddCells(std::ofstream &file, const std::vector<int> &scattering, int offset, int spl_dim) const {
+void io::VTKWriter::AddCells(const std::vector<int> &scattering, int offset, int spl_dim,
+                             const CellFunction &function) const {
   if (spl_dim == 1) {
-    Write1DCells(file, scattering[0], offset);
+    Write1DCells(scattering[0], offset, function);
   } else if (spl_dim == 2) {
-    Write2DCells(file, {scattering[0], scattering[1]}, offset);
+    Write2DCells({scattering[0], scattering[1]}, offset, function);
   } else if (spl_dim == 3) {
-    Write3DCells(file, {scattering[0], scattering[1], scattering[2]}, offset);
+    Write3DCells({scattering[0], scattering[1], scattering[2]}, offset, function);
   }
 }
 
-void io::VTKWriter::AddCellTypes(std::ofstream &file, const std::vector<int> &scattering, int spl_dim) const {
+template<class T>
+void io::VTKWriter::AddCellTypes(io::VTKDataEncoder *encoder, const std::vector<int> &scattering, int spl_dim) const {
+  auto cell_type = static_cast<T>(GetCellType(spl_dim));
   if (spl_dim == 1) {
-    VTKWriterUtils<1>::WriteCellTypes(file, {scattering[0]}, 3);
+    VTKWriterUtils<1>::WriteCellTypes(encoder, {scattering[0]}, cell_type);
   } else if (spl_dim == 2) {
-    VTKWriterUtils<2>::WriteCellTypes(file, {scattering[0], scattering[1]}, 9);
+    VTKWriterUtils<2>::WriteCellTypes(encoder, {scattering[0], scattering[1]}, cell_type);
   } else if (spl_dim == 3) {
-    VTKWriterUtils<3>::WriteCellTypes(file, {scattering[0], scattering[1], scattering[2]}, 12);
+    VTKWriterUtils<3>::WriteCellTypes(encoder, {scattering[0], scattering[1], scattering[2]}, cell_type);
   }
 }
 
-void io::VTKWriter::Write1DCells(std::ofstream &file, int scattering, int offset) const {
+void io::VTKWriter::Write1DCells(int scattering, int offset, const CellFunction &function) const {
   for (int i = 0; i < scattering; ++i) {
-    file << "2 " << i + offset << " " << i + 1 + offset << "\n";
+    std::array<int, 2> cell = {i + offset, i + 1 + offset};
+    function(cell.data(), 2);
   }
 }
 
-void io::VTKWriter::Write2DCells(std::ofstream &file, std::array<int, 2> scattering, int offset) const {
+void io::VTKWriter::Write2DCells(std::array<int, 2> scattering, int offset, const CellFunction &function) const {
   util::MultiIndexHandler<2> point_handler({scattering[0] + 1, scattering[1] + 1});
   for (int j = 0; j < scattering[1]; ++j) {
     for (int i = 0; i <= scattering[0]; ++i, ++point_handler) {
       if (point_handler.GetIndices()[0] != scattering[0] && point_handler.GetIndices()[1] != scattering[1]) {
-        file << "4 " << point_handler.Get1DIndex() + offset << " " << (point_handler + 1).Get1DIndex() + offset << " "
-             << (point_handler + scattering[0] + 1).Get1DIndex() + offset << " "
-             << (point_handler - 1).Get1DIndex() + offset
-             << "\n";
+        std::array<int, 4> cell{};
+        cell[0] = point_handler.Get1DIndex() + offset;
+        cell[1] = (point_handler + 1).Get1DIndex() + offset;
+        cell[2] = (point_handler + scattering[0] + 1).Get1DIndex() + offset;
+        cell[3] = (point_handler - 1).Get1DIndex() + offset;
+        function(cell.data(), 4);
         point_handler - (scattering[0] + 1);
       }
     }
   }
 }
 
-void io::VTKWriter::Write3DCells(std::ofstream &file, std::array<int, 3> scattering, int offset) const {
+void io::VTKWriter::Write3DCells(std::array<int, 3> scattering, int offset, const CellFunction &function) const {
   util::MultiIndexHandler<3> point_handler({scattering[0] + 1, scattering[1] + 1, scattering[2] + 1});
   for (; point_handler.Get1DIndex() < point_handler.Get1DLength() - 1; ++point_handler) {
     if (point_handler.GetIndices()[0] != scattering[0] && point_handler.GetIndices()[1] != scattering[1]
         && point_handler.GetIndices()[2] != scattering[2]) {
-      file << "8 " << point_handler.Get1DIndex() + offset << " " << (point_handler + 1).Get1DIndex() + offset << " "
-           << (point_handler + scattering[0] + 1).Get1DIndex() + offset << " "
-           << (point_handler - 1).Get1DIndex() + offset << " "
-           << (point_handler + scattering[1] * (scattering[0] + 1)).Get1DIndex() + offset << " "
-           << (point_handler + 1).Get1DIndex() + offset << " "
-           << (point_handler + scattering[0] + 1).Get1DIndex() + offset << " "
-           << (point_handler - 1).Get1DIndex() + offset << std::endl;
+      std::array<int, 8> cell{};
+      cell[0] = point_handler.Get1DIndex() + offset;
+      cell[1] = (point_handler + 1).Get1DIndex() + offset;
+      cell[2] = (point_handler + scattering[0] + 1).Get1DIndex() + offset;
+      cell[3] = (point_handler - 1).Get1DIndex() + offset;
+      cell[4] = (point_handler + scattering[1] * (scattering[0] + 1)).Get1DIndex() + offset;
+      cell[5] = (point_handler + 1).Get1DIndex() + offset;
+      cell[6] = (point_handler + scattering[0] + 1).Get1DIndex() + offset;
+      cell[7] = (point_handler - 1).Get1DIndex() + offset;
+      function(cell.data(), 8);
       point_handler - (scattering[0] + 1) * (scattering[1] + 2);
     }
   }
@@ -17,20 +17,44 @@ You should have received a copy of the GNU Lesser General Public License along w
 
 #include <any>
 #include <array>
-#include <fstream>
+#include <cstdint>
+#include <functional>
+#include <ostream>
 #include <string>
 #include <vector>
 
+#include "vtk_data_encoder.h"
+
 namespace io {
+// Writes the splines evaluated at the points of a grid on their parameter spaces as an unstructured grid. Legacy VTK
+// files are written either as text or with big-endian binary data arrays. VTU files are written as XML with the data
+// arrays appended as raw binary data, whose sizes are known in advance, so that all formats are written in one pass.
 class VTKWriter {
  public:
-  VTKWriter() = default;
+  enum output_format { ascii, binary, vtu };
+
+  explicit VTKWriter(output_format format = ascii) : format_(format) {}
 
   void WriteFile(const std::vector<std::any> &splines,
                  const std::string &filename,
                  const std::vector<std::vector<int>> &scattering) const;
 
+  // Returns vtu for file names ending with ".vtu" and the legacy format as text or binary otherwise.
+  static output_format GetFormat(const std::string &filename, bool binary_format);
+
  private:
+  // Receives the point indices of a cell.
+  using CellFunction = std::function<void(const int *, int)>;
+
+  void WriteLegacyFile(std::ostream *file,
+                       const std::vector<std::any> &splines,
+                       const std::vector<std::vector<int>> &scattering,
+                       const std::vector<int> &dimensions) const;
+  void WriteVTUFile(std::ostream *file,
+                    const std::vector<std::any> &splines,
+                    const std::vector<std::vector<int>> &scattering,
+                    const std::vector<int> &dimensions) const;
+
   std::vector<int> GetSplineDimensions(const std::vector<std::any> &splines) const;
 
   void ThrowIfScatteringHasWrongSizes(std::vector<std::vector<int>> scattering, std::vector<int> dimensions) const;
@@ -40,14 +64,20 @@ class VTKWriter {
   std::vector<int> GetNumberOfAllCells(const std::vector<int> &dimensions,
                                        const std::vector<std::vector<int>> &scattering) const;
   int GetNumberOfCellEntries(const std::vector<int> &dimensions, const std::vector<int> &cells) const;
+  static int GetNumberOfCellPoints(int spl_dim);
+  static int GetCellType(int spl_dim);
+
+  void AddPoints(io::VTKDataEncoder *encoder, const std::any &spline, const std::vector<int> &scattering,
+                 int spl_dim) const;
+  void AddCells(const std::vector<int> &scattering, int offset, int spl_dim, const CellFunction &function) const;
+  template<class T>
+  void AddCellTypes(io::VTKDataEncoder *encoder, const std::vector<int> &scattering, int spl_dim) const;
 
-  void AddPoints(std::ofstream &file, const std::any &spline, const std::vector<int> &scattering, int spl_dim) const;
-  void AddCells(std::ofstream &file, const std::vector<int> &scattering, int offset, int spl_dim) const;
-  void AddCellTypes(std::ofstream &file, const std::vector<int> &scattering, int spl_dim) const;
+  void Write1DCells(int scattering, int offset, const CellFunction &function) const;
+  void Write2DCells(std::array<int, 2> scattering, int offset, const CellFunction &function) const;
+  void Write3DCells(std::array<int, 3> scattering, int offset, const CellFunction &function) const;
 
-  void Write1DCells(std::ofstream &file, int scattering, int offset) const;
-  void Write2DCells(std::ofstream &file, std::array<int, 2> scattering, int offset) const;
-  void Write3DCells(std::ofstream &file, std::array<int, 3> scattering, int offset) const;
+  output_format format_;
 };
 }  // namespace io
 
@@ -16,10 +16,11 @@ You should have received a copy of the GNU Lesser General Public License along w
 #define SRC_IO_VTK_WRITER_UTILS_H_
 
 #include <array>
-#include <fstream>
+#include <vector>
 
 #include "any_casts.h"
 #include "spline.h"
+#include "vtk_data_encoder.h"
 
 namespace io {
 template<int DIM>
@@ -49,24 +50,33 @@ class VTKWriterUtils {
     return scattering;
   }
 
-  static void WritePoints(std::ofstream &file, const std::any &spline, std::array<int, DIM> scattering) {
+  // Evaluates the spline on the grid at once and writes the points with three coordinates each, missing coordinates
+  // being zero.
+  static void WritePoints(io::VTKDataEncoder *encoder, const std::any &spline, std::array<int, DIM> scattering) {
     std::shared_ptr<spl::Spline<DIM>> spline_ptr = util::AnyCasts::GetSpline<DIM>(spline);
     std::array<double, 2 * DIM> knots = GetEdgeKnots(spline_ptr);
-    util::MultiIndexHandler<DIM> point_handler(GetPointHandlerLength(scattering));
-    for (int i = 0; i < point_handler.Get1DLength(); ++point_handler, ++i) {
-      std::array<ParamCoord, DIM> coords{};
-      for (int j = 0; j < DIM; ++j) {
-        coords[j] = ParamCoord(knots[j] + point_handler[j] * (knots[j + DIM] - knots[j]) / scattering[j]);
+    std::array<std::vector<ParamCoord>, DIM> grid;
+    for (int j = 0; j < DIM; ++j) {
+      for (int i = 0; i <= scattering[j]; ++i) {
+        grid[j].emplace_back(knots[j] + i * (knots[j + DIM] - knots[j]) / scattering[j]);
       }
-      for (int k = 0; k < 3; ++k) {
-        file << (k < spline_ptr->GetPointDim() ? spline_ptr->Evaluate(coords, {k})[0] : 0) << (k < 2 ? " " : "\n");
+    }
+    std::vector<double> evaluated_points = spline_ptr->EvaluateOnGrid(grid);
+    int dimension = spline_ptr->GetPointDim();
+    int number_of_points = static_cast<int>(evaluated_points.size()) / dimension;
+    std::vector<double> points(static_cast<size_t>(3 * number_of_points), 0.0);
+    for (int i = 0; i < number_of_points; ++i) {
+      for (int k = 0; k < dimension && k < 3; ++k) {
+        points[3 * i + k] = evaluated_points[i * dimension + k];
       }
     }
+    encoder->Write(points.data(), 3 * number_of_points, 3);
   }
 
-  static void WriteCellTypes(std::ofstream &file, std::array<int, DIM> scattering, int cell_type) {
+  template<class T>
+  static void WriteCellTypes(io::VTKDataEncoder *encoder, std::array<int, DIM> scattering, T cell_type) {
     for (int i = 0; i < NumberOfCells(scattering); ++i) {
-      file << cell_type << "\n";
+      encoder->Write(&cell_type, 1);
     }
   }
 };
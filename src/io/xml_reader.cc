@@ -14,105 +14,114 @@ You should have received a copy of the GNU Lesser General Public License along w
 
 #include "xml_reader.h"
 
-#include <sstream>
-
+#include <algorithm>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include "b_spline_generator.h"
+#include "mapped_file.h"
+#include "nurbs_generator.h"
+#include "parallel_operations.h"
 #include "string_operations.h"
 #include "xml_reader_utils.h"
 
 std::vector<std::any> io::XMLReader::ReadFile(const char *filename) {
-  std::vector<std::any> vector_of_splines;
   pugi::xml_document xml_document;
-  pugi::xml_parse_result result = xml_document.load_file(filename);
-  if (!result) {
-    throw std::runtime_error("Input file for XML reader couldn't be parsed.");
-  }
-  pugi::xml_node next_spline = xml_document.child("SplineList").first_child();
-  while (!next_spline.empty()) {
-    AddSpline(&next_spline, &vector_of_splines);
-    next_spline = next_spline.next_sibling();
+  if (mode_ == copied || !io::MappedFile::IsSupported()) {
+    if (!xml_document.load_file(filename)) {
+      throw std::runtime_error("Input file for XML reader couldn't be parsed.");
+    }
+    return ReadDocument(xml_document);
   }
-  return vector_of_splines;
-}
-
-void io::XMLReader::AddSpline(pugi::xml_node *spline, std::vector<std::any> *splines) {
-  std::vector<baf::ControlPoint> control_points = GetControlPoints(spline);
-  int dimension = std::stoi(spline->attribute("splDim").value());
-  if (dimension == 1) {
-    splines->push_back(Get1DSpline(spline, control_points));
-  } else if (dimension == 2) {
-    splines->push_back(Get2DSpline(spline, control_points));
-  } else if (dimension == 3) {
-    splines->push_back(Get3DSpline(spline, control_points));
-  } else if (dimension == 4) {
-    splines->push_back(Get4DSpline(spline, control_points));
+  io::MappedFile file(filename);
+  if (!xml_document.load_buffer_inplace(file.GetData(), file.GetSize())) {
+    throw std::runtime_error("Input file for XML reader couldn't be parsed.");
   }
+  return ReadDocument(xml_document);
 }
 
-std::any io::XMLReader::Get1DSpline(pugi::xml_node *spline, const std::vector<baf::ControlPoint> &control_points) {
-  KnotVectors<1> knot_vectors = io::XMLReaderUtils<1>::GetKnotVectors(spline);
-  std::array<Degree, 1> degrees = io::XMLReaderUtils<1>::GetDegrees(spline);
-  if (spline->child("wght").empty()) {
-    return std::make_any<std::shared_ptr<spl::BSpline<1>>>(
-        std::make_shared<spl::BSpline<1>>(knot_vectors, degrees, control_points));
+std::vector<std::any> io::XMLReader::ReadDocument(const pugi::xml_document &xml_document) {
+  std::vector<pugi::xml_node> spline_nodes;
+  for (pugi::xml_node spline : xml_document.child("SplineList").children()) {
+    spline_nodes.push_back(spline);
   }
-  return std::make_any<std::shared_ptr<spl::NURBS<1>>>(
-      std::make_shared<spl::NURBS<1>>(knot_vectors, degrees, control_points, GetWeights(spline)));
+  std::vector<std::any> vector_of_splines(spline_nodes.size());
+  util::ParallelOperations::ForEachRange(static_cast<int>(spline_nodes.size()), number_of_threads_,
+                                         [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      vector_of_splines[i] = GetSpline(&spline_nodes[i]);
+    }
+  });
+  vector_of_splines.erase(std::remove_if(vector_of_splines.begin(), vector_of_splines.end(),
+                                         [](const std::any &spline) { return !spline.has_value(); }),
+                          vector_of_splines.end());
+  return vector_of_splines;
 }
 
-std::any io::XMLReader::Get2DSpline(pugi::xml_node *spline, const std::vector<baf::ControlPoint> &control_points) {
-  KnotVectors<2> knot_vectors = io::XMLReaderUtils<2>::GetKnotVectors(spline);
-  std::array<Degree, 2> degrees = io::XMLReaderUtils<2>::GetDegrees(spline);
-  if (spline->child("wght").empty()) {
-    return std::make_any<std::shared_ptr<spl::BSpline<2>>>(
-        std::make_shared<spl::BSpline<2>>(knot_vectors, degrees, control_points));
+std::any io::XMLReader::GetSpline(pugi::xml_node *spline) {
+  int dimension = std::stoi(spline->attribute("spaceDim").value());
+  std::vector<double> coordinates = GetCoordinates(spline, dimension);
+  int parametric_dimension = std::stoi(spline->attribute("splDim").value());
+  if (parametric_dimension == 1) {
+    return CreateSpline<1>(spline, std::move(coordinates), dimension);
+  } else if (parametric_dimension == 2) {
+    return CreateSpline<2>(spline, std::move(coordinates), dimension);
+  } else if (parametric_dimension == 3) {
+    return CreateSpline<3>(spline, std::move(coordinates), dimension);
+  } else if (parametric_dimension == 4) {
+    return CreateSpline<4>(spline, std::move(coordinates), dimension);
   }
-  return std::make_any<std::shared_ptr<spl::NURBS<2>>>(
-      std::make_shared<spl::NURBS<2>>(knot_vectors, degrees, control_points, GetWeights(spline)));
+  return std::any();
 }
 
-std::any io::XMLReader::Get3DSpline(pugi::xml_node *spline, const std::vector<baf::ControlPoint> &control_points) {
-  KnotVectors<3> knot_vectors = io::XMLReaderUtils<3>::GetKnotVectors(spline);
-  std::array<Degree, 3> degrees = io::XMLReaderUtils<3>::GetDegrees(spline);
-  if (spline->child("wght").empty()) {
-    return std::make_any<std::shared_ptr<spl::BSpline<3>>>(
-        std::make_shared<spl::BSpline<3>>(knot_vectors, degrees, control_points));
+template<int DIM>
+std::any io::XMLReader::CreateSpline(pugi::xml_node *spline, std::vector<double> coordinates, int dimension) {
+  KnotVectors<DIM> knot_vectors = io::XMLReaderUtils<DIM>::GetKnotVectors(spline);
+  std::array<Degree, DIM> degrees = io::XMLReaderUtils<DIM>::GetDegrees(spline);
+  std::array<int, DIM> number_of_points;
+  for (int i = 0; i < DIM; ++i) {
+    number_of_points[i] = knot_vectors[i]->GetNumberOfKnots() - degrees[i].get() - 1;
   }
-  return std::make_any<std::shared_ptr<spl::NURBS<3>>>(
-      std::make_shared<spl::NURBS<3>>(knot_vectors, degrees, control_points, GetWeights(spline)));
-}
-
-std::any io::XMLReader::Get4DSpline(pugi::xml_node *spline, const std::vector<baf::ControlPoint> &control_points) {
-  KnotVectors<4> knot_vectors = io::XMLReaderUtils<4>::GetKnotVectors(spline);
-  std::array<Degree, 4> degrees = io::XMLReaderUtils<4>::GetDegrees(spline);
+  auto parameter_space = std::make_shared<spl::ParameterSpace<DIM>>(knot_vectors, degrees);
   if (spline->child("wght").empty()) {
-    return std::make_any<std::shared_ptr<spl::BSpline<4>>>(
-        std::make_shared<spl::BSpline<4>>(knot_vectors, degrees, control_points));
+    auto physical_space = std::make_shared<spl::PhysicalSpace<DIM>>(std::move(coordinates), dimension,
+                                                                    number_of_points);
+    return std::make_any<std::shared_ptr<spl::BSpline<DIM>>>(
+        std::make_shared<spl::BSpline<DIM>>(spl::BSplineGenerator<DIM>(physical_space, parameter_space)));
   }
-  return std::make_any<std::shared_ptr<spl::NURBS<4>>>(
-      std::make_shared<spl::NURBS<4>>(knot_vectors, degrees, control_points, GetWeights(spline)));
+  auto physical_space = std::make_shared<spl::WeightedPhysicalSpace<DIM>>(std::move(coordinates), dimension,
+                                                                          GetWeights(spline), number_of_points);
+  return std::make_any<std::shared_ptr<spl::NURBS<DIM>>>(
+      std::make_shared<spl::NURBS<DIM>>(spl::NURBSGenerator<DIM>(physical_space, parameter_space)));
 }
 
-std::vector<baf::ControlPoint> io::XMLReader::GetControlPoints(pugi::xml_node *spline) {
-  std::vector<double> vars = util::StringOperations::StringVectorToNumberVector<double>(
-      util::StringOperations::split(spline->child("cntrlPntVars").first_child().value(), ' '));
+std::vector<double> io::XMLReader::GetCoordinates(pugi::xml_node *spline, int dimension) {
   int start = FindCoordinatePosition(spline->child("cntrlPntVarNames").first_child().value());
-  int dimension = std::stoi(spline->attribute("spaceDim").value());
   int number_of_vars = std::stoi(spline->attribute("numOfCntrlPntVars").value());
   int number_of_points = std::stoi(spline->attribute("numCntrlPnts").value());
-  std::vector<baf::ControlPoint> points;
-  for (int i = 0; i < number_of_points; i++) {
-    std::vector<double> coordinates;
-    for (int j = start; j < start + dimension; j++) {
-      coordinates.push_back(vars[i * number_of_vars + j]);
+  if (number_of_vars < start + dimension) {
+    throw std::runtime_error("The XML file contains less control point variables than coordinates.");
+  }
+  auto number_of_coordinates = static_cast<size_t>(dimension * number_of_points);
+  std::vector<double> coordinates;
+  coordinates.reserve(number_of_coordinates);
+  int index = 0;
+  util::StringOperations::ForEachNumberToken(spline->child("cntrlPntVars").first_child().value(),
+                                             [&](std::string_view token) {
+    int var = index % number_of_vars;
+    if (index++ < number_of_points * number_of_vars && var >= start && var < start + dimension) {
+      coordinates.push_back(util::StringOperations::StringToDouble(token));
     }
-    points.emplace_back(coordinates);
+  });
+  if (coordinates.size() != number_of_coordinates) {
+    throw std::runtime_error("The XML file contains less control point variables than given by its attributes.");
   }
-  return points;
+  return coordinates;
 }
 
 std::vector<double> io::XMLReader::GetWeights(pugi::xml_node *spline) {
-  return util::StringOperations::StringVectorToNumberVector<double>(
-      util::StringOperations::split(spline->child("wght").first_child().value(), ' '));
+  return util::StringOperations::StringToNumberVector<double>(spline->child("wght").first_child().value());
 }
 
 int io::XMLReader::FindCoordinatePosition(const std::string &string) {
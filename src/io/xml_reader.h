@@ -26,25 +26,39 @@ You should have received a copy of the GNU Lesser General Public License along w
 #include "reader.h"
 
 namespace io {
+// Reads the splines of the SplineEntry nodes of an XML file. After the document has been parsed, the splines are
+// created from the nodes concurrently on the given number of threads, by default one per hardware thread. By default
+// the file is mapped into memory and parsed in place, so that the document refers to the text of the file instead of
+// a copy of it, and the control point coordinates are converted directly from the text of the cntrlPntVars nodes into
+// the coordinate vectors of the physical spaces. Where io::MappedFile is not supported, the file is always copied.
 class XMLReader : public Reader {
  public:
-  XMLReader() = default;
+  enum loading_mode { copied, memory_mapped };
+
+  explicit XMLReader(int number_of_threads = 0, loading_mode mode = memory_mapped)
+      : number_of_threads_(number_of_threads), mode_(mode) {}
 
   std::vector<std::any> ReadFile(const char *filename) override;
 
  private:
-  void AddSpline(pugi::xml_node *spline, std::vector<std::any> *splines);
+  std::vector<std::any> ReadDocument(const pugi::xml_document &xml_document);
+
+  // Returns an empty std::any if the spline has no parametric dimension between 1 and 4.
+  std::any GetSpline(pugi::xml_node *spline);
 
-  std::any Get1DSpline(pugi::xml_node *spline, const std::vector<baf::ControlPoint> &control_points);
-  std::any Get2DSpline(pugi::xml_node *spline, const std::vector<baf::ControlPoint> &control_points);
-  std::any Get3DSpline(pugi::xml_node *spline, const std::vector<baf::ControlPoint> &control_points);
-  std::any Get4DSpline(pugi::xml_node *spline, const std::vector<baf::ControlPoint> &control_points);
+  template<int DIM>
+  std::any CreateSpline(pugi::xml_node *spline, std::vector<double> coordinates, int dimension);
 
-  std::vector<baf::ControlPoint> GetControlPoints(pugi::xml_node *spline);
+  // Returns the coordinates of all control points, the coordinates of each being contiguous. Only the variables of the
+  // coordinates are converted to numbers.
+  std::vector<double> GetCoordinates(pugi::xml_node *spline, int dimension);
 
   std::vector<double> GetWeights(pugi::xml_node *spline);
 
   int FindCoordinatePosition(const std::string &string);
+
+  int number_of_threads_;
+  loading_mode mode_;
 };
 }  // namespace io
 
@@ -15,7 +15,8 @@ You should have received a copy of the GNU Lesser General Public License along w
 #ifndef SRC_IO_XML_READER_UTILS_H_
 #define SRC_IO_XML_READER_UTILS_H_
 
-#include <string>
+#include <array>
+#include <stdexcept>
 #include <vector>
 
 #include "pugixml.hpp"
@@ -29,7 +30,14 @@ template<int DIM>
 class XMLReaderUtils {
  public:
   static std::array<Degree, DIM> GetDegrees(pugi::xml_node *spline) {
-    return StringVectorToDegreeArray(util::StringOperations::split(spline->child("deg").first_child().value(), ' '));
+    std::vector<int> degrees =
+        util::StringOperations::StringToNumberVector<int>(spline->child("deg").first_child().value());
+    if (degrees.size() < DIM) throw std::runtime_error("The XML file contains less degrees than the spline dimension.");
+    std::array<Degree, DIM> converted;
+    for (int i = 0; i < DIM; i++) {
+      converted[i] = Degree{degrees[i]};
+    }
+    return converted;
   }
 
   static KnotVectors<DIM> GetKnotVectors(pugi::xml_node *spline) {
@@ -43,20 +51,10 @@ class XMLReaderUtils {
         child = child.next_sibling();
       }
       knot_vector[i] = std::make_shared<baf::KnotVector>(
-          baf::KnotVector(util::StringOperations::StringVectorToNumberVector<ParamCoord>(
-              util::StringOperations::split(child.first_child().value(), ' '))));
+          baf::KnotVector(util::StringOperations::StringToNumberVector<ParamCoord>(child.first_child().value())));
     }
     return knot_vector;
   }
-
-  static std::array<Degree, DIM> StringVectorToDegreeArray(const std::vector<std::string> &string_vector) {
-    std::array<Degree, DIM> converted;
-    for (int i = 0; i < DIM; i++) {
-      auto a = string_vector[i];
-      converted[i] = Degree{std::stoi(string_vector[i])};
-    }
-    return converted;
-  }
 };
 }  // namespace io
 
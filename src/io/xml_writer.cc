@@ -14,6 +14,8 @@ You should have received a copy of the GNU Lesser General Public License along w
 
 #include "xml_writer.h"
 
+#include <fstream>
+#include <stdexcept>
 #include <string>
 
 #include "any_casts.h"
@@ -22,99 +24,67 @@ You should have received a copy of the GNU Lesser General Public License along w
 #include "xml_writer_utils.h"
 
 void io::XMLWriter::WriteFile(const std::vector<std::any> &splines, const char *filename) const {
-  pugi::xml_document doc;
-  pugi::xml_node spline_list = doc.append_child("SplineList");
-  spline_list.append_attribute("NumberOfSplines") = std::to_string(splines.size()).c_str();
+  std::vector<int> spline_dimensions;
   for (const auto &spline : splines) {
-    AddSpline(&spline_list, spline);
+    spline_dimensions.push_back(util::AnyCasts::GetSplineDimension(spline));
   }
-  doc.save_file(filename, "  ", pugi::format_indent_attributes, pugi::encoding_utf8);
-}
-
-void io::XMLWriter::AddSpline(pugi::xml_node *spline_list, const std::any &spline) const {
-  int spline_dimension = util::AnyCasts::GetSplineDimension(spline);
-  if (spline_dimension == 1) {
-    Add1DSpline(spline_list, spline);
-  } else if (spline_dimension == 2) {
-    Add2DSpline(spline_list, spline);
-  } else if (spline_dimension == 3) {
-    Add3DSpline(spline_list, spline);
-  } else if (spline_dimension == 4) {
-    Add4DSpline(spline_list, spline);
+  std::vector<char> buffer(1u << 20u);
+  std::ofstream file;
+  file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  file.open(filename, std::ios::binary);
+  if (!file.good()) {
+    throw std::runtime_error("XML file could not be opened.");
   }
-}
-
-void io::XMLWriter::Add1DSpline(pugi::xml_node *spline_list, const std::any &spline) const {
-  std::shared_ptr<spl::Spline<1>> spline_ptr = util::AnyCasts::GetSpline<1>(spline);
-  pugi::xml_node spline_node = spline_list->append_child("SplineEntry");
-  AddSplineAttributes(&spline_node, 1, spline_ptr->GetPointDim(), spline_ptr->GetNumberOfControlPoints());
-  AddControlPointVarNames(&spline_node, spline_ptr->GetPointDim());
-  io::XMLWriterUtils<1>::AddControlPointVars(&spline_node, spline_ptr);
-  if (util::AnyCasts::IsRational<1>(spline)) {
-    io::XMLWriterUtils<1>::AddWeights(&spline_node, spline);
+  file << "<?xml version=\"1.0\"?>\n<SplineList\n  NumberOfSplines=\"" << splines.size() << "\"";
+  if (splines.empty()) {
+    file << " />\n";
+    return;
   }
-  io::XMLWriterUtils<1>::AddDegrees(&spline_node, spline_ptr);
-  io::XMLWriterUtils<1>::AddKnotVectors(&spline_node, spline_ptr);
-}
-
-void io::XMLWriter::Add2DSpline(pugi::xml_node *spline_list, const std::any &spline) const {
-  std::shared_ptr<spl::Spline<2>> spline_ptr = util::AnyCasts::GetSpline<2>(spline);
-  pugi::xml_node spline_node = spline_list->append_child("SplineEntry");
-  AddSplineAttributes(&spline_node, 2, spline_ptr->GetPointDim(), spline_ptr->GetNumberOfControlPoints());
-  AddControlPointVarNames(&spline_node, spline_ptr->GetPointDim());
-  io::XMLWriterUtils<2>::AddControlPointVars(&spline_node, spline_ptr);
-  if (util::AnyCasts::IsRational<2>(spline)) {
-    io::XMLWriterUtils<2>::AddWeights(&spline_node, spline);
-  }
-  io::XMLWriterUtils<2>::AddDegrees(&spline_node, spline_ptr);
-  io::XMLWriterUtils<2>::AddKnotVectors(&spline_node, spline_ptr);
-}
-
-void io::XMLWriter::Add3DSpline(pugi::xml_node *spline_list, const std::any &spline) const {
-  std::shared_ptr<spl::Spline<3>> spline_ptr = util::AnyCasts::GetSpline<3>(spline);
-  pugi::xml_node spline_node = spline_list->append_child("SplineEntry");
-  AddSplineAttributes(&spline_node, 3, spline_ptr->GetPointDim(), spline_ptr->GetNumberOfControlPoints());
-  AddControlPointVarNames(&spline_node, spline_ptr->GetPointDim());
-  io::XMLWriterUtils<3>::AddControlPointVars(&spline_node, spline_ptr);
-  if (util::AnyCasts::IsRational<3>(spline)) {
-    io::XMLWriterUtils<3>::AddWeights(&spline_node, spline);
+  file << ">\n";
+  for (size_t i = 0; i < splines.size(); ++i) {
+    if (spline_dimensions[i] == 1) {
+      WriteSpline<1>(&file, splines[i]);
+    } else if (spline_dimensions[i] == 2) {
+      WriteSpline<2>(&file, splines[i]);
+    } else if (spline_dimensions[i] == 3) {
+      WriteSpline<3>(&file, splines[i]);
+    } else if (spline_dimensions[i] == 4) {
+      WriteSpline<4>(&file, splines[i]);
+    }
   }
-  io::XMLWriterUtils<3>::AddDegrees(&spline_node, spline_ptr);
-  io::XMLWriterUtils<3>::AddKnotVectors(&spline_node, spline_ptr);
+  file << "</SplineList>\n";
 }
 
-void io::XMLWriter::Add4DSpline(pugi::xml_node *spline_list, const std::any &spline) const {
-  std::shared_ptr<spl::Spline<4>> spline_ptr = util::AnyCasts::GetSpline<4>(spline);
-  pugi::xml_node spline_node = spline_list->append_child("SplineEntry");
-  AddSplineAttributes(&spline_node, 4, spline_ptr->GetPointDim(), spline_ptr->GetNumberOfControlPoints());
-  AddControlPointVarNames(&spline_node, spline_ptr->GetPointDim());
-  io::XMLWriterUtils<4>::AddControlPointVars(&spline_node, spline_ptr);
-  if (util::AnyCasts::IsRational<4>(spline)) {
-    io::XMLWriterUtils<4>::AddWeights(&spline_node, spline);
+template<int DIM>
+void io::XMLWriter::WriteSpline(std::ostream *file, const std::any &spline) const {
+  std::shared_ptr<spl::Spline<DIM>> spline_ptr = util::AnyCasts::GetSpline<DIM>(spline);
+  *file << "  <SplineEntry\n";
+  WriteSplineAttributes(file, DIM, spline_ptr->GetPointDim(), spline_ptr->GetNumberOfControlPoints());
+  WriteControlPointVarNames(file, spline_ptr->GetPointDim());
+  io::XMLWriterUtils<DIM>::WriteControlPointVars(file, spline_ptr);
+  if (util::AnyCasts::IsRational<DIM>(spline)) {
+    io::XMLWriterUtils<DIM>::WriteWeights(file, spline);
   }
-  io::XMLWriterUtils<4>::AddDegrees(&spline_node, spline_ptr);
-  io::XMLWriterUtils<4>::AddKnotVectors(&spline_node, spline_ptr);
+  io::XMLWriterUtils<DIM>::WriteDegrees(file, spline_ptr);
+  io::XMLWriterUtils<DIM>::WriteKnotVectors(file, spline_ptr);
+  *file << "  </SplineEntry>\n";
 }
 
-void io::XMLWriter::AddSplineAttributes(pugi::xml_node *spline_node,
-                                        int spline_dimension,
-                                        int space_dimension,
-                                        int control_points) const {
-  spline_node->append_attribute("splDim") = spline_dimension;
-  spline_node->append_attribute("spaceDim") = space_dimension;
-  spline_node->append_attribute("numOfCntrlPntVars") = space_dimension;
-  spline_node->append_attribute("numCntrlPnts") = control_points;
+void io::XMLWriter::WriteSplineAttributes(std::ostream *file,
+                                          int spline_dimension,
+                                          int space_dimension,
+                                          int control_points) const {
+  *file << "    splDim=\"" << spline_dimension << "\"\n"
+        << "    spaceDim=\"" << space_dimension << "\"\n"
+        << "    numOfCntrlPntVars=\"" << space_dimension << "\"\n"
+        << "    numCntrlPnts=\"" << control_points << "\">\n";
 }
 
-void io::XMLWriter::AddControlPointVarNames(pugi::xml_node *spline_node, int space_dimension) const {
-  pugi::xml_node names = spline_node->append_child("cntrlPntVarNames");
-  if (space_dimension == 1) {
-    names.append_child(pugi::node_pcdata).set_value("\n      x\n    ");
-  } else if (space_dimension == 2) {
-    names.append_child(pugi::node_pcdata).set_value("\n      x y\n    ");
-  } else if (space_dimension == 3) {
-    names.append_child(pugi::node_pcdata).set_value("\n      x y z\n    ");
-  } else if (space_dimension == 4) {
-    names.append_child(pugi::node_pcdata).set_value("\n      x y z t\n    ");
+void io::XMLWriter::WriteControlPointVarNames(std::ostream *file, int space_dimension) const {
+  if (space_dimension < 1 || space_dimension > 4) {
+    *file << "    <cntrlPntVarNames />\n";
+    return;
   }
+  *file << "    <cntrlPntVarNames>\n      " << std::string("x y z t").substr(0, 2 * space_dimension - 1)
+        << "\n    </cntrlPntVarNames>\n";
 }
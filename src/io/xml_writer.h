@@ -16,13 +16,14 @@ You should have received a copy of the GNU Lesser General Public License along w
 #define SRC_IO_XML_WRITER_H_
 
 #include <any>
+#include <ostream>
 #include <vector>
 
-#include "pugixml.hpp"
-
 #include "writer.h"
 
 namespace io {
+// Writes the splines to an XML file while they are formatted, through a buffered file stream, instead of building a
+// document of all splines first. Thus, the memory needed does not depend on the number and size of the splines.
 class XMLWriter : public Writer {
  public:
   XMLWriter() = default;
@@ -30,19 +31,12 @@ class XMLWriter : public Writer {
   void WriteFile(const std::vector<std::any> &splines, const char *filename) const override;
 
  private:
-  void AddSpline(pugi::xml_node *spline_list, const std::any &spline) const;
-
-  void Add1DSpline(pugi::xml_node *spline_list, const std::any &spline) const;
-  void Add2DSpline(pugi::xml_node *spline_list, const std::any &spline) const;
-  void Add3DSpline(pugi::xml_node *spline_list, const std::any &spline) const;
-  void Add4DSpline(pugi::xml_node *spline_list, const std::any &spline) const;
+  template<int DIM>
+  void WriteSpline(std::ostream *file, const std::any &spline) const;
 
-  void AddSplineAttributes(pugi::xml_node *spline_node,
-                           int spline_dimension,
-                           int space_dimension,
-                           int control_points) const;
+  void WriteSplineAttributes(std::ostream *file, int spline_dimension, int space_dimension, int control_points) const;
 
-  void AddControlPointVarNames(pugi::xml_node *spline_node, int space_dimension) const;
+  void WriteControlPointVarNames(std::ostream *file, int space_dimension) const;
 };
 }  // namespace io
 
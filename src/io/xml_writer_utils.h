@@ -16,63 +16,65 @@ You should have received a copy of the GNU Lesser General Public License along w
 #define SRC_IO_XML_WRITER_UTILS_H_
 
 #include <any>
-#include <string>
-
-#include "pugixml.hpp"
+#include <memory>
+#include <ostream>
 
 #include "b_spline.h"
 #include "nurbs.h"
+#include "string_operations.h"
 
 namespace io {
+// Writes the elements of a SplineEntry node. Each value is written to the stream as soon as it has been formatted.
 template<int DIM>
 class XMLWriterUtils {
  public:
-  static void AddDegrees(pugi::xml_node *spline_node, std::shared_ptr<spl::Spline<DIM>> spline_ptr) {
-    pugi::xml_node degrees = spline_node->append_child("deg");
-    std::string string;
+  static void WriteDegrees(std::ostream *file, const std::shared_ptr<spl::Spline<DIM>> &spline_ptr) {
+    *file << "    <deg>\n";
     for (int i = 0; i < DIM; i++) {
-      string = string + "\n      " + std::to_string(spline_ptr->GetDegree(i).get());
+      *file << "      " << spline_ptr->GetDegree(i).get() << "\n";
     }
-    degrees.append_child(pugi::node_pcdata).text() = (string + "\n    ").c_str();
+    *file << "    </deg>\n";
   }
 
-  static void AddKnotVectors(pugi::xml_node *spline_node, std::shared_ptr<spl::Spline<DIM>> spline_ptr) {
-    pugi::xml_node knot_vectors = spline_node->append_child("kntVecs");
+  static void WriteKnotVectors(std::ostream *file, const std::shared_ptr<spl::Spline<DIM>> &spline_ptr) {
+    *file << "    <kntVecs>\n";
     for (int i = 0; i < DIM; i++) {
-      pugi::xml_node knots = knot_vectors.append_child("kntVec");
-      baf::KnotVector knot_vector = *spline_ptr->GetKnotVector(i);
-      std::string string;
-      for (ParamCoord knot : knot_vector) {
-        string += "\n        " + std::to_string(knot.get());
+      *file << "      <kntVec>\n";
+      for (ParamCoord knot : *spline_ptr->GetKnotVector(i)) {
+        *file << "        ";
+        util::StringOperations::WriteShortest(file, knot.get());
+        *file << "\n";
       }
-      knots.append_child(pugi::node_pcdata).text() = (string + "\n      ").c_str();
+      *file << "      </kntVec>\n";
     }
+    *file << "    </kntVecs>\n";
   }
 
-  static void AddControlPointVars(pugi::xml_node *spline_node, std::shared_ptr<spl::Spline<DIM>> spline_ptr) {
-    pugi::xml_node values = spline_node->append_child("cntrlPntVars");
-    std::string string;
+  static void WriteControlPointVars(std::ostream *file, const std::shared_ptr<spl::Spline<DIM>> &spline_ptr) {
+    *file << "    <cntrlPntVars>\n";
     util::MultiIndexHandler<DIM> point_handler(spline_ptr->GetPointsPerDirection());
     for (int i = 0; i < point_handler.Get1DLength(); ++i, point_handler++) {
       auto indices = point_handler.GetIndices();
-      string += "\n      ";
+      *file << "      ";
       for (int j = 0; j < spline_ptr->GetPointDim(); j++) {
-        string += std::to_string(spline_ptr->GetControlPoint(indices, j)) + "  ";
+        util::StringOperations::WriteShortest(file, spline_ptr->GetControlPoint(indices, j));
+        *file << "  ";
       }
+      *file << "\n";
     }
-    values.append_child(pugi::node_pcdata).text() = (string + "\n    ").c_str();
+    *file << "    </cntrlPntVars>\n";
   }
 
-  static void AddWeights(pugi::xml_node *spline_node, const std::any &spline) {
-    pugi::xml_node weights = spline_node->append_child("wght");
-    std::string string;
+  static void WriteWeights(std::ostream *file, const std::any &spline) {
+    *file << "    <wght>\n";
     std::shared_ptr<spl::NURBS<DIM>> nurbs = std::any_cast<std::shared_ptr<spl::NURBS<DIM>>>(spline);
     util::MultiIndexHandler<DIM> weight_handler(nurbs->GetPointsPerDirection());
     for (int i = 0; i < weight_handler.Get1DLength(); ++i, weight_handler++) {
-      auto indices = weight_handler.GetIndices();
-      string += "\n      " + std::to_string(nurbs->GetWeight(indices)) + "  ";
+      *file << "      ";
+      util::StringOperations::WriteShortest(file, nurbs->GetWeight(weight_handler.GetIndices()));
+      *file << "  \n";
     }
-    weights.append_child(pugi::node_pcdata).text() = (string + "\n    ").c_str();
+    *file << "    </wght>\n";
   }
 };
 }  // namespace io
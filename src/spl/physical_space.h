@@ -16,6 +16,7 @@ You should have received a copy of the GNU Lesser General Public License along w
 #define SRC_SPL_PHYSICAL_SPACE_H_
 
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "control_point.h"
@@ -49,6 +50,19 @@ class PhysicalSpace {
     }
   }
 
+  // Takes the coordinates of all control points in one vector, the coordinates of each control point being contiguous.
+  PhysicalSpace(std::vector<double> coordinates, int dimension, std::array<int, DIM> number_of_points)
+      : dimension_(dimension), number_of_points_(number_of_points), control_points_(std::move(coordinates)) {
+    uint64_t total_number_of_points = 1;
+    for (int dim = 0; dim < DIM; dim++) {
+      total_number_of_points *= number_of_points[dim];
+    }
+    if (dimension_ < 1 || total_number_of_points * dimension_ != control_points_.size()) {
+      throw std::runtime_error(
+          "The given number of control points in each dimension doesn't fit the length of the coordinate vector.");
+    }
+  }
+
   PhysicalSpace(const PhysicalSpace &physical_space) : dimension_(physical_space.dimension_),
                                                        number_of_points_(physical_space.number_of_points_),
                                                        control_points_(physical_space.control_points_) {}
@@ -20,6 +20,7 @@ You should have received a copy of the GNU Lesser General Public License along w
 #include <functional>
 #include <numeric>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -64,6 +65,57 @@ class Spline {
     return evaluated_point;
   }
 
+  // Evaluates all coordinates at each point of the tensor product grid of the given parametric coordinates of each
+  // direction. The non-zero basis functions are evaluated once per coordinate of each direction and the weights are
+  // applied to the control points once, so that each point is a single sum over the support of the basis functions.
+  // The coordinates of each point are contiguous and the points are ordered with the first direction running fastest.
+  std::vector<double> EvaluateOnGrid(const std::array<std::vector<ParamCoord>, DIM> &grid) const {
+    int dimension = GetPointDim();
+    std::vector<double> homogeneous_points = GetHomogeneousControlPointCoordinates();
+    std::array<int, DIM> grid_length{}, number_of_basis_functions{}, stride{};
+    std::array<std::vector<int>, DIM> first_non_zero;
+    std::array<std::vector<double>, DIM> basis_functions;
+    for (int i = 0; i < DIM; ++i) {
+      grid_length[i] = static_cast<int>(grid[i].size());
+      number_of_basis_functions[i] = GetDegree(i).get() + 1;
+      stride[i] = i == 0 ? 1 : stride[i - 1] * GetPointsPerDirection()[i - 1];
+      for (const ParamCoord &param_coord : grid[i]) {
+        if (!GetKnotVector(i)->IsInKnotVectorRange(param_coord)) {
+          std::stringstream message;
+          message << "The parametric coordinate " << param_coord.get() << " is outside the knot vector range from "
+                  << GetKnotVector(i)->GetKnot(0).get() << " to " << GetKnotVector(i)->GetLastKnot().get() << ".";
+          throw std::range_error(message.str());
+        }
+        first_non_zero[i].push_back(GetKnotVector(i)->GetKnotSpan(param_coord).get() - GetDegree(i).get());
+        std::vector<double> values = EvaluateAllNonZeroBasisFunctions(i, param_coord);
+        basis_functions[i].insert(basis_functions[i].end(), values.begin(), values.end());
+      }
+    }
+    util::MultiIndexHandler<DIM> point_handler(grid_length);
+    std::vector<double> evaluated_points(static_cast<size_t>(point_handler.Get1DLength() * dimension));
+    std::vector<double> homogeneous_point(static_cast<size_t>(dimension + 1));
+    for (int i = 0; i < point_handler.Get1DLength(); ++i, ++point_handler) {
+      std::fill(homogeneous_point.begin(), homogeneous_point.end(), 0.0);
+      util::MultiIndexHandler<DIM> basis_function_handler(number_of_basis_functions);
+      for (int j = 0; j < basis_function_handler.Get1DLength(); ++j, ++basis_function_handler) {
+        double value = 1;
+        int index = 0;
+        for (int k = 0; k < DIM; ++k) {
+          int grid_index = point_handler[k];
+          value *= basis_functions[k][grid_index * number_of_basis_functions[k] + basis_function_handler[k]];
+          index += (first_non_zero[k][grid_index] + basis_function_handler[k]) * stride[k];
+        }
+        for (int k = 0; k <= dimension; ++k) {
+          homogeneous_point[k] += value * homogeneous_points[index * (dimension + 1) + k];
+        }
+      }
+      for (int k = 0; k < dimension; ++k) {
+        evaluated_points[i * dimension + k] = homogeneous_point[k] / homogeneous_point[dimension];
+      }
+    }
+    return evaluated_points;
+  }
+
   virtual std::vector<double> EvaluateDerivative(std::array<ParamCoord, DIM> param_coord,
                                                  const std::vector<int> &dimensions,
                                                  std::array<int, DIM> derivative) const {
@@ -276,6 +328,23 @@ class Spline {
     return parameter_space_->GetArrayOfFirstNonZeroBasisFunctions(param_coord);
   }
 
+  // Returns the weighted coordinates followed by the weight of each control point.
+  std::vector<double> GetHomogeneousControlPointCoordinates() const {
+    int dimension = GetPointDim();
+    util::MultiIndexHandler<DIM> point_handler(GetPointsPerDirection());
+    std::vector<double> coordinates;
+    coordinates.reserve(static_cast<size_t>(point_handler.Get1DLength() * (dimension + 1)));
+    for (int i = 0; i < point_handler.Get1DLength(); ++i, ++point_handler) {
+      double weight = GetWeight(point_handler.GetIndices());
+      baf::ControlPoint control_point = GetControlPoint(point_handler.GetIndices());
+      for (int j = 0; j < dimension; ++j) {
+        coordinates.push_back(weight * control_point.GetValue(j));
+      }
+      coordinates.push_back(weight);
+    }
+    return coordinates;
+  }
+
   std::array<int, DIM> GetNumberOfBasisFunctionsToEvaluate() const {
     std::array<int, DIM> total_length;
     for (int i = 0; i < DIM; ++i) {
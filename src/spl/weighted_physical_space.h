@@ -15,6 +15,7 @@ You should have received a copy of the GNU Lesser General Public License along w
 #ifndef SRC_SPL_WEIGHTED_PHYSICAL_SPACE_H_
 #define SRC_SPL_WEIGHTED_PHYSICAL_SPACE_H_
 
+#include <utility>
 #include <vector>
 
 #include "physical_space.h"
@@ -34,6 +35,14 @@ class WeightedPhysicalSpace : public PhysicalSpace<DIM> {
     }
   }
 
+  WeightedPhysicalSpace(std::vector<double> coordinates, int dimension, std::vector<double> weights,
+                        std::array<int, DIM> number_of_points)
+      : PhysicalSpace<DIM>(std::move(coordinates), dimension, number_of_points), weights_(std::move(weights)) {
+    if (this->GetNumberOfControlPoints() != static_cast<int>(weights_.size())) {
+      throw std::runtime_error("The number of control points and weights has to be the same.");
+    }
+  }
+
   WeightedPhysicalSpace(const WeightedPhysicalSpace &physical_space) : PhysicalSpace<DIM>(physical_space) {
     this->weights_ = physical_space.weights_;
   }
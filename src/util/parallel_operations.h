@@ -0,0 +1,88 @@
+/* Copyright 2018 Chair for Computational Analysis of Technical Systems, RWTH Aachen University
+
+This file is part of SplineLib.
+
+SplineLib is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation version 3 of the License.
+
+SplineLib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License along with SplineLib.  If not, see
+<http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SRC_UTIL_PARALLEL_OPERATIONS_H_
+#define SRC_UTIL_PARALLEL_OPERATIONS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace util {
+class ParallelOperations {
+ public:
+  // Returns the given number of threads if it is positive and the number of hardware threads otherwise.
+  static int GetNumberOfThreads(int number_of_threads) {
+    if (number_of_threads > 0) return number_of_threads;
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+
+  // Splits the indices 0, ..., number_of_items - 1 into contiguous ranges [first, last), one per thread, and calls the
+  // function for each range. The calling thread handles the first range. If a function throws, the first exception in
+  // the order of the ranges is rethrown after all threads have been joined. If a thread cannot be started, the threads
+  // started before are joined and the std::system_error is rethrown.
+  static void ForEachRange(int number_of_items, int number_of_threads, const std::function<void(int, int)> &function) {
+    int threads_used = std::max(1, std::min(GetNumberOfThreads(number_of_threads), number_of_items));
+    std::vector<std::exception_ptr> errors(static_cast<size_t>(threads_used));
+    auto call_for_range = [&](int t) {
+      try {
+        function(GetRangeBound(t, number_of_items, threads_used), GetRangeBound(t + 1, number_of_items, threads_used));
+      } catch (...) {
+        errors[t] = std::current_exception();
+      }
+    };
+    {
+      std::vector<std::thread> threads;
+      threads.reserve(static_cast<size_t>(threads_used - 1));
+      ThreadJoiner joiner(&threads);
+      for (int t = 1; t < threads_used; ++t) {
+        threads.emplace_back(call_for_range, t);
+      }
+      call_for_range(0);
+    }
+    for (const auto &error : errors) {
+      if (error) std::rethrow_exception(error);
+    }
+  }
+
+ private:
+  // Joins all started threads when it goes out of scope, including when starting a further thread throws.
+  class ThreadJoiner {
+   public:
+    explicit ThreadJoiner(std::vector<std::thread> *threads) : threads_(threads) {}
+    ThreadJoiner(const ThreadJoiner &other) = delete;
+    ThreadJoiner &operator=(const ThreadJoiner &other) = delete;
+
+    ~ThreadJoiner() {
+      for (auto &thread : *threads_) {
+        if (thread.joinable()) thread.join();
+      }
+    }
+
+   private:
+    std::vector<std::thread> *threads_;
+  };
+
+  // Returns the first index of the range of the given thread. The product is formed in 64 bits so that it cannot
+  // overflow for large numbers of items.
+  static int GetRangeBound(int thread, int number_of_items, int threads_used) {
+    return static_cast<int>(static_cast<int64_t>(thread) * number_of_items / threads_used);
+  }
+};
+}  // namespace util
+
+#endif  // SRC_UTIL_PARALLEL_OPERATIONS_H_
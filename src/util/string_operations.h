@@ -16,9 +16,19 @@ You should have received a copy of the GNU Lesser General Public License along w
 #define SRC_UTIL_STRING_OPERATIONS_H_
 
 #include <algorithm>
+#include <cerrno>
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <vector>
 
 namespace util {
@@ -38,26 +48,48 @@ class StringOperations {
     return splitted_string;
   }
 
-  static std::vector<double> DelimitedStringToVector(std::string str) {
+  // Converts the values separated by ',' or ';' in a single pass. Values may be enclosed by whitespace and brackets.
+  static std::vector<double> DelimitedStringToVector(std::string_view string) {
     std::vector<double> vector;
-    std::size_t found1;
-    std::size_t found2;
-    while (!str.empty()) {
-      found1 = str.find_first_of(',');
-      found2 = str.find_first_of(';');
-      if ((found1 < found2) && (found1 != 0)) {
-        vector.push_back(StringToDouble(trim(str.substr(0, found1))));
-        str.erase(0, found1 + 1);
-      } else if ((found2 < found1) && (found2 != 0)) {
-        vector.push_back(StringToDouble(trim(str.substr(0, found2))));
-        str.erase(0, found2 + 1);
-      } else {
-        str.erase(0, 1);
-      }
+    while (!string.empty()) {
+      std::size_t end = std::min(string.find_first_of(",;"), string.length());
+      std::string_view value = TrimView(string.substr(0, end));
+      if (!value.empty()) vector.push_back(StringToDouble(value));
+      string.remove_prefix(std::min(end + 1, string.length()));
     }
     return vector;
   }
 
+  // Converts a block of numbers separated by whitespace, ',' or ';', e.g. the text of an XML node, without creating a
+  // string for each number.
+  template<class T>
+  static std::vector<T> StringToNumberVector(std::string_view string) {
+    std::vector<T> converted;
+    AppendNumbers(string, &converted);
+    return converted;
+  }
+
+  template<class T>
+  static void AppendNumbers(std::string_view string, std::vector<T> *numbers) {
+    ForEachNumberToken(string, [numbers](std::string_view token) { numbers->emplace_back(StringToDouble(token)); });
+  }
+
+  // Calls the function with a view of each number of a block separated by whitespace, ',' or ';', so that numbers that
+  // are not needed do not have to be converted.
+  template<class Function>
+  static void ForEachNumberToken(std::string_view string, Function function) {
+    const char *current = string.data();
+    const char *end = current + string.length();
+    while (true) {
+      while (current != end && IsNumberSeparator(*current)) ++current;
+      if (current == end) return;
+      const char *next = current;
+      while (next != end && !IsNumberSeparator(*next)) ++next;
+      function(std::string_view(current, static_cast<std::size_t>(next - current)));
+      current = next;
+    }
+  }
+
   template<class T>
   static std::vector<T> StringVectorToNumberVector(const std::vector<std::string> &string_vector) {
     std::vector<T> converted;
@@ -67,12 +99,24 @@ class StringOperations {
     return converted;
   }
 
-  static bool StartsWith(const std::string &string, const std::string &start_of_string) {
-    return string.find(start_of_string) == 0;
+  static bool StartsWith(std::string_view string, std::string_view start_of_string) {
+    return string.substr(0, start_of_string.length()) == start_of_string;
   }
 
-  static bool EndsWith(const std::string &string, const std::string &end_of_string) {
-    return string.find(end_of_string) == string.length() - end_of_string.length();
+  static bool EndsWith(std::string_view string, std::string_view end_of_string) {
+    return string.length() >= end_of_string.length() &&
+        string.substr(string.length() - end_of_string.length()) == end_of_string;
+  }
+
+  // Removes whitespace and brackets at both ends without copying.
+  static std::string_view TrimView(std::string_view string) {
+    while (!string.empty() && (std::isspace(static_cast<unsigned char>(string.front())) || string.front() == '[')) {
+      string.remove_prefix(1);
+    }
+    while (!string.empty() && (std::isspace(static_cast<unsigned char>(string.back())) || string.back() == ']')) {
+      string.remove_suffix(1);
+    }
+    return string;
   }
 
   static inline std::string trim(std::string s) {
@@ -85,34 +129,76 @@ class StringOperations {
     return s;
   }
 
-  static double StringToDouble(std::string string) {
-    int sign = 1;
-    if (string[0] == '-') {
-      sign = -1;
-      string.erase(0, 1);
+  // Upper bound of the length of the shortest representation of a double, e.g. -2.2250738585072014e-308.
+  static constexpr int kMaximumShortestLength = 32;
+
+  // Writes the shortest representation of the value that is read back as the same double with std::to_chars, which
+  // neither allocates nor depends on the locale, to the buffer of kMaximumShortestLength characters and returns its
+  // length. Thus, values written by the writers are read back without loss. Standard libraries without floating-point
+  // std::to_chars (before GCC 11) fall back to the first of 15, 16 and 17 significant digits that is read back exactly.
+  static std::size_t FormatShortest(double value, char *buffer) {
+#ifdef __cpp_lib_to_chars
+    std::to_chars_result written = std::to_chars(buffer, buffer + kMaximumShortestLength, value);
+    return static_cast<std::size_t>(written.ptr - buffer);
+#else
+    int length = 0;
+    for (int precision = 15; precision <= 17; ++precision) {
+      length = std::snprintf(buffer, kMaximumShortestLength, "%.*g", precision, value);
+      if (!std::isfinite(value) || std::strtod(buffer, nullptr) == value) break;
     }
-    std::size_t found = string.find_first_of('.');
-    std::size_t exponent = string.find_first_of("Ee");
-    std::size_t end_of_number = (exponent == std::string::npos) ? string.length() - 1 : exponent - 1;
+    return static_cast<std::size_t>(length);
+#endif
+  }
+
+  static void AppendShortest(std::string *string, double value) {
+    char buffer[kMaximumShortestLength];
+    string->append(buffer, FormatShortest(value, buffer));
+  }
+
+  static void WriteShortest(std::ostream *stream, double value) {
+    char buffer[kMaximumShortestLength];
+    stream->write(buffer, static_cast<std::streamsize>(FormatShortest(value, buffer)));
+  }
+
+  static std::string DoubleToString(double value) {
+    char buffer[kMaximumShortestLength];
+    return std::string(buffer, FormatShortest(value, buffer));
+  }
+
+  // Converts the whole string to the closest double with std::from_chars, which neither allocates nor depends on the
+  // locale. A single leading '+' is accepted. Throws std::invalid_argument if the string is not a number. Standard
+  // libraries without floating-point std::from_chars (before GCC 11) fall back to std::strtod.
+  static double StringToDouble(std::string_view string) {
+    if (string.length() > 1 && string[0] == '+' && string[1] != '+' && string[1] != '-') string.remove_prefix(1);
     double result = 0;
-    double factor = pow(10, found != std::string::npos ? found - 1 : string.length() - 1);
-    for (auto i = 0u; i <= end_of_number; ++i) {
-      if (i != found) {
-        result += std::stoi(string.substr(i, 1)) * factor;
-        factor /= 10;
-      }
+#ifdef __cpp_lib_to_chars
+    std::from_chars_result parsed = std::from_chars(string.data(), string.data() + string.length(), result);
+    if (parsed.ec == std::errc::invalid_argument || parsed.ptr != string.data() + string.length()) {
+      throw std::invalid_argument("The string " + std::string(string) + " is not a number.");
     }
-    if (exponent != std::string::npos) {
-      if (string[exponent + 1] == '-') {
-        factor = -1;
-        ++exponent;
-      } else if (string[exponent + 1] == '+') {
-        ++exponent;
-      }
-      int potency = std::stoi(string.substr(exponent + 1, string.length() - exponent));
-      result *= factor != -1 ? pow(10, potency) : 1 / pow(10, potency);
+    if (parsed.ec == std::errc::result_out_of_range) {
+      throw std::out_of_range("The number " + std::string(string) + " is out of the range of double.");
+    }
+#else
+    std::string terminated(string);
+    char *end = nullptr;
+    errno = 0;
+    result = std::strtod(terminated.c_str(), &end);
+    if (terminated.empty() || std::isspace(static_cast<unsigned char>(terminated[0])) ||
+        end != terminated.c_str() + terminated.length()) {
+      throw std::invalid_argument("The string " + terminated + " is not a number.");
     }
-    return sign * result;
+    if (errno == ERANGE && (result == 0 || std::abs(result) == HUGE_VAL)) {
+      throw std::out_of_range("The number " + terminated + " is out of the range of double.");
+    }
+#endif
+    return result;
+  }
+
+ private:
+  static bool IsNumberSeparator(char character) {
+    return character == ' ' || character == ',' || character == ';' || character == '\n' || character == '\t' ||
+        character == '\r';
   }
 };
 }  // namespace util
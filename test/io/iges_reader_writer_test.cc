@@ -13,7 +13,15 @@ You should have received a copy of the GNU Lesser General Public License along w
 */
 
 #include <config_iges.h>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "gmock/gmock.h"
+#include "iges_catalog.h"
 #include "iges_reader.h"
 #include "iges_writer.h"
 
@@ -162,6 +170,63 @@ TEST_F(AnIGESReaderAndWriter, Read2DBSplineFromIGESFile) { // NOLINT
               DoubleEq(b_spline_->Evaluate({ParamCoord{1.0}, ParamCoord{1.0}}, {2})[0]));
 }
 
+TEST_F(AnIGESReaderAndWriter, ListsEntitiesOfDirectoryInCatalog) { // NOLINT
+  io::IGESCatalog catalog(iges_read);
+  ASSERT_THAT(catalog.GetEntities().size(), 5);
+  ASSERT_THAT(catalog.GetEntities()[2].entity_type, 128);
+  ASSERT_THAT(catalog.GetEntities()[2].parameter_data_start, 3);
+  ASSERT_THAT(catalog.GetEntities()[2].parameter_data_line_count, 44);
+  ASSERT_THAT(catalog.GetSplineEntities().size(), iges_reader_->ReadFile(iges_read).size());
+}
+
+TEST_F(AnIGESReaderAndWriter, CreatesSameSplinesFromCatalogAsReader) { // NOLINT
+  io::IGESCatalog catalog(iges_read);
+  std::vector<std::any> read = iges_reader_->ReadFile(iges_read);
+  std::vector<std::any> serial = catalog.GetSplines(catalog.GetSplineEntities());
+  std::vector<std::any> parallel = catalog.GetSplines(catalog.GetSplineEntities(), 4);
+  ASSERT_THAT(serial.size(), read.size());
+  ASSERT_THAT(parallel.size(), read.size());
+  auto nurbs_2d = std::any_cast<std::shared_ptr<spl::NURBS<2>>>(read[0]);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::NURBS<2>>>(serial[0])->AreEqual(*nurbs_2d), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::NURBS<2>>>(parallel[0])->AreEqual(*nurbs_2d), true);
+  auto b_spline_1d = std::any_cast<std::shared_ptr<spl::BSpline<1>>>(read[1]);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::BSpline<1>>>(serial[1])->AreEqual(*b_spline_1d), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::BSpline<1>>>(parallel[1])->AreEqual(*b_spline_1d), true);
+}
+
+TEST_F(AnIGESReaderAndWriter, ReadsSameSplinesForAnyNumberOfThreads) { // NOLINT
+  std::vector<std::any> serial = io::IGESReader(1).ReadFile(iges_read);
+  std::vector<std::any> parallel = io::IGESReader(2).ReadFile(iges_read);
+  ASSERT_THAT(parallel.size(), serial.size());
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::NURBS<2>>>(parallel[0])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::NURBS<2>>>(serial[0])), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::BSpline<1>>>(parallel[1])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::BSpline<1>>>(serial[1])), true);
+}
+
+TEST_F(AnIGESReaderAndWriter, IndexesParameterRecordsOfDifferentLengths) { // NOLINT
+  std::ifstream input(iges_read);
+  std::ofstream output("catalog.iges");
+  std::string line;
+  bool first_parameter_record = true;
+  while (getline(input, line)) {
+    output << line << (line.size() > 72 && line[72] == 'P' && first_parameter_record ? "\r\n" : "\n");
+    if (line.size() > 72 && line[72] == 'P') first_parameter_record = false;
+  }
+  output.close();
+  io::IGESCatalog catalog("catalog.iges");
+  auto b_spline_1d = std::any_cast<std::shared_ptr<spl::BSpline<1>>>(iges_reader_->ReadFile(iges_read)[1]);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::BSpline<1>>>(catalog.GetSpline(catalog.GetSplineEntities()[1]))
+                  ->AreEqual(*b_spline_1d), true);
+  remove("catalog.iges");
+}
+
+TEST_F(AnIGESReaderAndWriter, ThrowsForCatalogEntityThatIsNoSpline) { // NOLINT
+  io::IGESCatalog catalog(iges_read);
+  ASSERT_THAT(catalog.GetEntities()[0].entity_type, 406);
+  ASSERT_THROW(catalog.GetSpline(0), std::runtime_error);
+}
+
 TEST_F(AnIGESReaderAndWriter, Write1DBSplineToIGESFile) { // NOLINT
   auto splines = iges_reader_->ReadFile(iges_read);
   iges_writer_->WriteFile(splines, "write.iges");
@@ -236,3 +301,75 @@ TEST_F(AnIGESReaderAndWriter, ThrowsForSplineOfDimensionThree) {  // NOLINT
   ASSERT_THROW(iges_writer_->WriteFile({bspline_3d_any}, "3d_spline.xml"), std::runtime_error);
   remove("3d_spline.xml");
 }
+
+class AnIGESReader : public Test {
+ public:
+  AnIGESReader() : iges_reader_(std::make_unique<io::IGESReader>()) {
+    // Linear B-spline curve from (0, 0, 0) to (2.5, 0, 0). The 64 data columns of the first record end in the middle of
+    // 2.5, which is padded with leading zeros.
+    std::string parameters = "126,1,1,0,0,1,0,0.,0.,1.,1.,1.,1.,0.,0.,0.," + std::string(20, '0') +
+        "2.5,0.,0.,0.,1.,0.,0.,1.;";
+    first_parameter_record_ = GetParameterRecord(parameters.substr(0, 64), 1);
+    second_parameter_record_ = GetParameterRecord(parameters.substr(64), 2);
+  }
+
+ protected:
+  // Returns the two records of a directory entry of a rational B-spline curve (entity 126) with fields of 8 columns.
+  static std::vector<std::string> GetDirectoryRecords(int parameter_data_start, int parameter_data_line_count) {
+    std::ostringstream first_record, second_record;
+    first_record << std::setw(8) << 126 << std::setw(8) << parameter_data_start << std::string(56, ' ') << "D"
+                 << std::setw(7) << 1;
+    second_record << std::setw(8) << 126 << std::setw(16) << 0 << std::setw(8) << parameter_data_line_count
+                  << std::string(40, ' ') << "D" << std::setw(7) << 2;
+    return {first_record.str(), second_record.str()};
+  }
+
+  static std::string GetParameterRecord(const std::string &data, int sequence_number) {
+    std::ostringstream record;
+    record << std::left << std::setw(64) << data << std::right << std::setw(8) << 1 << "P" << std::setw(7)
+           << sequence_number;
+    return record.str();
+  }
+
+  static void WriteFile(const char *filename, const std::vector<std::string> &lines) {
+    std::ofstream output(filename);
+    for (const auto &line : lines) {
+      output << line << "\n";
+    }
+  }
+
+  std::unique_ptr<io::IGESReader> iges_reader_;
+  std::string first_parameter_record_;
+  std::string second_parameter_record_;
+};
+
+TEST_F(AnIGESReader, JoinsParameterSplitAcrossTwoRecords) {  // NOLINT
+  std::vector<std::string> directory_records = GetDirectoryRecords(1, 2);
+  WriteFile("split_parameter.iges",
+            {directory_records[0], directory_records[1], first_parameter_record_, second_parameter_record_});
+  auto b_spline_1d = std::any_cast<std::shared_ptr<spl::BSpline<1>>>(iges_reader_->ReadFile("split_parameter.iges")[0]);
+  ASSERT_THAT(b_spline_1d->Evaluate({ParamCoord{1.0}}, {0})[0], DoubleEq(2.5));
+  ASSERT_THAT(b_spline_1d->Evaluate({ParamCoord{0.5}}, {0})[0], DoubleEq(1.25));
+  remove("split_parameter.iges");
+}
+
+TEST_F(AnIGESReader, SkipsLinesOfAtMost72Characters) {  // NOLINT
+  std::vector<std::string> directory_records = GetDirectoryRecords(1, 2);
+  WriteFile("short_lines.iges", {"", directory_records[0], std::string(72, 'D'), directory_records[1],
+                                 first_parameter_record_, "S", std::string(72, 'P'), second_parameter_record_});
+  auto splines = iges_reader_->ReadFile("short_lines.iges");
+  ASSERT_THAT(splines.size(), 1);
+  auto b_spline_1d = std::any_cast<std::shared_ptr<spl::BSpline<1>>>(splines[0]);
+  ASSERT_THAT(b_spline_1d->Evaluate({ParamCoord{1.0}}, {0})[0], DoubleEq(2.5));
+  remove("short_lines.iges");
+}
+
+TEST_F(AnIGESReader, ThrowsForParameterDataOutOfSection) {  // NOLINT
+  for (const auto &[start, line_count] : std::vector<std::pair<int, int>>{{0, 2}, {2, 2}, {3, 1}, {1, 3}}) {
+    std::vector<std::string> directory_records = GetDirectoryRecords(start, line_count);
+    WriteFile("out_of_section.iges",
+              {directory_records[0], directory_records[1], first_parameter_record_, second_parameter_record_});
+    ASSERT_THROW(iges_reader_->ReadFile("out_of_section.iges"), std::runtime_error);
+  }
+  remove("out_of_section.iges");
+}
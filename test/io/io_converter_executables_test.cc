@@ -91,6 +91,9 @@ bool CompareToHelpOutput(const std::string &string) {
       + "file, 'all' for all splines in input file\n\n"
       + "If this is a converter to VTK format, the log file has to expanded by the following entry:\n" + "scattering:\n"
       + "# scattering for each spline separated by line breaks and for each dimension separated by spaces\n\n"
+      + "The data of VTK files is written as text unless the log file contains the following entry:\n"
+      + "format:\n# 'binary' for binary data, 'ascii' for text\n\n"
+      + "Files ending with '.vtu' are written in the XML format of VTK with raw binary data.\n\n"
       + "The log file is expanded by a log entry if converting succeed:\n"
       + "log:\n# time date\n# spline positions in input file that have been written to output file.\n";
   return string == help;
@@ -173,6 +176,18 @@ TEST_F(Iges2vtkExecutable, ConvertsFileCorrectly) {  // NOLINT
   remove("out.vtk");
 }
 
+TEST_F(Iges2vtkExecutable, ConvertsFileToBinaryFormat) {  // NOLINT
+  CreateLogFile(iges_read, "out.vtk", "all\n\nscattering:\n20 30\n70\n\nformat:\nbinary");
+  ASSERT_THAT(std::system((GetPathToInstallDir() + "iges2vtk log.txt").c_str()), 0);  // NOLINT
+  std::string vtk_file = GetFileContent("out.vtk");
+  ASSERT_THAT(vtk_file.find("# vtk DataFile Version 3.0\nSpline from Splinelib\nBINARY\n"), Ne(std::string::npos));
+  ASSERT_THAT(vtk_file.find("DATASET UNSTRUCTURED_GRID\nPOINTS 722 double\n"), Ne(std::string::npos));
+  ASSERT_THAT(vtk_file.find("CELLS 670 3210\n"), Ne(std::string::npos));
+  ASSERT_THAT(vtk_file.find("CELL_TYPES 670\n"), Ne(std::string::npos));
+  remove("log.txt");
+  remove("out.vtk");
+}
+
 class Iges2xmlExecutable : public Test {
  public:
   Iges2xmlExecutable() = default;
@@ -79,6 +79,37 @@ TEST_F(AnIGEStoVTKConverter, CorrectlyConvertsSplines) {  // NOLINT
   remove("converted_vtk_file.vtk");
 }
 
+TEST_F(AnIGEStoVTKConverter, ConvertsSplinesToVTUFile) {  // NOLINT
+  io::IOConverter io_converter(iges_read, "converted_vtk_file.vtu");
+  ASSERT_THAT(io_converter.ConvertFile({}, {{20, 30}, {70}}).size(), 2);
+  std::ifstream newFile;
+  newFile.open("converted_vtk_file.vtu");
+  ASSERT_THAT(newFile.good(), true);
+  std::string line, file;
+  while (getline(newFile, line)) {
+    file += line + "\n";
+  }
+  ASSERT_THAT(file.find(R"(<VTKFile type="UnstructuredGrid")"), Ne(std::string::npos));
+  ASSERT_THAT(file.find(R"(<Piece NumberOfPoints="722" NumberOfCells="670">)"), Ne(std::string::npos));
+  ASSERT_THAT(file.find(R"(<AppendedData encoding="raw">)"), Ne(std::string::npos));
+  remove("converted_vtk_file.vtu");
+}
+
+TEST_F(AnIGEStoVTKConverter, ConvertsSplinesToBinaryVTKFile) {  // NOLINT
+  io::IOConverter io_converter(iges_read, "converted_vtk_file.vtk", true);
+  ASSERT_THAT(io_converter.ConvertFile({}, {{20, 30}, {70}}).size(), 2);
+  std::ifstream newFile;
+  newFile.open("converted_vtk_file.vtk");
+  ASSERT_THAT(newFile.good(), true);
+  std::string line, file;
+  while (getline(newFile, line)) {
+    file += line + "\n";
+  }
+  ASSERT_THAT(file.find("# vtk DataFile Version 3.0\nSpline from Splinelib\nBINARY\n"), Ne(std::string::npos));
+  ASSERT_THAT(file.find("CELLS 670 3210\n"), Ne(std::string::npos));
+  remove("converted_vtk_file.vtk");
+}
+
 class AnIGEStoXMLConverter : public Test {
  public:
   AnIGEStoXMLConverter() : io_converter_(std::make_unique<io::IOConverter>(iges_read, "converted_xml_file.xml")) {}
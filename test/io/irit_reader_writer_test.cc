@@ -13,11 +13,13 @@ You should have received a copy of the GNU Lesser General Public License along w
 */
 
 #include <config_irit.h>
+#include <fstream>
 
 #include "gmock/gmock.h"
 
 #include "irit_reader.h"
 #include "irit_writer.h"
+#include "stream_tokenizer.h"
 #include "xml_reader.h"
 #include "xml_writer.h"
 
@@ -205,10 +207,66 @@ TEST_F(AnIRITReader, ThrowsExceptionForNonExistingFile) {  // NOLINT
   ASSERT_THROW(irit_reader->ReadFile("testing.itd"), std::runtime_error);
 }
 
+TEST_F(AnIRITReader, ThrowsForRationalControlPointWithoutCoordinates) {  // NOLINT
+  std::ofstream output("empty_point.itd");
+  output << "[CURVE BSPLINE 2 2 P2\n[KV 0. 0. 1. 1.]\n[]\n[1. 1. 1.]\n]\n";
+  output.close();
+  ASSERT_THROW(irit_reader->ReadFile("empty_point.itd"), std::runtime_error);
+  remove("empty_point.itd");
+}
+
 TEST_F(AnIRITReader, Finds6Splines) {  // NOLINT
   ASSERT_THAT(irit_reader->ReadFile(path_to_irit_file).size(), 6);
 }
 
+TEST_F(AnIRITReader, ReturnsSameTokensForAnyChunkSize) {  // NOLINT
+  io::StreamTokenizer small_chunks(path_to_irit_file, 3);
+  io::StreamTokenizer large_chunks(path_to_irit_file);
+  std::string_view small_chunk_token, large_chunk_token;
+  int number_of_tokens = 0;
+  while (large_chunks.Next(&large_chunk_token)) {
+    ASSERT_THAT(small_chunks.Next(&small_chunk_token), true);
+    ASSERT_THAT(small_chunk_token, large_chunk_token);
+    ++number_of_tokens;
+  }
+  ASSERT_THAT(small_chunks.Next(&small_chunk_token), false);
+  ASSERT_THAT(number_of_tokens, Ne(0));
+}
+
+TEST_F(AnIRITReader, ContinuesWithTokenAtOffset) {  // NOLINT
+  io::StreamTokenizer tokenizer(path_to_irit_file, 3);
+  std::string_view token;
+  std::vector<std::string> tokens;
+  std::vector<std::streamoff> offsets;
+  while (tokenizer.Next(&token)) {
+    tokens.emplace_back(token);
+    offsets.push_back(tokenizer.GetOffset());
+  }
+  for (auto i = static_cast<int>(tokens.size()) - 1; i > 0; i -= static_cast<int>(tokens.size()) / 7 + 1) {
+    tokenizer.Seek(offsets[i - 1]);
+    ASSERT_THAT(tokenizer.Next(&token), true);
+    ASSERT_THAT(token, tokens[i]);
+  }
+}
+
+TEST_F(AnIRITReader, ReturnsSameSplinesForAnyNumberOfThreads) {  // NOLINT
+  std::vector<std::any> serial = io::IRITReader(1).ReadFile(path_to_irit_file);
+  std::vector<std::any> parallel = io::IRITReader(4).ReadFile(path_to_irit_file);
+  ASSERT_THAT(parallel.size(), serial.size());
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::BSpline<1>>>(parallel[0])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::BSpline<1>>>(serial[0])), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::NURBS<1>>>(parallel[1])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::NURBS<1>>>(serial[1])), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::BSpline<2>>>(parallel[2])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::BSpline<2>>>(serial[2])), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::NURBS<2>>>(parallel[3])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::NURBS<2>>>(serial[3])), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::BSpline<3>>>(parallel[4])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::BSpline<3>>>(serial[4])), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::NURBS<3>>>(parallel[5])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::NURBS<3>>>(serial[5])), true);
+}
+
 TEST_F(AnIRITReader, ReturnsCorrectDegree) {  // NOLINT
   ASSERT_THAT(std::any_cast<std::shared_ptr<spl::BSpline<1>>>(
       irit_reader->ReadFile(path_to_irit_file)[0])->GetDegree(0).get(), b_spline_1d_->GetDegree(0).get());
@@ -278,9 +336,9 @@ TEST_F(AnIRITWriter, CreatesCorrectFile) {  // NOLINT
   ASSERT_THAT(file.find("[TRIVAR BSPLINE 2 2 2 2 2 2 E3"), Ne(std::string::npos));
   ASSERT_THAT(file.find("[TRIVAR BSPLINE 2 2 2 2 2 2 P3"), Ne(std::string::npos));
   ASSERT_THAT(file.find("[KV "), Ne(std::string::npos));
-  ASSERT_THAT(file.find(" 1.000000]"), Ne(std::string::npos));
-  ASSERT_THAT(file.find("[0.800000 0.300000 -0.400000]"), Ne(std::string::npos));
-  ASSERT_THAT(file.find("[0.500000 1.000000 0.250000]"), Ne(std::string::npos));
+  ASSERT_THAT(file.find(" 1]"), Ne(std::string::npos));
+  ASSERT_THAT(file.find("[0.8 0.3 -0.4]"), Ne(std::string::npos));
+  ASSERT_THAT(file.find("[0.5 1 0.25]"), Ne(std::string::npos));
   remove("splines.itd");
 }
 
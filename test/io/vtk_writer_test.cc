@@ -12,6 +12,12 @@ You should have received a copy of the GNU Lesser General Public License along w
 <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
 #include "gmock/gmock.h"
 
 #include "nurbs.h"
@@ -19,6 +25,7 @@ You should have received a copy of the GNU Lesser General Public License along w
 
 using testing::Test;
 using testing::Ne;
+using testing::DoubleEq;
 
 class A1DNURBSForVTKWriter {  // NOLINT
  public:
@@ -128,6 +135,71 @@ TEST_F(AVTKWriter, CreatesVTKFile) {  // NOLINT
   remove("splines.vtk");
 }
 
+std::string ReadBinaryFile(const std::string &filename) {
+  std::ifstream file(filename, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+template<class T>
+T DecodeBinary(const std::string &file, size_t position, bool big_endian) {
+  T value;
+  std::string bytes = file.substr(position, sizeof(T));
+  uint16_t one = 1;
+  if (big_endian == (*reinterpret_cast<unsigned char *>(&one) == 1)) std::reverse(bytes.begin(), bytes.end());
+  std::memcpy(&value, bytes.data(), sizeof(T));
+  return value;
+}
+
+TEST_F(AVTKWriter, CreatesBinaryVTKFile) {  // NOLINT
+  io::VTKWriter(io::VTKWriter::binary).WriteFile(splines_, "splines.vtk", scattering_);
+  std::string file = ReadBinaryFile("splines.vtk");
+  ASSERT_THAT(file.find("# vtk DataFile Version 3.0\nSpline from Splinelib\nBINARY\n"), 0);
+  std::string points_header = "DATASET UNSTRUCTURED_GRID\nPOINTS 2659 double\n";
+  size_t points = file.find(points_header) + points_header.length();
+  std::string cells_header = "\nCELLS 2260 14940\n";
+  ASSERT_THAT(file.compare(points + 2659 * 3 * sizeof(double), cells_header.length(), cells_header), 0);
+  size_t cells = points + 2659 * 3 * sizeof(double) + cells_header.length();
+  std::string cell_types_header = "\nCELL_TYPES 2260\n";
+  ASSERT_THAT(file.compare(cells + 14940 * sizeof(int), cell_types_header.length(), cell_types_header), 0);
+  size_t cell_types = cells + 14940 * sizeof(int) + cell_types_header.length();
+  ASSERT_THAT(file.size(), cell_types + 2260 * sizeof(int) + 1);
+  ASSERT_THAT(DecodeBinary<double>(file, points, true), DoubleEq(4.0));
+  ASSERT_THAT(DecodeBinary<double>(file, points + sizeof(double), true), DoubleEq(-1.0));
+  ASSERT_THAT(DecodeBinary<double>(file, points + 2 * sizeof(double), true), DoubleEq(0.0));
+  ASSERT_THAT(DecodeBinary<int>(file, cells, true), 2);
+  ASSERT_THAT(DecodeBinary<int>(file, cells + 2 * sizeof(int), true), 1);
+  ASSERT_THAT(DecodeBinary<int>(file, cell_types, true), 3);
+  ASSERT_THAT(DecodeBinary<int>(file, cell_types + 2259 * sizeof(int), true), 12);
+  remove("splines.vtk");
+}
+
+TEST_F(AVTKWriter, CreatesVTUFileWithAppendedData) {  // NOLINT
+  io::VTKWriter(io::VTKWriter::GetFormat("splines.vtu", false)).WriteFile(splines_, "splines.vtu", scattering_);
+  std::string file = ReadBinaryFile("splines.vtu");
+  ASSERT_THAT(file.find(R"(<VTKFile type="UnstructuredGrid" version="1.0" byte_order="LittleEndian")"),
+              Ne(std::string::npos));
+  ASSERT_THAT(file.find(R"(<Piece NumberOfPoints="2659" NumberOfCells="2260">)"), Ne(std::string::npos));
+  uint64_t points_size = 2659 * 3 * sizeof(double);
+  uint64_t connectivity_size = (14940 - 2260) * sizeof(int);
+  uint64_t offsets_size = 2260 * sizeof(int);
+  ASSERT_THAT(file.find(R"(Name="connectivity" format="appended" offset=")" + std::to_string(8 + points_size)),
+              Ne(std::string::npos));
+  std::string appended_data_header = "<AppendedData encoding=\"raw\">\n   _";
+  size_t data = file.find(appended_data_header) + appended_data_header.length();
+  ASSERT_THAT(DecodeBinary<uint64_t>(file, data, false), points_size);
+  size_t connectivity = data + 8 + points_size;
+  ASSERT_THAT(DecodeBinary<uint64_t>(file, connectivity, false), connectivity_size);
+  ASSERT_THAT(DecodeBinary<int>(file, connectivity + 8 + sizeof(int), false), 1);
+  size_t offsets = connectivity + 8 + connectivity_size;
+  ASSERT_THAT(DecodeBinary<uint64_t>(file, offsets, false), offsets_size);
+  ASSERT_THAT(DecodeBinary<int>(file, offsets + 8, false), 2);
+  ASSERT_THAT(DecodeBinary<int>(file, offsets + 8 + offsets_size - sizeof(int), false), 14940 - 2260);
+  size_t types = offsets + 8 + offsets_size;
+  ASSERT_THAT(DecodeBinary<uint64_t>(file, types, false), 2260);
+  ASSERT_THAT(file.substr(types + 8 + 2260), "\n  </AppendedData>\n</VTKFile>\n");
+  remove("splines.vtu");
+}
+
 TEST_F(AVTKWriter, ThrowsForMissingEntryInScattering) {  // NOLINT
   scattering_.pop_back();
   ASSERT_THROW(vtk_writer_->WriteFile(splines_, "splines.vtk", scattering_), std::runtime_error);
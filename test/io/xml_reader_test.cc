@@ -40,6 +40,34 @@ TEST_F(AnXMLReader, FindsFourSplines) {  // NOLINT
   ASSERT_THAT(xml_reader->ReadFile(path_to_xml_file).size(), 4);
 }
 
+TEST_F(AnXMLReader, ReturnsSameSplinesForAnyNumberOfThreads) {  // NOLINT
+  std::vector<std::any> serial = io::XMLReader(1).ReadFile(path_to_xml_file);
+  std::vector<std::any> parallel = io::XMLReader(3).ReadFile(path_to_xml_file);
+  ASSERT_THAT(parallel.size(), serial.size());
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::NURBS<2>>>(parallel[0])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::NURBS<2>>>(serial[0])), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::BSpline<2>>>(parallel[1])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::BSpline<2>>>(serial[1])), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::BSpline<4>>>(parallel[2])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::BSpline<4>>>(serial[2])), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::NURBS<4>>>(parallel[3])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::NURBS<4>>>(serial[3])), true);
+}
+
+TEST_F(AnXMLReader, ReturnsSameSplinesForMappedAndCopiedFile) {  // NOLINT
+  std::vector<std::any> mapped = io::XMLReader(1, io::XMLReader::memory_mapped).ReadFile(path_to_xml_file);
+  std::vector<std::any> copied = io::XMLReader(1, io::XMLReader::copied).ReadFile(path_to_xml_file);
+  ASSERT_THAT(mapped.size(), copied.size());
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::NURBS<2>>>(mapped[0])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::NURBS<2>>>(copied[0])), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::BSpline<2>>>(mapped[1])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::BSpline<2>>>(copied[1])), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::BSpline<4>>>(mapped[2])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::BSpline<4>>>(copied[2])), true);
+  ASSERT_THAT(std::any_cast<std::shared_ptr<spl::NURBS<4>>>(mapped[3])->AreEqual(
+      *std::any_cast<std::shared_ptr<spl::NURBS<4>>>(copied[3])), true);
+}
+
 TEST_F(AnXMLReader, GetsCorrectDegrees) {  // NOLINT
   ASSERT_THAT(std::any_cast<std::shared_ptr<spl::NURBS<2>>>(
       xml_reader->ReadFile(path_to_xml_file)[0])->GetDegree(0).get(), 2);
@@ -267,6 +267,14 @@ TEST_F(AnXMLWriter, CreatesCorrectXMLFile) {  // NOLINT
   remove("splines.xml");
 }
 
+TEST_F(AnXMLWriter, CreatesCorrectXMLFileWithoutSplines) {  // NOLINT
+  xml_writer_->WriteFile({}, "splines.xml");
+  pugi::xml_document doc;
+  ASSERT_STREQ(doc.load_file("splines.xml").description(), "No error");
+  ASSERT_THAT(doc.child("SplineList").attribute("NumberOfSplines").as_int(), 0);
+  remove("splines.xml");
+}
+
 TEST_F(AnXMLWriter, CreatesSplineListWith7Entries) {  // NOLINT
   xml_writer_->WriteFile(splines_, "splines.xml");
   pugi::xml_document doc;
@@ -518,6 +518,22 @@ class ANURBSWithSplineGenerator : public Test {
   std::unique_ptr<spl::NURBS<1>> nurbs;
 };
 
+TEST_F(ANURBSWithSplineGenerator, EvaluatesOnGridAsAtEachPoint) { // NOLINT
+  std::vector<ParamCoord> coordinates = {ParamCoord{0.0}, ParamCoord{0.4}, ParamCoord{1.0}, ParamCoord{2.7},
+                                         ParamCoord{3.0}};
+  std::vector<double> evaluated_points = nurbs->EvaluateOnGrid({coordinates});
+  ASSERT_THAT(evaluated_points.size(), 10);
+  for (size_t i = 0; i < coordinates.size(); ++i) {
+    std::vector<double> evaluated_point = nurbs->Evaluate({coordinates[i]}, {0, 1});
+    ASSERT_THAT(evaluated_points[2 * i], DoubleNear(evaluated_point[0], util::NumericSettings<double>::kEpsilon()));
+    ASSERT_THAT(evaluated_points[2 * i + 1], DoubleNear(evaluated_point[1], util::NumericSettings<double>::kEpsilon()));
+  }
+}
+
+TEST_F(ANURBSWithSplineGenerator, ThrowsForGridCoordinateOutsideKnotVectorRange) { // NOLINT
+  ASSERT_THROW(nurbs->EvaluateOnGrid({std::vector<ParamCoord>{ParamCoord{1.0}, ParamCoord{3.1}}}), std::range_error);
+}
+
 TEST_F(ANURBSWithSplineGenerator, Returns1_4For1AndDim0) { // NOLINT
   ASSERT_THAT(nurbs->Evaluate({ParamCoord{1.0}}, {0})[0], DoubleNear(1.4, util::NumericSettings<double>::kEpsilon()));
 }
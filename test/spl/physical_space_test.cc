@@ -46,6 +46,12 @@ TEST_F(A1DPhysicalSpace, ThrowsForDifferingDimensionsOfControlPoints) {  // NOLI
   ASSERT_THROW(spl::PhysicalSpace<1>(control_points, {6}), std::runtime_error);
 }
 
+TEST_F(A1DPhysicalSpace, EqualsPhysicalSpaceOfSameCoordinateVector) {  // NOLINT
+  spl::PhysicalSpace<1> from_coordinates({0.0, 0.0, 1.0, 1.0, 3.0, 2.0, 4.0, 1.0, 5.0, -1.0}, 2, {5});
+  ASSERT_THAT(from_coordinates.AreEqual(physical_space), true);
+  ASSERT_THROW(spl::PhysicalSpace<1>(std::vector<double>({0.0, 0.0, 1.0}), 2, {2}), std::runtime_error);
+}
+
 TEST_F(A1DPhysicalSpace, ReturnsCorrectControlPoint) {  // NOLINT
   ASSERT_THAT(physical_space.GetControlPoint(std::array<int, 1>{2}).GetValue(0), DoubleEq(3.0));
   ASSERT_THAT(physical_space.GetControlPoint(std::array<int, 1>{2}).GetValue(1), DoubleEq(2.0));
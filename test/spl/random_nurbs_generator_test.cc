@@ -12,6 +12,9 @@ You should have received a copy of the GNU Lesser General Public License along w
 <http://www.gnu.org/licenses/>.
 */
 
+#include <cmath>
+#include <numeric>
+
 #include "gmock/gmock.h"
 
 #include "nurbs.h"
@@ -91,6 +94,25 @@ TEST_F(A2DRandomNURBSGenerator, RegardsPhysicalDimension) {  // NOLINT
   ASSERT_LE(nurbs_generator_.GetWeightedPhysicalSpace()->GetDimension(), dimension_);
 }
 
+TEST_F(A2DRandomNURBSGenerator, CreatesNURBSThatIsEvaluatedOnGridAsAtEachPoint) {  // NOLINT
+  spl::NURBS<2> nurbs(nurbs_generator_);
+  std::vector<ParamCoord> coordinates = {ParamCoord{0.0}, ParamCoord{3.3}, ParamCoord{7.1}, ParamCoord{10.0}};
+  std::vector<double> evaluated_points = nurbs.EvaluateOnGrid({coordinates, coordinates});
+  int dimension = nurbs.GetPointDim();
+  std::vector<int> dimensions(dimension);
+  std::iota(dimensions.begin(), dimensions.end(), 0);
+  ASSERT_THAT(evaluated_points.size(), 16 * dimension);
+  for (int j = 0; j < 4; ++j) {
+    for (int i = 0; i < 4; ++i) {
+      std::vector<double> evaluated_point = nurbs.Evaluate({coordinates[i], coordinates[j]}, dimensions);
+      for (int k = 0; k < dimension; ++k) {
+        ASSERT_THAT(evaluated_points[(4 * j + i) * dimension + k],
+                    DoubleNear(evaluated_point[k], 1e-10 * (1 + std::abs(evaluated_point[k]))));
+      }
+    }
+  }
+}
+
 class A3DRandomNURBSGenerator : public Test {  // NOLINT
  public:
   A3DRandomNURBSGenerator() {
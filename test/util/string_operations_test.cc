@@ -75,3 +75,38 @@ TEST_F(StringOperations, ConvertStringVectorToDoubleVector) {  // NOLINT
   ASSERT_THAT(double_vector.front(), DoubleEq(6.7));
   ASSERT_THAT(double_vector.back(), DoubleEq(0.11));
 }
+
+TEST_F(StringOperations, ConvertStringToClosestDouble) {  // NOLINT
+  ASSERT_THAT(util::StringOperations::StringToDouble("0.1"), 0.1);
+  ASSERT_THAT(util::StringOperations::StringToDouble("-2.5E+3"), -2500.0);
+  ASSERT_THAT(util::StringOperations::StringToDouble("+3"), 3.0);
+  ASSERT_THAT(util::StringOperations::StringToDouble("1.7976931348623157e308"), 1.7976931348623157e308);
+  ASSERT_THAT(util::StringOperations::StringToDouble("2.2250738585072014e-308"), 2.2250738585072014e-308);
+  ASSERT_THAT(util::StringOperations::StringToDouble("0.30000000000000004"), 0.1 + 0.2);
+}
+
+TEST_F(StringOperations, ThrowsForIncompleteNumber) {  // NOLINT
+  ASSERT_THROW(util::StringOperations::StringToDouble(""), std::invalid_argument);
+  ASSERT_THROW(util::StringOperations::StringToDouble("1.5x"), std::invalid_argument);
+  ASSERT_THROW(util::StringOperations::StringToDouble("+-3"), std::invalid_argument);
+  ASSERT_THROW(util::StringOperations::StringToDouble("++3"), std::invalid_argument);
+  ASSERT_THROW(util::StringOperations::StringToDouble("1e999"), std::out_of_range);
+}
+
+TEST_F(StringOperations, ConvertNumberBlockToDoubleVector) {  // NOLINT
+  std::string block = " 1 2.5,\n-3e2;\t 4 \r\n";
+  std::vector<double> converted = util::StringOperations::StringToNumberVector<double>(block);
+  ASSERT_THAT(converted, testing::ElementsAre(1.0, 2.5, -300.0, 4.0));
+  ASSERT_THAT(util::StringOperations::StringToNumberVector<double>("  \n").empty(), true);
+}
+
+TEST_F(StringOperations, ConvertDoubleToShortestStringReadBackWithoutLoss) {  // NOLINT
+  ASSERT_THAT(util::StringOperations::DoubleToString(0.1), "0.1");
+  ASSERT_THAT(util::StringOperations::DoubleToString(1.0), "1");
+  ASSERT_THAT(util::StringOperations::DoubleToString(-0.25), "-0.25");
+  for (double value : {0.1 + 0.2, 1.0 / 3, -2.2250738585072014e-308, 1.7976931348623157e308, 12345.678901234567}) {
+    std::string string = util::StringOperations::DoubleToString(value);
+    ASSERT_THAT(string.size(), testing::Le(util::StringOperations::kMaximumShortestLength));
+    ASSERT_THAT(util::StringOperations::StringToDouble(string), value);
+  }
+}